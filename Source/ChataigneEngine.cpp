@@ -89,6 +89,7 @@ ChataigneEngine::~ChataigneEngine()
 	ModuleRouterManager::deleteInstance();
 
 	ChataigneSequenceManager::deleteInstance();
+	SequenceTriggerDispatcher::deleteInstance();
 	StateManager::deleteInstance();
 	ModuleManager::deleteInstance();
 
@@ -106,6 +107,9 @@ ChataigneEngine::~ChataigneEngine()
 	ChataigneAssetManager::deleteInstance();
 
 	CVGroupManager::deleteInstance();
+	CVInterpolationScheduler::deleteInstance();
+	MappingScheduler::deleteInstance();
+	DelayedConsequenceScheduler::deleteInstance();
 
 	Guider::deleteInstance();
 
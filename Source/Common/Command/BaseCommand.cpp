@@ -209,6 +209,10 @@ void BaseCommand::setValue(var value, int multiplexIndex)
 	trigger(multiplexIndex);
 }
 
+void BaseCommand::setValues(const Array<var>& values, const Array<int>& multiplexIndices)
+{
+	for (int i = 0; i < values.size(); i++) setValue(values.getReference(i), multiplexIndices.getUnchecked(i));
+}
 
 void BaseCommand::updateMappingInputValue(var value, int multiplexIndex)
 {
@@ -56,6 +56,7 @@ public:
     virtual void trigger(int multiplexIndex = 0); //for trigger, will check validity of module
     virtual void triggerInternal(int multiplexIndex) {} // to be overriden
 	virtual void setValue(var value, int multiplexIndex); //for mapping context
+	virtual void setValues(const Array<var>& values, const Array<int>& multiplexIndices); //for mapping context, all the changed indices at once
 	virtual void setValueInternal(var value, int multiplexIndex) {}
 
 	virtual void updateMappingInputValue(var value, int multiplexIndex);
@@ -207,3 +207,9 @@ void MIDIOutputDevice::sendAfterTouch(int channel, int note, int value)
 	if (device == nullptr) return;
 	device->sendMessageNow(MidiMessage::aftertouchChange(channel, note, value));
 }
+
+void MIDIOutputDevice::sendMessages(const MidiBuffer& buffer)
+{
+	if (device == nullptr) return;
+	device->sendBlockOfMessagesNow(buffer);
+}
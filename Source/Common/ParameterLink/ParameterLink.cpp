@@ -258,71 +258,145 @@ void ParameterLink::listItemUpdated(int multiplexIndex)
 
 String ParameterLink::getReplacementString(int multiplexIndex)
 {
-	replacementHasMappingInputToken = false;
-	if (parameter->type != parameter->STRING) return parameter->stringValue();
+	if (parameter->type != parameter->STRING)
+	{
+		replacementHasMappingInputToken = false;
+		return parameter->stringValue();
+	}
+
+	GenericScopedLock lock(replacementLock);
+
+	String s = parameter->stringValue();
+	if (s != replacementString) parseReplacementString(s);
+
+	if (replacementTokens.size() == 1 && replacementTokens.getReference(0).type == ReplacementToken::LITERAL) return s;
+
+	String result;
+	result.preallocateBytes(s.getNumBytesAsUTF8() + 32);
+
+	for (auto& t : replacementTokens)
+	{
+		switch (t.type)
+		{
+		case ReplacementToken::LITERAL:
+			result += t.text;
+			break;
+
+		case ReplacementToken::INDEX:
+			if (isMultiplexed()) result += String(multiplexIndex + 1);
+			else result += "{index}";
+			break;
+
+		case ReplacementToken::INDEX_ZERO:
+			if (isMultiplexed()) result += String(multiplexIndex);
+			else result += "{index0}";
+			break;
+
+		case ReplacementToken::LIST:
+			if (BaseMultiplexList* curList = getReplacementList(t))
+			{
+				if (Controllable* c = curList->list[multiplexIndex])
+				{
+					if (Parameter* lp = dynamic_cast<Parameter*>(c)) result += lp->stringValue();
+					else result += c->shortName; // show shortName for triggers, might be useful
+				}
+			}
+			break;
 
-	std::string s = parameter->stringValue().toStdString();
-	std::regex source_regex("\\{(\\w+:\\w+|index0?)\\}");
+		case ReplacementToken::INPUT:
+			if (mappingValues.size() > 0 && t.valueIndex >= 0 && t.valueIndex < mappingValues[multiplexIndex].size()) result += mappingValues[multiplexIndex][t.valueIndex].toString();
+			else result += "[bad index : " + String(t.valueIndex) + "]";
+			break;
+		}
+	}
 
-	auto source_begin = std::sregex_iterator(s.begin(), s.end(), source_regex);
-	auto source_end = std::sregex_iterator();
+	return result;
+}
 
-	if (std::distance(source_begin, source_end) == 0) return parameter->stringValue();
+//Splits the string into literal parts and {index}, {index0}, {list:name} and {input:n} tokens.
+//Unknown {prefix:name} tokens are kept as literal text.
+void ParameterLink::parseReplacementString(const String& s)
+{
+	replacementString = s;
+	replacementTokens.clearQuick();
+	replacementHasMappingInputToken = false;
 
-	int lastPos = 0;
-	String result = "";
+	auto isWordChar = [](juce_wchar c) { return CharacterFunctions::isLetterOrDigit(c) || c == '_'; };
 
-	for (std::sregex_iterator i = source_begin; i != source_end; ++i)
+	String literal;
+	int pos = 0;
+	const int length = s.length();
+
+	while (pos < length)
 	{
-		std::smatch m = *i;
-		String matchStr(m.str());
+		int open = s.indexOfChar(pos, '{');
+		if (open == -1) break;
 
-		result += parameter->stringValue().substring(lastPos, (int)m.position());
+		int close = s.indexOfChar(open + 1, '}');
+		if (close == -1) break;
 
-		if (matchStr == "{index}" && isMultiplexed())  result += String(multiplexIndex + 1);
-		else if (matchStr == "{index0}" && isMultiplexed())  result += String(multiplexIndex);
+		String content = s.substring(open + 1, close);
+		int nestedOpen = content.lastIndexOfChar('{');
+		if (nestedOpen != -1) //the token can only start at the last brace before the closing one
+		{
+			open += nestedOpen + 1;
+			content = content.substring(nestedOpen + 1);
+		}
+
+		ReplacementToken t{ ReplacementToken::LITERAL, String(), -1, nullptr, nullptr };
+
+		if (content == "index") t.type = ReplacementToken::INDEX;
+		else if (content == "index0") t.type = ReplacementToken::INDEX_ZERO;
 		else
 		{
-			StringArray dotSplit;
-			dotSplit.addTokens(matchStr.substring(1, matchStr.length() - 1), ":", "");
-			if (dotSplit.size() == 2)
+			String prefix = content.upToFirstOccurrenceOf(":", false, false);
+			String name = content.fromFirstOccurrenceOf(":", false, false);
+			bool isValid = content.containsChar(':') && prefix.isNotEmpty() && name.isNotEmpty();
+			for (auto c = content.getCharPointer(); isValid && !c.isEmpty(); ++c) isValid = *c == ':' || isWordChar(*c);
+			isValid = isValid && !name.containsChar(':');
+
+			if (isValid && prefix == "list")
 			{
-				if (dotSplit[0] == "list")
-				{
-					if (isMultiplexed())
-					{
-						if (BaseMultiplexList* curList = multiplex->listManager.getItemWithName(dotSplit[1]))
-						{
-
-							if (Parameter* lp = dynamic_cast<Parameter*>(curList->list[multiplexIndex]))
-							{
-								result += lp->stringValue();
-							}
-							else
-							{
-								result += lp->shortName; // show shortName for triggers, might be useful
-							}
-						}
-					}
-				}
-				else if (dotSplit[0] == "input")
-				{
-					replacementHasMappingInputToken = true;
-					int valueIndex = dotSplit[1].getIntValue() - 1; //1-based to be compliant with UI naming
-					if (mappingValues.size() > 0 && valueIndex >= 0 && valueIndex < mappingValues[multiplexIndex].size()) result += mappingValues[multiplexIndex][valueIndex].toString();
-					else result += "[bad index : " + String(valueIndex) + "]";
-				}
-				else result += matchStr;
+				t.type = ReplacementToken::LIST;
+				t.text = name;
+			}
+			else if (isValid && prefix == "input")
+			{
+				t.type = ReplacementToken::INPUT;
+				t.valueIndex = name.getIntValue() - 1; //1-based to be compliant with UI naming
+				replacementHasMappingInputToken = true;
 			}
-			else result += matchStr;
 		}
 
-		lastPos = (int)m.position() + matchStr.length();
+		if (t.type == ReplacementToken::LITERAL)
+		{
+			literal += s.substring(pos, close + 1);
+		}
+		else
+		{
+			literal += s.substring(pos, open);
+			if (literal.isNotEmpty()) replacementTokens.add({ ReplacementToken::LITERAL, literal, -1, nullptr, nullptr });
+			literal.clear();
+			replacementTokens.add(t);
+		}
+
+		pos = close + 1;
 	}
 
-	result += parameter->stringValue().substring(lastPos);
+	literal += s.substring(pos);
+	if (literal.isNotEmpty() || replacementTokens.isEmpty()) replacementTokens.add({ ReplacementToken::LITERAL, literal, -1, nullptr, nullptr });
+}
 
-	return result;
+BaseMultiplexList* ParameterLink::getReplacementList(ReplacementToken& t)
+{
+	if (!isMultiplexed()) return nullptr;
+
+	//keep the resolved list as long as it exists and still has this name
+	if (t.list != nullptr && !t.listRef.wasObjectDeleted() && t.list->shortName.equalsIgnoreCase(t.text)) return t.list;
+
+	t.list = multiplex->listManager.getItemWithName(t.text);
+	t.listRef = t.list;
+	return t.list;
 }
 
 var ParameterLink::getInputMappingValue(var value)
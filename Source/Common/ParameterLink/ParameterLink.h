@@ -44,8 +44,21 @@ public:
     Array<var> mappingValues;
     StringArray inputValueNames; //this is also reference to how many mapping inputs are available
 
+    //String templates, parsed once each time the parameter's string changes
+    struct ReplacementToken
+    {
+        enum Type { LITERAL, INDEX, INDEX_ZERO, LIST, INPUT };
+        Type type;
+        String text; //literal text, or the list name for LIST tokens
+        int valueIndex; //0-based, for INPUT tokens
+        BaseMultiplexList* list; //resolved list for LIST tokens
+        WeakReference<Inspectable> listRef;
+    };
+
+    CriticalSection replacementLock;
     bool replacementHasMappingInputToken;
-    String replacementString;
+    String replacementString; //the string replacementTokens have been parsed from
+    Array<ReplacementToken> replacementTokens;
 
     void multiplexCountChanged() override;
     void multiplexPreviewIndexChanged() override;
@@ -68,6 +81,8 @@ public:
     void setInputNamesFromParams(Array<Parameter*> params);
     
     String getReplacementString(int multiplexIndex);
+    void parseReplacementString(const String& s);
+    BaseMultiplexList* getReplacementList(ReplacementToken& t);
 
     var getInputMappingValue(var value);
 
@@ -18,6 +18,8 @@ ConditionManager::ConditionManager(Multiplex* multiplex) :
 	forceDisabled(false),
 	useValidationProgress(false),
 	isCheckingOtherConditionsWithSameSource(false),
+	graphIsDirty(true),
+	numGraphEnabledConditions(0),
 	conditionManagerAsyncNotifier(10)
 {
 	canBeCopiedAndPasted = true;
@@ -26,6 +28,7 @@ ConditionManager::ConditionManager(Multiplex* multiplex) :
 	isValids.resize(getMultiplexCount());
 	validationProgresses.resize(getMultiplexCount());
 	validationTargets.resize(getMultiplexCount());
+	prevTimerTimes.resize(getMultiplexCount());
 
 	isValids.fill(false);
 	validationProgresses.fill(0);
@@ -74,12 +77,21 @@ void ConditionManager::multiplexCountChanged()
 	isValids.resize(getMultiplexCount());
 	validationProgresses.resize(getMultiplexCount());
 	validationTargets.resize(getMultiplexCount());
+	prevTimerTimes.resize(getMultiplexCount());
 	sequentialConditionIndices.resize(getMultiplexCount());
 
 	isValids.fill(false);
 	validationProgresses.fill(0);
 	validationTargets.fill(false);
 	sequentialConditionIndices.fill(0);
+
+	{
+		const SpinLock::ScopedLockType sl(validatingLock);
+		validatingIndices.clear();
+		stopTimer();
+	}
+
+	graphIsDirty = true;
 }
 
 void ConditionManager::multiplexPreviewIndexChanged()
@@ -129,6 +141,7 @@ void ConditionManager::addItemInternal(Condition* c, var data)
 {
 	c->setForceDisabled(forceDisabled);
 	c->addConditionListener(this);
+	graphIsDirty = true;
 	conditionOperator->hideInEditor = items.size() <= 1;
 	StandardCondition* sc = dynamic_cast<StandardCondition*>(c);
 	if (sc != nullptr)
@@ -142,6 +155,7 @@ void ConditionManager::removeItemInternal(Condition* c)
 {
 	c->removeConditionListener(this);
 	conditionOperator->hideInEditor = items.size() <= 1;
+	graphIsDirty = true;
 
 	sequentialConditionIndices.fill(0);
 	conditionManagerAsyncNotifier.addMessage(new ConditionManagerEvent(ConditionManagerEvent::SEQUENTIAL_CONDITION_INDEX_CHANGED, this));
@@ -253,11 +267,11 @@ void ConditionManager::checkAllConditions(int multiplexIndex, bool emptyIsValid,
 			validationTargets.set(multiplexIndex, valid);
 			
 			prevTimerTimes.set(multiplexIndex, Time::getMillisecondCounterHiRes() / 1000.0);
-			startTimer(multiplexIndex, 20);
+			startValidationTimer(multiplexIndex);
 		}
 		else
 		{
-			stopTimer(multiplexIndex);
+			stopValidationTimer(multiplexIndex);
 			setValidationProgress(multiplexIndex, valid);
 			validationTargets.set(multiplexIndex, valid);
 		}
@@ -277,27 +291,97 @@ void ConditionManager::checkAllConditions(int multiplexIndex, bool emptyIsValid,
 
 
 
-void ConditionManager::conditionValidationChanged(Condition* c, int multiplexIndex, bool dispatchOnChangeOnly)
+void ConditionManager::compileGraph()
+{
+	GenericScopedLock lock(graphLock);
+	if (!graphIsDirty) return;
+	graphIsDirty = false;
+
+	sourceDependencies.clear();
+	conditionSlots.clear();
+
+	const int numIndices = getMultiplexCount();
+	countedValids.clearQuick();
+	countedValids.insertMultiple(0, false, items.size() * numIndices);
+	validCounts.clearQuick();
+	validCounts.insertMultiple(0, 0, numIndices);
+	numGraphEnabledConditions = 0;
+
+	for (int i = 0; i < items.size(); i++)
+	{
+		Condition* c = items[i];
+		conditionSlots.set(c, i);
+
+		//disabled conditions are still kept in sync with their source, they just don't count
+		if (StandardCondition* sc = dynamic_cast<StandardCondition*>(c))
+		{
+			if (sc->sourceControllable != nullptr) sourceDependencies.getReference(sc->sourceControllable.get()).add(sc);
+		}
+
+		if (!c->enabled->boolValue()) continue;
+		numGraphEnabledConditions++;
+
+		for (int m = 0; m < numIndices; m++)
+		{
+			if (!c->getIsValid(m)) continue;
+			countedValids.set(i * numIndices + m, true);
+			validCounts.getReference(m)++;
+		}
+	}
+}
+
+void ConditionManager::updateConditionCount(Condition* c, int multiplexIndex)
 {
-	if (isCheckingOtherConditionsWithSameSource) return;
+	GenericScopedLock lock(graphLock);
+	if (graphIsDirty) return; //will be counted on next compile
+
+	if (!conditionSlots.contains(c) || multiplexIndex < 0 || multiplexIndex >= validCounts.size())
+	{
+		graphIsDirty = true;
+		return;
+	}
+
+	const int index = conditionSlots[c] * validCounts.size() + multiplexIndex;
+	const bool valid = c->enabled->boolValue() && c->getIsValid(multiplexIndex);
+	if (countedValids[index] == valid) return;
+
+	countedValids.set(index, valid);
+	validCounts.getReference(multiplexIndex) += valid ? 1 : -1;
+}
 
-	if (StandardCondition* sc = dynamic_cast<StandardCondition*>(c))
+void ConditionManager::conditionValidationChanged(Condition* c, int multiplexIndex, bool dispatchOnChangeOnly)
+{
 	{
-		isCheckingOtherConditionsWithSameSource = true;
-		for (auto& i : items)
+		//Reentrant : the other conditions checked below come back here on the same thread
+		GenericScopedLock lock(graphLock);
+
+		updateConditionCount(c, multiplexIndex);
+
+		if (isCheckingOtherConditionsWithSameSource) return;
+
+		compileGraph();
+
+		StandardCondition* sc = dynamic_cast<StandardCondition*>(c);
+		if (sc != nullptr && sc->sourceControllable != nullptr && sourceDependencies.contains(sc->sourceControllable.get()))
 		{
-			if (i == c) continue;
-			if (StandardCondition* otherSC = dynamic_cast<StandardCondition*>(i))
+			//graph is not recompiled while this is true, so the dependency list stays valid
+			isCheckingOtherConditionsWithSameSource = true;
+			for (auto& otherSC : sourceDependencies.getReference(sc->sourceControllable.get()))
 			{
-				if (sc->sourceControllable == otherSC->sourceControllable) otherSC->checkComparator(multiplexIndex);
+				if (otherSC != sc) otherSC->checkComparator(multiplexIndex);
 			}
+			isCheckingOtherConditionsWithSameSource = false;
 		}
-		isCheckingOtherConditionsWithSameSource = false;
 	}
 
 	checkAllConditions(multiplexIndex, false, dispatchOnChangeOnly, items.indexOf(c));
 }
 
+void ConditionManager::conditionSourceChanged(Condition*)
+{
+	graphIsDirty = true;
+}
+
 void ConditionManager::onContainerParameterChanged(Parameter* p)
 {
 	if (p == conditionOperator)
@@ -316,12 +400,53 @@ void ConditionManager::onContainerParameterChanged(Parameter* p)
 	}
 }
 
-void ConditionManager::timerCallback(int id)
+void ConditionManager::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
+{
+	BaseManager::onControllableFeedbackUpdateInternal(cc, c);
+
+	Condition* condition = dynamic_cast<Condition*>(cc);
+	if (condition != nullptr && c == condition->enabled && items.contains(condition))
+	{
+		graphIsDirty = true;
+		if (!Engine::mainEngine->isLoadingFile && !Engine::mainEngine->isClearing)
+		{
+			for (int i = 0; i < getMultiplexCount(); i++) checkAllConditions(i);
+		}
+	}
+}
+
+void ConditionManager::startValidationTimer(int multiplexIndex)
+{
+	//the timer is started and stopped under the lock too, so a stop can't follow a concurrent add
+	const SpinLock::ScopedLockType sl(validatingLock);
+	validatingIndices.add(multiplexIndex);
+	if (!isTimerRunning()) startTimer(20);
+}
+
+void ConditionManager::stopValidationTimer(int multiplexIndex)
+{
+	const SpinLock::ScopedLockType sl(validatingLock);
+	validatingIndices.removeValue(multiplexIndex);
+	if (validatingIndices.isEmpty()) stopTimer();
+}
+
+void ConditionManager::timerCallback()
+{
+	SortedSet<int> indices;
+	{
+		const SpinLock::ScopedLockType sl(validatingLock);
+		indices = validatingIndices; //processing can stop or restart timers
+	}
+
+	for (auto& i : indices) processValidationTimer(i);
+}
+
+void ConditionManager::processValidationTimer(int id)
 {
 	if (!useValidationProgress)
 	{
 		setValid(id, validationTargets[id]);
-		stopTimer(id);
+		stopValidationTimer(id);
 		return;
 	}
 
@@ -340,7 +465,7 @@ void ConditionManager::timerCallback(int id)
 	if (validationProgresses[id] == (int)targetIsValid)
 	{
 		setValid(id, validationTargets[id]);
-		stopTimer(id);
+		stopValidationTimer(id);
 	}
 }
 
@@ -351,55 +476,28 @@ void ConditionManager::afterLoadJSONDataInternal()
 
 bool ConditionManager::areAllConditionsValid(int multiplexIndex, bool emptyIsValid)
 {
-	if (items.size() == 0) return emptyIsValid;
-
-	int conditionsChecked = 0;
-	for (auto& c : items)
-	{
-		if (!c->enabled->boolValue()) continue;
-		if (!c->getIsValid(multiplexIndex)) return false;
-		conditionsChecked++;
-	}
-
-	if (conditionsChecked == 0) return emptyIsValid;
-	return true;
+	if (getNumEnabledConditions() == 0) return emptyIsValid;
+	return getNumValidConditions(multiplexIndex) == numGraphEnabledConditions;
 }
 
 bool ConditionManager::isAtLeastOneConditionValid(int multiplexIndex, bool emptyIsValid)
 {
-	if (items.size() == 0) return emptyIsValid;
-
-	int conditionsChecked = 0;
-	for (auto& c : items)
-	{
-		if (!c->enabled->boolValue()) continue;
-		if (c->getIsValid(multiplexIndex)) return true;
-		conditionsChecked++;
-	}
-
-	if (conditionsChecked == 0) return emptyIsValid;
-	return false;
+	if (getNumEnabledConditions() == 0) return emptyIsValid;
+	return getNumValidConditions(multiplexIndex) > 0;
 }
 
 int ConditionManager::getNumEnabledConditions()
 {
-	int result = 0;
-	for (auto& c : items)
-	{
-		if (c->enabled->boolValue()) result++;
-	}
-	return result;
+	GenericScopedLock lock(graphLock);
+	if (!isCheckingOtherConditionsWithSameSource) compileGraph();
+	return numGraphEnabledConditions;
 }
 
 int ConditionManager::getNumValidConditions(int multiplexIndex)
 {
-	int result = 0;
-	for (auto& c : items)
-	{
-		if (!c->enabled->boolValue()) continue;
-		if (c->getIsValid(multiplexIndex)) result++;
-	}
-	return result;
+	GenericScopedLock lock(graphLock);
+	if (!isCheckingOtherConditionsWithSameSource) compileGraph();
+	return isPositiveAndBelow(multiplexIndex, validCounts.size()) ? validCounts[multiplexIndex] : 0;
 }
 
 bool ConditionManager::getIsValid(int multiplexIndex, bool emptyIsValid)
@@ -10,11 +10,13 @@
 
 #pragma once
 
+class StandardCondition;
+
 class ConditionManager :
 	public MultiplexTarget,
 	public BaseManager<Condition>,
 	public Condition::ConditionListener,
-	public MultiTimer
+	public Timer
 {
 public:
 	ConditionManager(Multiplex* multiplex);
@@ -36,12 +38,28 @@ public:
 	Array<float> validationProgresses;
 	Array<bool> validationTargets;
 	Array<double> prevTimerTimes;
+	SortedSet<int> validatingIndices; //multiplex indices waiting for their validation / invalidation time, all ticked by the same timer
+	SpinLock validatingLock; //validation can start from any thread, the timer reads the indices on the message thread
 
 	bool forceDisabled;
 	bool useValidationProgress;
 
 	//sameSource sync check to avoid parameterListener order bug when 2 conditions have the same source but different operators
-	bool isCheckingOtherConditionsWithSameSource;
+	bool isCheckingOtherConditionsWithSameSource; //only touched with graphLock held
+
+	//Compiled evaluation graph, rebuilt only when conditions are added, removed, enabled or change source.
+	//A source change only re-evaluates the conditions depending on it, and AND / OR results come from the valid counts.
+	//Sources can fire from any thread, the graph and the counts are only read and written with graphLock held
+	CriticalSection graphLock;
+	std::atomic<bool> graphIsDirty;
+	HashMap<Controllable*, Array<StandardCondition*>> sourceDependencies;
+	HashMap<Condition*, int> conditionSlots;
+	Array<bool> countedValids; //[slot * multiplexCount + multiplexIndex]
+	Array<int> validCounts; //enabled and valid conditions, per multiplex index
+	int numGraphEnabledConditions;
+
+	void compileGraph();
+	void updateConditionCount(Condition* c, int multiplexIndex);
 
 	void multiplexCountChanged() override;
 	void multiplexPreviewIndexChanged() override;
@@ -74,10 +92,15 @@ public:
 	void dispatchConditionValidationChanged(int multiplexIndex, bool dispatchOnChangeOnly);
 
 	void conditionValidationChanged(Condition*, int multiplexIndex, bool dispatchOnChangeOnly) override;
+	void conditionSourceChanged(Condition*) override;
 
 	void onContainerParameterChanged(Parameter*) override;
+	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 
-	virtual void timerCallback(int id) override;
+	void startValidationTimer(int multiplexIndex);
+	void stopValidationTimer(int multiplexIndex);
+	void processValidationTimer(int multiplexIndex);
+	virtual void timerCallback() override;
 
 	void afterLoadJSONDataInternal() override;
 
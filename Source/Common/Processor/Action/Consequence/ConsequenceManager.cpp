@@ -40,11 +40,16 @@ ConsequenceManager::ConsequenceManager(const String& name, Multiplex* multiplex)
 	staggerProgression = addFloatParameter("Stagger Progression", "If stagger is used, this animates the progression of the stagger", 0, 0, 1);
 	staggerProgression->hideInEditor = true;
 	staggerProgression->setControllableFeedbackOnly(true);
+
+	pendingDelays = addIntParameter("Pending Delays", "Number of delayed or staggered consequences waiting to be triggered", 0, 0);
+	pendingDelays->hideInEditor = true;
+	pendingDelays->setControllableFeedbackOnly(true);
+	pendingDelays->isSavable = false;
 }
 
 ConsequenceManager::~ConsequenceManager()
 {
-
+	if (DelayedConsequenceScheduler* s = DelayedConsequenceScheduler::getInstanceWithoutCreating()) s->unregisterManager(this);
 }
 
 
@@ -58,23 +63,31 @@ void ConsequenceManager::triggerAll(int multiplexIndex)
 	{
 		if (delay->floatValue() == 0 && stagger->floatValue() == 0)
 		{
-			for (auto& bi : items)
-			{
-				if (Consequence* c = dynamic_cast<Consequence*>(bi)) c->triggerCommand(multiplexIndex);
-				else if (ConsequenceGroup* g = dynamic_cast<ConsequenceGroup*>(bi))  if (g->enabled->boolValue()) g->csm.triggerAll(multiplexIndex);
-			}
+			for (auto& bi : items) triggerItem(bi, multiplexIndex);
 		}
 		else
 		{
-			staggerLaunchers.add(new StaggerLauncher(this, multiplexIndex));
+			Array<BaseItem*> consequencesToLaunch;
+			for (auto& bi : items)
+			{
+				if (!bi->enabled->boolValue()) continue;
+				consequencesToLaunch.add(bi);
+			}
+
+			DelayedConsequenceScheduler::getInstance()->schedule(this, multiplexIndex, consequencesToLaunch, delay->floatValue() * 1000, stagger->floatValue() * 1000);
 		}
 	}
 }
 
+void ConsequenceManager::triggerItem(BaseItem* bi, int multiplexIndex)
+{
+	if (Consequence* c = dynamic_cast<Consequence*>(bi)) c->triggerCommand(multiplexIndex);
+	else if (ConsequenceGroup* g = dynamic_cast<ConsequenceGroup*>(bi))  if (g->enabled->boolValue()) g->csm.triggerAll(multiplexIndex);
+}
+
 void ConsequenceManager::cancelDelayedConsequences()
 {
-	for (auto& launcher : staggerLaunchers) launcher->stopThread(100);
-	staggerLaunchers.clear();
+	if (DelayedConsequenceScheduler* s = DelayedConsequenceScheduler::getInstanceWithoutCreating()) s->cancelAll(this);
 }
 
 void ConsequenceManager::setForceDisabled(bool value, bool force)
@@ -132,6 +145,7 @@ void ConsequenceManager::addItemInternal(BaseItem* bi, var data)
 
 	//triggerAll->hideInEditor = items.size() == 0;
 	delay->hideInEditor = items.size() == 0;
+	pendingDelays->hideInEditor = items.size() == 0;
 	stagger->hideInEditor = items.size() < 2;
 	if (!isClearing) csmNotifier.addMessage(new ConsequenceManagerEvent(ConsequenceManagerEvent::STAGGER_CHANGED, this));
 	updateKillDelayTrigger();
@@ -147,6 +161,7 @@ void ConsequenceManager::addItemsInternal(Array<BaseItem*> items, var data)
 
 	//triggerAll->hideInEditor = items.size() == 0;
 	delay->hideInEditor = items.size() == 0;
+	pendingDelays->hideInEditor = items.size() == 0;
 	stagger->hideInEditor = items.size() < 2;
 	if (!isClearing) csmNotifier.addMessage(new ConsequenceManagerEvent(ConsequenceManagerEvent::STAGGER_CHANGED, this));
 	updateKillDelayTrigger();
@@ -156,6 +171,7 @@ void ConsequenceManager::removeItemInternal(BaseItem*)
 {
 	//triggerAll->hideInEditor = items.size() == 0;
 	delay->hideInEditor = items.size() == 0;
+	pendingDelays->hideInEditor = items.size() == 0;
 	stagger->hideInEditor = items.size() < 2;
 	if (!isClearing) csmNotifier.addMessage(new ConsequenceManagerEvent(ConsequenceManagerEvent::STAGGER_CHANGED, this));
 	updateKillDelayTrigger();
@@ -164,101 +180,32 @@ void ConsequenceManager::removeItemInternal(BaseItem*)
 void ConsequenceManager::removeItemsInternal(Array<BaseItem*>)
 {
 	delay->hideInEditor = items.size() == 0;
+	pendingDelays->hideInEditor = items.size() == 0;
 	stagger->hideInEditor = items.size() < 2;
 	if (!isClearing) csmNotifier.addMessage(new ConsequenceManagerEvent(ConsequenceManagerEvent::STAGGER_CHANGED, this));
 	updateKillDelayTrigger();
 }
 
-void ConsequenceManager::launcherTriggered(StaggerLauncher* launcher)
+void ConsequenceManager::pendingDelaysChanged(int numPending)
 {
-	if (staggerLaunchers.size() == 0 || items.size() == 0) return;
-	if (launcher != staggerLaunchers.getLast()) return;
-	staggerProgression->setValue((launcher->triggerIndex + 1) * 1.0f / items.size());
+	pendingDelays->setValue(numPending);
 }
 
-void ConsequenceManager::launcherFinished(StaggerLauncher* launcher)
+void ConsequenceManager::launchProgressed(int triggerIndex)
 {
-	MessageManager::getInstance()->callAsync([=]()
-		{
-			launcher->stopThread(100);
-			staggerLaunchers.removeObject(launcher);
-		}
-	);
+	if (items.size() == 0) return;
+	staggerProgression->setValue((triggerIndex + 1) * 1.0f / items.size());
 }
 
-InspectableEditor* ConsequenceManager::getEditorInternal(bool isRoot, Array<Inspectable*> inspectables)
+Array<DelayedConsequenceScheduler::PendingConsequence> ConsequenceManager::getPendingConsequences()
 {
-	return new ConsequenceManagerEditor(this, CommandContext::ACTION, isRoot, isMultiplexed());
+	if (DelayedConsequenceScheduler* s = DelayedConsequenceScheduler::getInstanceWithoutCreating()) return s->getPendingConsequences(this);
+	return Array<DelayedConsequenceScheduler::PendingConsequence>();
 }
 
-ConsequenceManager::StaggerLauncher::StaggerLauncher(ConsequenceManager* csm, int multiplexIndex) :
-	Thread("Stagger Launcher"),
-	csm(csm),
-	multiplexIndex(multiplexIndex)
-{
-	startThread();
-}
-
-ConsequenceManager::StaggerLauncher::~StaggerLauncher()
-{
-	if (Engine::mainEngine->isClearing) stopThread(1000);
-	else if (isThreadRunning())
-	{
-		MessageManager::callAsync([this] {
-			stopThread(100);
-			});
-	}
-}
-
-void ConsequenceManager::StaggerLauncher::run()
+InspectableEditor* ConsequenceManager::getEditorInternal(bool isRoot, Array<Inspectable*> inspectables)
 {
-	timeAtRun = Time::getMillisecondCounter();
-	triggerIndex = 0;
-
-	uint32 d = (uint32)(csm->delay->floatValue() * 1000);
-	uint32 s = (uint32)(csm->stagger->floatValue() * 1000);
-
-	uint32 curTime = timeAtRun;
-
-	Array<BaseItem*> consequencesToLaunch;
-	for (auto& bi : csm->items)
-	{
-		if (!bi->enabled->boolValue()) continue;
-		consequencesToLaunch.add(bi);
-	}
-
-	while (!threadShouldExit() && triggerIndex < consequencesToLaunch.size())
-	{
-		uint32 nextTriggerTime = timeAtRun + d + s * triggerIndex;
-		while (nextTriggerTime > curTime)
-		{
-			if (threadShouldExit()) break;
-			wait(jmin<uint32>(nextTriggerTime - curTime, 20));
-			curTime = Time::getMillisecondCounter();
-			nextTriggerTime = timeAtRun + d + s * triggerIndex;
-		}
-
-		if (triggerIndex >= consequencesToLaunch.size()) break;
-		BaseItem* bi = consequencesToLaunch[triggerIndex];
-
-		while (bi != nullptr && !bi->enabled->boolValue())
-		{
-			triggerIndex++;
-			if (triggerIndex >= consequencesToLaunch.size()) break;
-			bi = csm->items[triggerIndex];
-		}
-
-
-		if (threadShouldExit() || bi == nullptr) break;
-
-		if (Consequence* c = dynamic_cast<Consequence*>(bi)) c->triggerCommand(multiplexIndex);
-		else if (ConsequenceGroup* g = dynamic_cast<ConsequenceGroup*>(bi)) if (g->enabled->boolValue()) g->csm.triggerAll(multiplexIndex);
-
-		csm->launcherTriggered(this);
-		triggerIndex++;
-	}
-
-	if (!threadShouldExit()) csm->launcherFinished(this);
+	return new ConsequenceManagerEditor(this, CommandContext::ACTION, isRoot, isMultiplexed());
 }
 
 void ConsequenceManager::multiplexPreviewIndexChanged()
@@ -25,6 +25,7 @@ public:
 	FloatParameter* stagger;
 	BoolParameter* killDelaysOnTrigger;
 	FloatParameter* staggerProgression;
+	IntParameter* pendingDelays;
 
 	Factory<BaseItem> factory;
 
@@ -32,6 +33,7 @@ public:
 
 
 	void triggerAll(int multiplexIndex = 0);
+	void triggerItem(BaseItem* bi, int multiplexIndex);
 	void cancelDelayedConsequences();
 
 	void setForceDisabled(bool value, bool force = false);
@@ -47,25 +49,10 @@ public:
 	void removeItemInternal(BaseItem*) override;
 	void removeItemsInternal(Array<BaseItem*>) override;
 
-	class StaggerLauncher :
-		public Thread
-	{
-	public:
-		StaggerLauncher(ConsequenceManager* csm, int multiplexIndex);
-		~StaggerLauncher();
-
-		ConsequenceManager* csm;
-		int multiplexIndex;
-
-		uint32 timeAtRun;
-		int triggerIndex;
-
-		void run() override;
-	};
-	OwnedArray<StaggerLauncher, CriticalSection> staggerLaunchers;
-
-	void launcherTriggered(StaggerLauncher* launcher);
-	void launcherFinished(StaggerLauncher* launcher);
+	//Called by the DelayedConsequenceScheduler
+	void pendingDelaysChanged(int numPending);
+	void launchProgressed(int triggerIndex);
+	Array<DelayedConsequenceScheduler::PendingConsequence> getPendingConsequences();
 
 	void multiplexPreviewIndexChanged() override;
 
@@ -0,0 +1,371 @@
+/*
+  ==============================================================================
+
+    DelayedConsequenceScheduler.cpp
+    Created: 18 Oct 2026 6:12:35pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/Processor/ProcessorIncludes.h"
+
+juce_ImplementSingleton(DelayedConsequenceScheduler);
+
+DelayedConsequenceScheduler::DelayedConsequenceScheduler() :
+	Thread("Delayed Consequences"),
+	pool(jlimit(1, 4, SystemStats::getNumCpus() / 2)),
+	nextGeneration(1),
+	nextLaunchID(0),
+	baseTime(Time::getMillisecondCounterHiRes()),
+	currentTick(0)
+{
+	startThread();
+}
+
+DelayedConsequenceScheduler::~DelayedConsequenceScheduler()
+{
+	signalThreadShouldExit();
+	notify();
+	stopThread(1000);
+	pool.removeAllJobs(true, 1000);
+}
+
+void DelayedConsequenceScheduler::schedule(ConsequenceManager* csm, int multiplexIndex, const Array<BaseItem*>& items, double delayMs, double staggerMs)
+{
+	if (items.isEmpty()) return;
+
+	Launch::Ptr l = new Launch(csm, multiplexIndex, Time::getMillisecondCounterHiRes(), delayMs, staggerMs);
+	for (auto& bi : items) l->items.add(bi);
+
+	int numPending = 0;
+	{
+		GenericScopedLock lock(schedulerLock);
+		if (!managers.contains(csm)) managers.set(csm, { nextGeneration++, 0, 0 });
+
+		ManagerState& state = managers.getReference(csm);
+		l->generation = state.generation;
+		l->launchID = ++nextLaunchID;
+		state.lastLaunchID = l->launchID;
+		state.numPending += l->items.size();
+		numPending = state.numPending;
+
+		l->listIndex = launches.size();
+		launches.add(l);
+
+		l->dueTick = getTickForTime(l->getTimeForIndex(0));
+		insertInWheel(l);
+	}
+
+	notify();
+	csm->pendingDelaysChanged(numPending);
+}
+
+void DelayedConsequenceScheduler::cancelAll(ConsequenceManager* csm)
+{
+	{
+		GenericScopedLock lock(schedulerLock);
+		if (!managers.contains(csm)) return;
+
+		ManagerState& state = managers.getReference(csm);
+		state.generation = nextGeneration++;
+		state.numPending = 0;
+	}
+
+	csm->pendingDelaysChanged(0);
+}
+
+void DelayedConsequenceScheduler::unregisterManager(ConsequenceManager* csm)
+{
+	{
+		GenericScopedLock lock(schedulerLock);
+		if (!managers.contains(csm)) return;
+		managers.remove(csm);
+	}
+
+	//Wait for a worker still triggering this manager's consequences, unless it's the one deleting it.
+	//No time limit, the manager must not be deleted under a running launch. The timeout only covers several threads waiting on the same event
+	while (isRunningElsewhere(csm)) launchRunEnded.wait(10);
+}
+
+int DelayedConsequenceScheduler::getNumPending(ConsequenceManager* csm)
+{
+	GenericScopedLock lock(schedulerLock);
+	if (!managers.contains(csm)) return 0;
+	return managers.getReference(csm).numPending;
+}
+
+Array<DelayedConsequenceScheduler::PendingConsequence> DelayedConsequenceScheduler::getPendingConsequences(ConsequenceManager* csm)
+{
+	Array<PendingConsequence> result;
+
+	GenericScopedLock lock(schedulerLock);
+	for (auto& l : launches)
+	{
+		if (csm != nullptr && l->csm != csm) continue;
+		if (isStale(l)) continue;
+
+		for (int i = l->nextIndex; i < l->items.size(); i++) result.add({ l->csm, l->items[i], l->multiplexIndex, l->getTimeForIndex(i) });
+	}
+
+	return result;
+}
+
+void DelayedConsequenceScheduler::run()
+{
+	ReferenceCountedArray<Launch> toRun;
+
+	while (!threadShouldExit())
+	{
+		int msToWait = -1;
+
+		{
+			GenericScopedLock lock(schedulerLock);
+			advanceTo((int64)(Time::getMillisecondCounterHiRes() - baseTime));
+
+			for (auto& l : dueLaunches)
+			{
+				if (isStale(l)) removeLaunch(l);
+				else toRun.add(l);
+			}
+			dueLaunches.clearQuick();
+
+			msToWait = getMsToNextEvent();
+		}
+
+		for (auto& l : toRun) pool.addJob(new LaunchJob(this, l), true);
+		toRun.clear();
+
+		wait(msToWait); //schedule() and finished launch steps notify
+	}
+}
+
+int64 DelayedConsequenceScheduler::getTickForTime(double time) const
+{
+	return (int64)std::ceil(time - baseTime); //never fire before the intended time
+}
+
+bool DelayedConsequenceScheduler::isStale(Launch* l)
+{
+	if (!managers.contains(l->csm)) return true;
+	return managers.getReference(l->csm).generation != l->generation;
+}
+
+void DelayedConsequenceScheduler::removeLaunch(Launch* l)
+{
+	int index = l->listIndex;
+	int lastIndex = launches.size() - 1;
+	if (index < 0 || index > lastIndex || launches.getUnchecked(index) != l) return;
+
+	if (index != lastIndex)
+	{
+		launches.swap(index, lastIndex);
+		launches.getUnchecked(index)->listIndex = index;
+	}
+
+	l->listIndex = -1;
+	launches.removeLast();
+}
+
+void DelayedConsequenceScheduler::insertInWheel(Launch* l)
+{
+	int64 delta = l->dueTick - currentTick;
+	if (delta <= 0)
+	{
+		dueLaunches.add(l);
+		return;
+	}
+
+	for (int level = 0; level < numLevels; level++)
+	{
+		if (delta < ((int64)1 << (wheelBits * (level + 1))))
+		{
+			wheel[level][(l->dueTick >> (wheelBits * level)) & wheelMask].add(l);
+			return;
+		}
+	}
+
+	overflow.add(l);
+}
+
+void DelayedConsequenceScheduler::advanceTo(int64 tick)
+{
+	if (tick - currentTick > (int64)wheelSize * wheelSize)
+	{
+		//Fell far behind (system sleep), rebuild the wheel around the new time instead of walking every tick
+		Array<Launch*> toInsert;
+		for (auto& level : wheel)
+		{
+			for (auto& slot : level)
+			{
+				toInsert.addArray(slot);
+				slot.clearQuick();
+			}
+		}
+		toInsert.addArray(overflow);
+		overflow.clearQuick();
+
+		currentTick = tick;
+		for (auto& l : toInsert) insertInWheel(l);
+		return;
+	}
+
+	while (currentTick < tick)
+	{
+		currentTick++;
+
+		//Higher levels first so launches cascading down land in a slot that is handled in the same tick
+		if ((currentTick & (((int64)1 << (wheelBits * numLevels)) - 1)) == 0) cascade(overflow);
+		for (int level = numLevels - 1; level > 0; level--)
+		{
+			if ((currentTick & (((int64)1 << (wheelBits * level)) - 1)) != 0) continue;
+			cascade(wheel[level][(currentTick >> (wheelBits * level)) & wheelMask]);
+		}
+
+		Array<Launch*>& slot = wheel[0][currentTick & wheelMask];
+		dueLaunches.addArray(slot);
+		slot.clearQuick();
+	}
+}
+
+void DelayedConsequenceScheduler::cascade(Array<Launch*>& slot)
+{
+	Array<Launch*> toInsert;
+	toInsert.swapWith(slot);
+	for (auto& l : toInsert) insertInWheel(l);
+}
+
+int DelayedConsequenceScheduler::getMsToNextEvent()
+{
+	if (launches.isEmpty()) return -1;
+
+	//Next tick that has launches or needs a cascade
+	for (int i = 1; i <= wheelSize; i++)
+	{
+		int64 t = currentTick + i;
+		if ((t & wheelMask) == 0 || !wheel[0][t & wheelMask].isEmpty())
+		{
+			return jmax(1, (int)std::ceil(baseTime + t - Time::getMillisecondCounterHiRes()));
+		}
+	}
+
+	return wheelSize;
+}
+
+void DelayedConsequenceScheduler::runLaunch(Launch* l)
+{
+	{
+		GenericScopedLock lock(schedulerLock);
+		if (isStale(l))
+		{
+			removeLaunch(l);
+			return;
+		}
+
+		runningLaunches.add({ l->csm, Thread::getCurrentThreadId() });
+	}
+
+	ConsequenceManager* csm = l->csm;
+
+	WeakReference<Inspectable> item;
+	int itemIndex = 0;
+	int numPending = 0;
+	bool isLatest = false;
+	while (takeDueItem(l, item, itemIndex, numPending, isLatest))
+	{
+		if (BaseItem* bi = dynamic_cast<BaseItem*>(item.get()))
+		{
+			if (bi->enabled->boolValue()) csm->triggerItem(bi, l->multiplexIndex);
+		}
+
+		csm->pendingDelaysChanged(numPending);
+		if (isLatest) csm->launchProgressed(itemIndex);
+	}
+
+	endLaunchRun(l);
+}
+
+bool DelayedConsequenceScheduler::takeDueItem(Launch* l, WeakReference<Inspectable>& item, int& itemIndex, int& numPending, bool& isLatest)
+{
+	GenericScopedLock lock(schedulerLock);
+	if (isStale(l) || l->nextIndex >= l->items.size()) return false;
+	if (l->getTimeForIndex(l->nextIndex) > Time::getMillisecondCounterHiRes()) return false;
+
+	itemIndex = l->nextIndex++;
+	item = l->items[itemIndex];
+
+	ManagerState& state = managers.getReference(l->csm);
+	state.numPending = jmax(0, state.numPending - 1);
+	numPending = state.numPending;
+	isLatest = state.lastLaunchID == l->launchID;
+
+	return true;
+}
+
+void DelayedConsequenceScheduler::endLaunchRun(Launch* l)
+{
+	{
+		GenericScopedLock lock(schedulerLock);
+		for (int i = 0; i < runningLaunches.size(); i++)
+		{
+			if (runningLaunches.getReference(i).csm == l->csm && runningLaunches.getReference(i).thread == Thread::getCurrentThreadId())
+			{
+				runningLaunches.remove(i);
+				break;
+			}
+		}
+
+		launchRunEnded.signal();
+
+		if (isStale(l) || l->nextIndex >= l->items.size())
+		{
+			removeLaunch(l);
+			return;
+		}
+
+		//Back in the wheel until the next stagger step
+		l->dueTick = getTickForTime(l->getTimeForIndex(l->nextIndex));
+		insertInWheel(l);
+	}
+
+	notify();
+}
+
+bool DelayedConsequenceScheduler::isRunningElsewhere(ConsequenceManager* csm)
+{
+	GenericScopedLock lock(schedulerLock);
+	for (auto& rl : runningLaunches)
+	{
+		if (rl.csm == csm && rl.thread != Thread::getCurrentThreadId()) return true;
+	}
+
+	return false;
+}
+
+
+
+// Launch
+
+DelayedConsequenceScheduler::Launch::Launch(ConsequenceManager* csm, int multiplexIndex, double startTime, double delayMs, double staggerMs) :
+	csm(csm),
+	multiplexIndex(multiplexIndex),
+	generation(0),
+	launchID(0),
+	startTime(startTime),
+	delayMs(delayMs),
+	staggerMs(staggerMs),
+	nextIndex(0),
+	dueTick(0),
+	listIndex(-1)
+{
+}
+
+
+
+// LaunchJob
+
+ThreadPoolJob::JobStatus DelayedConsequenceScheduler::LaunchJob::runJob()
+{
+	scheduler->runLaunch(launch.get());
+	return jobHasFinished;
+}
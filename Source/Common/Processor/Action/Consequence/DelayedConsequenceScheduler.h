@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    DelayedConsequenceScheduler.h
+    Created: 18 Oct 2026 6:12:35pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class ConsequenceManager;
+
+/*
+	Shared executor for delayed and staggered consequences.
+	Each delayed triggerAll becomes a launch held in a hierarchical timing wheel (1ms ticks, 3 levels of 256 slots),
+	due launches are run by a small pool of workers and go back in the wheel between stagger steps.
+	Cancelling all the delays of a manager only moves its generation forward, stale launches are dropped when they come due.
+*/
+class DelayedConsequenceScheduler :
+	public Thread
+{
+public:
+	juce_DeclareSingleton(DelayedConsequenceScheduler, true);
+
+	DelayedConsequenceScheduler();
+	~DelayedConsequenceScheduler();
+
+	static const int wheelBits = 8;
+	static const int wheelSize = 1 << wheelBits;
+	static const int wheelMask = wheelSize - 1;
+	static const int numLevels = 3; //covers 2^24 ms (~4.6h), longer delays wait in the overflow list
+
+	class Launch :
+		public ReferenceCountedObject
+	{
+	public:
+		Launch(ConsequenceManager* csm, int multiplexIndex, double startTime, double delayMs, double staggerMs);
+
+		ConsequenceManager* csm; //only dereferenced while the manager is registered and the launch is running
+		int multiplexIndex;
+		uint32 generation;
+		int launchID;
+
+		double startTime; //Time::getMillisecondCounterHiRes() base
+		double delayMs;
+		double staggerMs;
+
+		Array<WeakReference<Inspectable>> items;
+		int nextIndex; //protected by the scheduler lock
+		int64 dueTick;
+		int listIndex;
+
+		double getTimeForIndex(int index) const { return startTime + delayMs + staggerMs * index; }
+
+		typedef ReferenceCountedObjectPtr<Launch> Ptr;
+	};
+
+	class LaunchJob :
+		public ThreadPoolJob
+	{
+	public:
+		LaunchJob(DelayedConsequenceScheduler* scheduler, Launch* launch) : ThreadPoolJob("Delayed Consequences"), scheduler(scheduler), launch(launch) {}
+		DelayedConsequenceScheduler* scheduler;
+		Launch::Ptr launch;
+		JobStatus runJob() override;
+	};
+
+	struct PendingConsequence
+	{
+		ConsequenceManager* csm;
+		WeakReference<Inspectable> item;
+		int multiplexIndex;
+		double triggerTime; //Time::getMillisecondCounterHiRes() base
+	};
+
+	void schedule(ConsequenceManager* csm, int multiplexIndex, const Array<BaseItem*>& items, double delayMs, double staggerMs);
+	void cancelAll(ConsequenceManager* csm); //O(1), launches already queued are dropped when they come due
+	void unregisterManager(ConsequenceManager* csm); //waits for a running launch of this manager to finish
+
+	int getNumPending(ConsequenceManager* csm);
+	Array<PendingConsequence> getPendingConsequences(ConsequenceManager* csm = nullptr); //nullptr for all managers
+
+	void run() override;
+
+private:
+	CriticalSection schedulerLock;
+	ThreadPool pool;
+
+	struct ManagerState
+	{
+		uint32 generation;
+		int lastLaunchID;
+		int numPending;
+	};
+
+	struct RunningLaunch
+	{
+		ConsequenceManager* csm;
+		Thread::ThreadID thread;
+	};
+
+	HashMap<ConsequenceManager*, ManagerState> managers;
+	Array<RunningLaunch> runningLaunches;
+	WaitableEvent launchRunEnded;
+	uint32 nextGeneration;
+	int nextLaunchID;
+
+	ReferenceCountedArray<Launch> launches; //every launch in the wheel or running, for inspection
+	Array<Launch*> wheel[numLevels][wheelSize];
+	Array<Launch*> overflow;
+	Array<Launch*> dueLaunches;
+
+	double baseTime;
+	int64 currentTick;
+
+	int64 getTickForTime(double time) const;
+	bool isStale(Launch* l);
+	void removeLaunch(Launch* l);
+
+	void insertInWheel(Launch* l);
+	void advanceTo(int64 tick);
+	void cascade(Array<Launch*>& slot);
+	int getMsToNextEvent();
+
+	void runLaunch(Launch* l);
+	bool takeDueItem(Launch* l, WeakReference<Inspectable>& item, int& itemIndex, int& numPending, bool& isLatest);
+	void endLaunchRun(Launch* l);
+	bool isRunningElsewhere(ConsequenceManager* csm);
+
+	JUCE_DECLARE_NON_COPYABLE(DelayedConsequenceScheduler)
+};
@@ -16,8 +16,12 @@ MappingFilter::MappingFilter(const String& name, var params, Multiplex* multiple
 	canFilterChannels(hasChannelFilter),
 	filterParams("filterParams", multiplex),
 	isSettingUpSources(false),
+	isBatchRebuilding(false),
+	filterRebuiltPending(false),
 	processOnSameValue(false),
 	autoSetRange(true),
+	numericInputStride(0),
+	previousValuesGeneration(1),
 	filterParamsAreDirty(false),
 	filterAsyncNotifier(10)
 {
@@ -65,19 +69,13 @@ bool MappingFilter::setupSources(Array<Parameter*> sources, int multiplexIndex,
 
 		if (filteredParameters[multiplexIndex] == nullptr) filteredParameters.set(multiplexIndex, new OwnedArray<Parameter>());
 
-		for (auto& filteredParameter : *filteredParameters[multiplexIndex])
-		{
-			if (filteredParameter != nullptr)
-			{
-				filteredParameter->removeParameterListener(this);
-				removeControllable(filteredParameter);
-			}
-		}
+		//filtered parameters are kept, setupParametersInternal reuses them or releases them
 
 		sourceParams[multiplexIndex].clear();
 
 		previousValues.clear();
 		for (int i = 0; i < getMultiplexCount(); i++) previousValues.add(var());
+		previousNumericValues.clearQuick();
 
 		sourceParams.set(multiplexIndex, Array<WeakReference<Parameter>>(sources.getRawDataPointer(), sources.size()));
 		mSourceParams = sourceParams[multiplexIndex];
@@ -95,10 +93,10 @@ bool MappingFilter::setupSources(Array<Parameter*> sources, int multiplexIndex,
 		for (auto& filteredParameter : *filteredParameters[multiplexIndex])
 		{
 			filteredParameter->isControllableFeedbackOnly = true;
-			filteredParameter->addParameterListener(this);
+			filteredParameter->addParameterListener(this); //no-op for reused parameters
 		}
 
-		filterAsyncNotifier.addMessage(new FilterEvent(FilterEvent::FILTER_REBUILT, this));
+		notifyFilterRebuilt();
 	}
 
 	process(sources, multiplexIndex);
@@ -118,7 +116,7 @@ void MappingFilter::setupParametersInternal(int multiplexIndex, bool rangeOnly)
 		return;
 	}
 
-	if (!rangeOnly) filteredParameters[multiplexIndex]->clear();
+	if (!rangeOnly) recycledParameters.swapWith(*filteredParameters[multiplexIndex]);
 
 	int index = 0;
 	for (auto& source : sourceParams[multiplexIndex])
@@ -129,6 +127,7 @@ void MappingFilter::setupParametersInternal(int multiplexIndex, bool rangeOnly)
 		index++;
 	}
 
+	if (!rangeOnly) clearRecycledParameters();
 }
 
 Parameter* MappingFilter::setupSingleParameterInternal(Parameter* source, int multiplexIndex, bool rangeOnly)
@@ -136,6 +135,13 @@ Parameter* MappingFilter::setupSingleParameterInternal(Parameter* source, int mu
 	Parameter* p = nullptr;
 	if (!rangeOnly)
 	{
+		p = getRecycledParameter(source, multiplexIndex, source->type, source->hasRange());
+		if (p != nullptr)
+		{
+			if (p->hasRange()) p->setRange(source->minimumValue, source->maximumValue);
+			return p;
+		}
+
 		p = ControllableFactory::createParameterFrom(source, true, true);
 		p->isSavable = false;
 		p->setControllableFeedbackOnly(true);
@@ -150,6 +156,55 @@ Parameter* MappingFilter::setupSingleParameterInternal(Parameter* source, int mu
 	return p;
 }
 
+Parameter* MappingFilter::getRecycledParameter(Parameter* source, int multiplexIndex, Controllable::Type type, bool withRange)
+{
+	//reuse the parameter that was at the same position, enums are never reused as their options come from the source
+	int index = sourceParams[multiplexIndex].indexOf(source);
+	Parameter* p = recycledParameters[index];
+	if (p == nullptr || p->type != type || p->type == Controllable::ENUM || p->hasRange() != withRange) return nullptr;
+
+	recycledParameters.set(index, nullptr, false);
+
+	if (p->niceName != source->niceName) p->setNiceName(source->niceName);
+	p->description = source->description;
+	p->setValue(source->getValue().clone());
+
+	return p;
+}
+
+void MappingFilter::clearRecycledParameters()
+{
+	for (auto& p : recycledParameters)
+	{
+		if (p == nullptr) continue;
+		p->removeParameterListener(this);
+		removeControllable(p);
+	}
+
+	recycledParameters.clear();
+}
+
+void MappingFilter::setBatchRebuilding(bool value)
+{
+	isBatchRebuilding = value;
+	if (!isBatchRebuilding && filterRebuiltPending)
+	{
+		filterRebuiltPending = false;
+		notifyFilterRebuilt();
+	}
+}
+
+void MappingFilter::notifyFilterRebuilt()
+{
+	if (isBatchRebuilding)
+	{
+		filterRebuiltPending = true;
+		return;
+	}
+
+	filterAsyncNotifier.addMessage(new FilterEvent(FilterEvent::FILTER_REBUILT, this));
+}
+
 void MappingFilter::onContainerParameterChangedInternal(Parameter* p)
 {
 	if (p == enabled) mappingFilterListeners.call(&FilterListener::filterStateChanged, this);
@@ -161,54 +216,229 @@ void MappingFilter::onControllableFeedbackUpdateInternal(ControllableContainer*
 	if (cc == &filterParams)
 	{
 		filterParamsAreDirty = true;
+		invalidatePreviousValues();
 		filterParamChanged((Parameter*)p);
 		mappingFilterListeners.call(&FilterListener::filterNeedsProcess, this);
 	}
 }
 
-MappingFilter::ProcessResult MappingFilter::process(Array<Parameter*> inputs, int multiplexIndex)
+MappingFilter::ProcessResult MappingFilter::process(const Array<Parameter*>& inputs, int multiplexIndex)
 {
 	if (!enabled->boolValue()) return UNCHANGED; //default or disabled does nothing
 	if (isClearing) return STOP_HERE;
 
 	if (!processOnSameValue && !filterParamsAreDirty)
 	{
-		var mPrevValues = previousValues[multiplexIndex];
+		int numericCheck = checkNumericInputsChanged(inputs, multiplexIndex);
+		if (numericCheck == 0) return UNCHANGED;
 
-		if (inputs.size() == previousValues.size() && mPrevValues.isArray())
+		if (numericCheck == -1) //strings, enums, etc. : generic var checking
 		{
-			bool hasChanged = false;
-			for (int i = 0; i < inputs.size(); i++)
+			var mPrevValues = previousValues[multiplexIndex];
+
+			if (inputs.size() == previousValues.size() && mPrevValues.isArray())
 			{
-				//if (inputs[i].wasObjectDeleted()) break; //multiplex refactor : should put that back ?
+				bool hasChanged = false;
+				for (int i = 0; i < inputs.size(); i++)
+				{
+					//if (inputs[i].wasObjectDeleted()) break; //multiplex refactor : should put that back ?
 
-				hasChanged |= !inputs[i]->checkValueIsTheSame(inputs[i]->getValue(), mPrevValues[i]);
-				mPrevValues[i] = inputs[i]->getValue().clone();
+					hasChanged |= !inputs[i]->checkValueIsTheSame(inputs[i]->getValue(), mPrevValues[i]);
+					mPrevValues[i] = inputs[i]->getValue().clone();
+				}
+
+				if (!hasChanged) return UNCHANGED;
+			}
+			else
+			{
+				previousValues.set(multiplexIndex, var());
+				for (int i = 0; i < inputs.size(); i++) previousValues[multiplexIndex].append(inputs[i]->getValue().clone());
 			}
+		}
+	}
+
+	ProcessResult result = processInternal(inputs, multiplexIndex);  //avoid cross-thread crash
+	filterParamsAreDirty = false;
+
+	return result;
+}
+
+int MappingFilter::checkNumericInputsChanged(const Array<Parameter*>& inputs, int multiplexIndex)
+{
+	if (inputs.isEmpty() || multiplexIndex < 0) return -1;
+
+	const int stride = inputs.size() * maxNumericComponents;
+	if (stride != numericInputStride)
+	{
+		previousNumericValues.clearQuick();
+		numericInputStride = stride;
+	}
+
+	const int offset = multiplexIndex * stride;
+	const int numMissing = offset + stride - previousNumericValues.size();
+	if (numMissing > 0) previousNumericValues.insertMultiple(-1, std::numeric_limits<double>::quiet_NaN(), numMissing); //NaN never equals, first check is always "changed"
+
+	const int numMissingGenerations = multiplexIndex + 1 - previousNumericGenerations.size();
+	if (numMissingGenerations > 0) previousNumericGenerations.insertMultiple(-1, 0, numMissingGenerations);
 
-			if (!hasChanged) return UNCHANGED;
+	double* prev = previousNumericValues.getRawDataPointer() + offset;
+
+	const uint32 generation = previousValuesGeneration.load();
+	if (previousNumericGenerations.getUnchecked(multiplexIndex) != generation)
+	{
+		FloatVectorOperations::fill(prev, std::numeric_limits<double>::quiet_NaN(), stride);
+		previousNumericGenerations.set(multiplexIndex, generation);
+	}
+	double values[maxNumericComponents];
+	bool hasChanged = false;
+
+	for (int i = 0; i < inputs.size(); i++)
+	{
+		Parameter* p = inputs.getUnchecked(i);
+		if (p == nullptr) return -1;
+
+		const int numValues = getNumericValues(p, values);
+		if (numValues < 0) return -1;
+
+		double* pPrev = prev + i * maxNumericComponents;
+		for (int j = 0; j < numValues; j++)
+		{
+			if (pPrev[j] != values[j])
+			{
+				pPrev[j] = values[j];
+				hasChanged = true;
+			}
 		}
-		else
+	}
+
+	return hasChanged ? 1 : 0;
+}
+
+void MappingFilter::prepareParallelProcess(int numInputs)
+{
+	const int stride = numInputs * maxNumericComponents;
+	if (stride != numericInputStride)
+	{
+		previousNumericValues.clearQuick();
+		numericInputStride = stride;
+	}
+
+	const int numMissing = getMultiplexCount() * stride - previousNumericValues.size();
+	if (numMissing > 0) previousNumericValues.insertMultiple(-1, std::numeric_limits<double>::quiet_NaN(), numMissing);
+
+	const int numMissingGenerations = getMultiplexCount() - previousNumericGenerations.size();
+	if (numMissingGenerations > 0) previousNumericGenerations.insertMultiple(-1, 0, numMissingGenerations);
+}
+
+bool MappingFilter::getSharedSourceRange(int channel, float& minVal, float& maxVal)
+{
+	for (int i = 0; i < sourceParams.size(); i++)
+	{
+		Parameter* source = sourceParams.getReference(i)[channel].get();
+		if (source == nullptr || !source->hasRange()) return false;
+
+		const float sMin = source->minimumValue;
+		const float sMax = source->maximumValue;
+		if (i == 0)
 		{
-			previousValues.set(multiplexIndex, var());
-			for (int i = 0; i < inputs.size(); i++) previousValues[multiplexIndex].append(inputs[i]->getValue().clone());
+			minVal = sMin;
+			maxVal = sMax;
 		}
+		else if (sMin != minVal || sMax != maxVal) return false;
+	}
+
+	return sourceParams.size() > 0;
+}
 
+bool MappingFilter::isFilterParamLinked(Parameter* p)
+{
+	ParameterLink* pl = filterParams.getLinkedParam(p);
+	return pl != nullptr && pl->linkType != ParameterLink::NONE;
+}
+
+void MappingFilter::invalidatePreviousValues()
+{
+	previousValuesGeneration++;
+}
+
+bool MappingFilter::processFloats(Parameter* source, Parameter* out, int multiplexIndex)
+{
+	double values[maxNumericComponents];
+	const int numValues = getNumericValues(source, values);
+
+	switch (out->type)
+	{
+	case Controllable::FLOAT:
+		if (numValues != 1) return false;
+		out->setValue(processFloat((float)values[0], source, out, -1, multiplexIndex));
+		return true;
+
+	case Controllable::POINT2D:
+		if (source->type != Controllable::POINT2D) return false;
+		((Point2DParameter*)out)->setPoint(processFloat((float)values[0], source, out, 0, multiplexIndex), processFloat((float)values[1], source, out, 1, multiplexIndex));
+		return true;
+
+	case Controllable::POINT3D:
+		if (source->type != Controllable::POINT3D) return false;
+		((Point3DParameter*)out)->setVector(processFloat((float)values[0], source, out, 0, multiplexIndex), processFloat((float)values[1], source, out, 1, multiplexIndex), processFloat((float)values[2], source, out, 2, multiplexIndex));
+		return true;
+
+	default:
+		break;
 	}
 
-	ProcessResult result = processInternal(inputs, multiplexIndex);  //avoid cross-thread crash
-	filterParamsAreDirty = false;
+	return false;
+}
 
-	return result;
+int MappingFilter::getNumericValues(Parameter* p, double* dest)
+{
+	switch (p->type)
+	{
+	case Controllable::FLOAT: dest[0] = p->floatValue(); return 1;
+	case Controllable::INT: dest[0] = p->intValue(); return 1;
+	case Controllable::BOOL: dest[0] = p->boolValue() ? 1 : 0; return 1;
+
+	case Controllable::POINT2D:
+	{
+		Point2DParameter* p2d = (Point2DParameter*)p;
+		dest[0] = p2d->x;
+		dest[1] = p2d->y;
+		return 2;
+	}
+
+	case Controllable::POINT3D:
+	{
+		Point3DParameter* p3d = (Point3DParameter*)p;
+		dest[0] = p3d->x;
+		dest[1] = p3d->y;
+		dest[2] = p3d->z;
+		return 3;
+	}
+
+	case Controllable::COLOR:
+	{
+		Colour c = ((ColorParameter*)p)->getColor();
+		dest[0] = c.getFloatRed();
+		dest[1] = c.getFloatGreen();
+		dest[2] = c.getFloatBlue();
+		dest[3] = c.getFloatAlpha();
+		return 4;
+	}
+
+	default:
+		break;
+	}
+
+	return -1;
 }
 
-MappingFilter::ProcessResult  MappingFilter::processInternal(Array<Parameter*> inputs, int multiplexIndex)
+MappingFilter::ProcessResult  MappingFilter::processInternal(const Array<Parameter*>& inputs, int multiplexIndex)
 {
 	ProcessResult result = UNCHANGED;
-	Array<WeakReference<Parameter>> mSourceParams = sourceParams[multiplexIndex];
 	OwnedArray<Parameter>* mFilteredParams = filteredParameters[multiplexIndex];
 
-	if (mFilteredParams == nullptr) return STOP_HERE;
+	if (mFilteredParams == nullptr || !isPositiveAndBelow(multiplexIndex, sourceParams.size())) return STOP_HERE;
+	const Array<WeakReference<Parameter>>& mSourceParams = sourceParams.getReference(multiplexIndex);
 
 	for (int i = 0; i < inputs.size() && i < mFilteredParams->size(); ++i)
 	{
@@ -242,6 +472,12 @@ MappingFilter::ProcessResult  MappingFilter::processInternal(Array<Parameter*> i
 			continue;
 		}
 
+		if (canProcessFloats() && processFloats(inputs[i], fParam, multiplexIndex))
+		{
+			result = CHANGED;
+			continue;
+		}
+
 		ProcessResult r = processSingleParameterInternal(inputs[i], fParam, multiplexIndex);
 
 		if (r == STOP_HERE) return STOP_HERE;
@@ -255,6 +491,7 @@ MappingFilter::ProcessResult  MappingFilter::processInternal(Array<Parameter*> i
 void MappingFilter::linkUpdated(ParamLinkContainer* c, ParameterLink* pLink)
 {
 	filterParamsAreDirty = true;
+	invalidatePreviousValues();
 	filterParamChanged(pLink->parameter);
 	mappingFilterListeners.call(&FilterListener::filterNeedsProcess, this);
 }
@@ -262,6 +499,7 @@ void MappingFilter::linkUpdated(ParamLinkContainer* c, ParameterLink* pLink)
 void MappingFilter::listItemUpdated(ParamLinkContainer* c, ParameterLink* pLink, int multiplexIndex)
 {
 	filterParamsAreDirty = true;
+	invalidatePreviousValues();
 	filterParamChanged(pLink->parameter);
 	mappingFilterListeners.call(&FilterListener::filterNeedsProcess, this);
 }
@@ -346,6 +584,7 @@ void MappingFilter::parameterRangeChanged(Parameter* p)
 				filteredParameter->setRange(p->minimumValue, p->maximumValue);
 
 				filterParamsAreDirty = true;
+				invalidatePreviousValues();
 				mappingFilterListeners.call(&FilterListener::filteredParamRangeChanged, this);
 			}
 		}
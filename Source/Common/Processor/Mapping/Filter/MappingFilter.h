@@ -35,21 +35,58 @@ public:
 
 	Array<var> previousValues; //for checking, multiplexed
 
+	//Numeric fast path for checking, avoids cloning vars when all inputs are numbers, points or colors
+	static const int maxNumericComponents = 4;
+	Array<double> previousNumericValues; //flat, maxNumericComponents values per input, per multiplex index
+	int numericInputStride;
+
+	//invalidatePreviousValues can be called from any thread, it only bumps the generation.
+	//The processing thread resets the values of an index when its generation is behind, so the arrays are only touched while processing
+	std::atomic<uint32> previousValuesGeneration;
+	Array<uint32> previousNumericGenerations; //per multiplex index
+
 	bool isSettingUpSources;
+	bool isBatchRebuilding; //set by the manager while it rebuilds all indices, FILTER_REBUILT is then sent once at the end
+	bool filterRebuiltPending;
+
+	OwnedArray<Parameter> recycledParameters; //previous filtered parameters of the index being set up, reused when their type still fits
 
 	bool processOnSameValue; //disabling this allows for fast checking and stopping if source and dest values are the same
 	bool autoSetRange; //if true, will check at process if ranges are differents between source and filtered, and if so, will reassign
 
-	bool filterParamsAreDirty; //This is use to force processing even if input has not changed when a filterParam has been changed
+	std::atomic<bool> filterParamsAreDirty; //This is use to force processing even if input has not changed when a filterParam has been changed
 
 	virtual bool setupSources(Array<Parameter*> sources, int multiplexIndex, bool rangeOnly = false);
 	virtual void setupParametersInternal(int mutiplexIndex, bool rangeOnly = false);
 	virtual Parameter* setupSingleParameterInternal(Parameter* source, int multiplexIndex, bool rangeOnly = false);
+	Parameter* getRecycledParameter(Parameter* source, int multiplexIndex, Controllable::Type type, bool withRange); //nullptr if nothing can be reused, name and value are copied from the source
+	void clearRecycledParameters();
 
-	ProcessResult process(Array<Parameter*> inputs, int multiplexIndex);
-	virtual ProcessResult processInternal(Array<Parameter*> inputs, int multiplexIndex);
+	void setBatchRebuilding(bool value);
+	void notifyFilterRebuilt();
+
+	ProcessResult process(const Array<Parameter*>& inputs, int multiplexIndex);
+	virtual ProcessResult processInternal(const Array<Parameter*>& inputs, int multiplexIndex);
+
+	int checkNumericInputsChanged(const Array<Parameter*>& inputs, int multiplexIndex); //-1 if inputs are not all numeric, 0 if unchanged, 1 if changed
+	void invalidatePreviousValues();
+	static int getNumericValues(Parameter* p, double* dest);
 	virtual ProcessResult processSingleParameterInternal(Parameter* source, Parameter* out, int multiplexIndex) { return UNCHANGED; }
 
+	//Float path, used instead of processSingleParameterInternal when source and out types allow it : values are processed
+	//as plain floats, one component at a time (component is -1 for single values), without building vars
+	virtual bool canProcessFloats() { return false; }
+	virtual float processFloat(float value, Parameter* source, Parameter* out, int component, int multiplexIndex) { return value; }
+	bool processFloats(Parameter* source, Parameter* out, int multiplexIndex); //false if the types don't fit the float path
+
+	//Multiplex processing, see MappingMultiplexProcessor
+	virtual bool canProcessBatch() { return false; }
+	virtual void processBatch(float* values, int numChannels, int numIndices) {} //float channels only, values[channel * numIndices + index] processed in place, ranges of the filtered parameters are applied after
+	virtual bool canProcessIndicesInParallel() { return false; } //true if processing an index only touches the state of this index
+	void prepareParallelProcess(int numInputs); //sizes the previous values so parallel processing doesn't reallocate them
+	bool getSharedSourceRange(int channel, float& minVal, float& maxVal); //false if a source of this channel has no range or if ranges differ between indices
+	bool isFilterParamLinked(Parameter* p);
+
 	virtual void onContainerParameterChangedInternal(Parameter* p) override;
 	virtual void onControllableFeedbackUpdateInternal(ControllableContainer*, Controllable* p) override;
 	virtual void filterParamChanged(Parameter*) {};
@@ -72,7 +72,12 @@ bool MappingFilterManager::setupSources(Array<Parameter*> sources, int multiplex
 }
 
 
-MappingFilter::ProcessResult MappingFilterManager::processFilters(Array<Parameter*> inputs, int multiplexIndex)
+MappingFilter::ProcessResult MappingFilterManager::processFilters(const Array<Parameter*>& inputs, int multiplexIndex)
+{
+	return processFilters(inputs, multiplexIndex, stageParams);
+}
+
+MappingFilter::ProcessResult MappingFilterManager::processFilters(const Array<Parameter*>& inputs, int multiplexIndex, Array<Parameter*>& stageBuffer)
 {
 	if (getLastEnabledFilter() == nullptr)
 	{
@@ -84,21 +89,34 @@ MappingFilter::ProcessResult MappingFilterManager::processFilters(Array<Paramete
 	jassert(inputs.size() == inputSources[multiplexIndex].size());
 	if (inputs.size() != inputSources[multiplexIndex].size()) return MappingFilter::STOP_HERE;
 
-	Array<Parameter*> fp = inputs;
+	const Array<Parameter*>* fp = &inputs;
 	MappingFilter::ProcessResult result = MappingFilter::UNCHANGED;
 
 	for (auto& f : items)
 	{
 		if (!f->enabled->boolValue()) continue; //f
-		MappingFilter::ProcessResult r = f->process(fp, multiplexIndex);
+		MappingFilter::ProcessResult r = f->process(*fp, multiplexIndex);
 		if (r == MappingFilter::STOP_HERE) return MappingFilter::STOP_HERE;
 		else if (r == MappingFilter::CHANGED) result = MappingFilter::CHANGED;
 
-		if (f->filteredParameters[multiplexIndex] == nullptr) return MappingFilter::STOP_HERE;
-		fp = Array<Parameter*>(f->filteredParameters[multiplexIndex]->getRawDataPointer(), f->filteredParameters[multiplexIndex]->size());
+		OwnedArray<Parameter>* fParams = f->filteredParameters[multiplexIndex];
+		if (fParams == nullptr) return MappingFilter::STOP_HERE;
+
+		stageBuffer.clearQuick();
+		stageBuffer.addArray(fParams->getRawDataPointer(), fParams->size());
+		fp = &stageBuffer;
 	}
 
-	filteredParameters.set(multiplexIndex, fp);
+	if (isPositiveAndBelow(multiplexIndex, filteredParameters.size()))
+	{
+		Array<Parameter*>& mFilteredParams = filteredParameters.getReference(multiplexIndex);
+		mFilteredParams.clearQuick();
+		mFilteredParams.addArray(*fp);
+	}
+	else
+	{
+		filteredParameters.set(multiplexIndex, *fp);
+	}
 
 	return result;
 }
@@ -156,9 +174,20 @@ void MappingFilterManager::notifyNeedsRebuild(MappingFilter* afterThisFilter, bo
 	filterManagerListeners.call(&FilterManagerListener::filterManagerNeedsRebuild, afterThisFilter, rangeOnly);
 }
 
-Array<Parameter*> MappingFilterManager::getLastFilteredParameters(int multiplexIndex)
+void MappingFilterManager::setBatchRebuilding(bool value)
+{
+	for (auto& f : items) f->setBatchRebuilding(value);
+}
+
+const Array<Parameter*>& MappingFilterManager::getLastFilteredParameters(int multiplexIndex)
 {
-	return filteredParameters[multiplexIndex];
+	if (!isPositiveAndBelow(multiplexIndex, filteredParameters.size()))
+	{
+		static const Array<Parameter*> emptyParams;
+		return emptyParams;
+	}
+
+	return filteredParameters.getReference(multiplexIndex);
 
 	//if (lastEnabledFilter != nullptr) return Array<Parameter *>(lastEnabledFilter->filteredParameters[multiplexIndex]->getRawDataPointer(), lastEnabledFilter->filteredParameters[multiplexIndex]->size());
 	//else return multiplexInputSourceMap[multiplexIndex];
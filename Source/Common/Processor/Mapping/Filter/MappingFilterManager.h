@@ -30,11 +30,13 @@ public:
 	bool setupSources(Array<Parameter *> sources, int multiplexIndex);
 	bool rebuildFilterChain(MappingFilter * afterThisFilter = nullptr, int multiplexIndex = -1, bool rangeOnly = false);
 	void notifyNeedsRebuild(MappingFilter* afterThisFilter = nullptr, bool rangeOnly = false);
+	void setBatchRebuilding(bool value); //while rebuilding all indices, filters send a single FILTER_REBUILT when this is set back to false
 
 	WeakReference<MappingFilter> getLastEnabledFilter() { return lastEnabledFilter; }
-	Array<Parameter *> getLastFilteredParameters(int multiplexIndex);
+	const Array<Parameter *>& getLastFilteredParameters(int multiplexIndex);
 
-	MappingFilter::ProcessResult processFilters(Array<Parameter *> inputs, int multiplexIndex = 0);
+	MappingFilter::ProcessResult processFilters(const Array<Parameter *>& inputs, int multiplexIndex = 0);
+	MappingFilter::ProcessResult processFilters(const Array<Parameter *>& inputs, int multiplexIndex, Array<Parameter*>& stageBuffer); //for parallel processing, each thread has its own stage buffer
 
 	void addItemInternal(MappingFilter * m, var data) override;
 	void removeItemInternal(MappingFilter *) override;
@@ -67,4 +69,7 @@ public:
 
 protected:
 	WeakReference<MappingFilter> lastEnabledFilter;
+
+	//Reused between stages in processFilters, avoids copying parameter arrays on each process
+	Array<Parameter*> stageParams;
 };
\ No newline at end of file
@@ -33,7 +33,7 @@ void ScriptFilter::onContainerParameterChangedInternal(Parameter* p)
 	MappingFilter::onContainerParameterChangedInternal(p);
 }
 
-MappingFilter::ProcessResult  ScriptFilter::processInternal(Array<Parameter*> inputs, int multiplexIndex)
+MappingFilter::ProcessResult  ScriptFilter::processInternal(const Array<Parameter*>& inputs, int multiplexIndex)
 {
 	Array<var> args;
 	var values;
@@ -22,7 +22,7 @@ public:
 
 	void onContainerParameterChangedInternal(Parameter* p) override;
 
-	ProcessResult processInternal(Array<Parameter *> inputs, int multiplexIndex) override;
+	ProcessResult processInternal(const Array<Parameter*>& inputs, int multiplexIndex) override;
 
 	var getJSONData() override;
 	void loadJSONDataInternal(var data) override;
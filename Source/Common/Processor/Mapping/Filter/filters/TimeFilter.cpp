@@ -31,7 +31,7 @@ void TimeFilter::multiplexCountChanged()
     deltaTimes.fill(0);
 }
 
-MappingFilter::ProcessResult TimeFilter::processInternal(Array<Parameter*> sources, int multiplexIndex)
+MappingFilter::ProcessResult TimeFilter::processInternal(const Array<Parameter*>& sources, int multiplexIndex)
 {
     double curTime = Time::getMillisecondCounter() / 1000.0;
     deltaTimes.set(multiplexIndex, jmax<double>(curTime - timesAtLastUpdate.getUnchecked(multiplexIndex), 0));
@@ -22,7 +22,7 @@ public:
 
 	virtual void multiplexCountChanged() override;
 
-	ProcessResult processInternal(Array<Parameter*> sources, int multiplexIndex) override;
+	ProcessResult processInternal(const Array<Parameter*>& sources, int multiplexIndex) override;
 	ProcessResult processSingleParameterInternal(Parameter* source, Parameter* out, int multiplexIndex) override;
 	virtual ProcessResult processSingleParameterTimeInternal(Parameter* source, Parameter* out, int multiplexIndex, double deltaTime) { return ProcessResult::UNCHANGED;  }
 };
@@ -21,6 +21,8 @@ public:
 
 	ProcessResult processSingleParameterInternal(Parameter* source, Parameter* out, int multiplexIndex) override;
 
+	bool canProcessIndicesInParallel() override { return true; }
+
 	virtual String getTypeString() const override { return getTypeStringStatic(); }
 	static const String getTypeStringStatic() { return "HSV Adjust"; }
 
@@ -27,7 +27,7 @@ void ConditionFilter::setupParametersInternal(int multiplexIndex, bool rangeOnly
     updateConditionsLinks(Array<Parameter *>(sourceParams[multiplexIndex].getRawDataPointer(), sourceParams[multiplexIndex].size()), multiplexIndex, true);
 }
 
-MappingFilter::ProcessResult ConditionFilter::processInternal(Array<Parameter*> inputs, int multiplexIndex)
+MappingFilter::ProcessResult ConditionFilter::processInternal(const Array<Parameter*>& inputs, int multiplexIndex)
 {
     updateConditionsLinks(inputs, multiplexIndex, false);
 
@@ -20,7 +20,7 @@ public:
 	ConditionManager cdm;
 
 	void setupParametersInternal(int multiplexIndex, bool rangeOnly = false) override;
-	ProcessResult processInternal(Array<Parameter *> inputs, int multiplexIndex) override;
+	ProcessResult processInternal(const Array<Parameter*>& inputs, int multiplexIndex) override;
 	ProcessResult processSingleParameterInternal(Parameter* source, Parameter* out, int multiplexIndex) override;
 
 	void updateConditionsLinks(Array<Parameter*> inputs, int multiplexIndex, bool updateLinkNames);
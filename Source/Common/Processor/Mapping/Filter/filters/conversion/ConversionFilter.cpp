@@ -216,7 +216,7 @@ void ConversionFilter::setupParametersInternal(int multiplexIndex, bool rangeOnl
 	}
 }
 
-MappingFilter::ProcessResult ConversionFilter::processInternal(Array<Parameter*> inputs, int multiplexIndex)
+MappingFilter::ProcessResult ConversionFilter::processInternal(const Array<Parameter*>& inputs, int multiplexIndex)
 {
 	GenericScopedLock lock(links.getLock());
 
@@ -49,7 +49,7 @@ void MergeFilter::setupParametersInternal(int multiplexIndex, bool rangeOnly)
 	filteredParameters[multiplexIndex]->add(p);
 }
 
-MappingFilter::ProcessResult MergeFilter::processInternal(Array<Parameter*> inputs, int multiplexIndex)
+MappingFilter::ProcessResult MergeFilter::processInternal(const Array<Parameter*>& inputs, int multiplexIndex)
 {
 	if (inputs.size() == 0 || filteredParameters[multiplexIndex]->size() == 0) return ProcessResult::STOP_HERE;
 
@@ -21,7 +21,7 @@ public:
 	EnumParameter* op;
 
 	void setupParametersInternal(int multiplexIndex, bool rangeOnly) override;
-	ProcessResult processInternal(Array<Parameter*> inputs, int multiplexIndex) override; 
+	ProcessResult processInternal(const Array<Parameter*>& inputs, int multiplexIndex) override; 
 	
 	String getTypeString() const override { return "Merge"; }
 
@@ -23,6 +23,10 @@ public:
 	Parameter* setupSingleParameterInternal(Parameter* source, int multiplexIndex, bool rangeOnly) override;
 	ProcessResult processSingleParameterInternal(Parameter* source, Parameter* out, int multiplexIndex) override;
 
+	bool canProcessBatch() override { return true; }
+	void processBatch(float* values, int numChannels, int numIndices) override {} //cropping is done by the range of the filtered parameters
+	bool canProcessIndicesInParallel() override { return true; }
+
 	void filterParamChanged(Parameter *) override;
 
 	String getTypeString() const override { return "Crop"; }
@@ -65,6 +65,18 @@ MappingFilter::ProcessResult CurveMapFilter::processSingleParameterInternal(Para
 	return CHANGED;
 }
 
+float CurveMapFilter::processFloat(float value, Parameter* source, Parameter* out, int component, int multiplexIndex)
+{
+	const float remappedVal = getRemappedFloat(value, source, multiplexIndex, component);
+	const float outMin = component >= 0 ? (float)out->minimumValue[component] : (float)out->minimumValue;
+	const float outMax = component >= 0 ? (float)out->maximumValue[component] : (float)out->maximumValue;
+	const float normVal = jmap<float>(remappedVal, outMin, outMax, 0.f, 1.f);
+
+	if (component <= 0 && multiplexIndex == getPreviewIndex() && source == sourceParams[0].getFirst()) curve.position->setValue(normVal); //for feedback
+
+	return jmap<float>(curve.getValueAtPosition(normVal), outMin, outMax);
+}
+
 void CurveMapFilter::onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c)
 {
 	if (c == curve.value || c == curve.position) return; //avoid value change to be notifying the mapping, it would be recognized as a filter parameter and would trigger a new process
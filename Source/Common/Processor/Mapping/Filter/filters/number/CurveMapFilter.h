@@ -21,6 +21,11 @@ public:
 
 
 	ProcessResult processSingleParameterInternal(Parameter* source, Parameter* out, int multiplexIndex) override;
+	float processFloat(float value, Parameter* source, Parameter* out, int component, int multiplexIndex) override;
+
+	//the curve is evaluated per value, so no batch. Reading the curve doesn't change it and only the preview index updates its position
+	bool canProcessBatch() override { return false; }
+	bool canProcessIndicesInParallel() override { return true; }
 
 	void onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c) override;
 
@@ -31,3 +31,33 @@ MappingFilter::ProcessResult InverseFilter::processSingleParameterInternal(Param
 	
 	return CHANGED;
 }
+
+float InverseFilter::processFloat(float value, Parameter* source, Parameter* out, int component, int multiplexIndex)
+{
+	if (!source->hasRange()) return value;
+	return (float)source->minimumValue + (float)source->maximumValue - value; //same as mapping the normalized value from max to min
+}
+
+void InverseFilter::processBatch(float* values, int numChannels, int numIndices)
+{
+	//inverting in the source range is min + max - value
+	for (int c = 0; c < numChannels; c++)
+	{
+		if (!isChannelEligible(c)) continue;
+		float* v = values + c * numIndices;
+
+		float minVal, maxVal;
+		if (getSharedSourceRange(c, minVal, maxVal))
+		{
+			FloatVectorOperations::negate(v, v, numIndices);
+			FloatVectorOperations::add(v, minVal + maxVal, numIndices);
+			continue;
+		}
+
+		for (int i = 0; i < numIndices; i++)
+		{
+			Parameter* source = sourceParams.getReference(i)[c].get();
+			if (source != nullptr && source->hasRange()) v[i] = (float)source->minimumValue + (float)source->maximumValue - v[i];
+		}
+	}
+}
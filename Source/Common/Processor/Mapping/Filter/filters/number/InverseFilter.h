@@ -18,6 +18,13 @@ public:
 	~InverseFilter(); 
 
 	ProcessResult processSingleParameterInternal(Parameter* source, Parameter* out, int multiplexIndex) override;
+
+	bool canProcessFloats() override { return true; }
+	float processFloat(float value, Parameter* source, Parameter* out, int component, int multiplexIndex) override;
+
+	bool canProcessBatch() override { return true; }
+	void processBatch(float* values, int numChannels, int numIndices) override;
+	bool canProcessIndicesInParallel() override { return true; }
 	
 	virtual String getTypeString() const override { return "Inverse"; }
 
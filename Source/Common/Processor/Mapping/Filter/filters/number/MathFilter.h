@@ -28,12 +28,17 @@ public:
 	void setupParametersInternal(int multiplexIndex, bool rangeOnly) override;
 	ProcessResult processSingleParameterInternal(Parameter* source, Parameter* out, int multiplexIndex) override;
 
+	bool canProcessFloats() override { return true; }
+	float processFloat(float value, Parameter* source, Parameter* out, int component, int multiplexIndex) override { return getProcessedValue(value, component, multiplexIndex); }
+
 	bool updateFilteredParamsRange(int multiplexIndex);
 	void filterParamChanged(Parameter * p) override;
 	void parameterControlModeChanged(Parameter* p) override;
 
 	float getProcessedValue(float val, int index, int multiplexIndex);
 
+	bool canProcessIndicesInParallel() override { return true; } //only reads the operation and the linked value of the index
+
 
 	bool filteredParamShouldHaveRange();
 
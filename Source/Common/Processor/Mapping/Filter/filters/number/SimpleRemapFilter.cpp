@@ -55,9 +55,14 @@ Parameter* SimpleRemapFilter::setupSingleParameterInternal(Parameter* source, in
 	
 	if (!source->isComplex() && forceFloatOutput->boolValue())
 	{
-		p = new FloatParameter(source->niceName, source->description, source->getValue().clone(), source->minimumValue, source->maximumValue);
-		p->isSavable = false;
-		p->setControllableFeedbackOnly(true);
+		p = getRecycledParameter(source, multiplexIndex, Controllable::FLOAT, source->hasRange());
+		if (p == nullptr)
+		{
+			p = new FloatParameter(source->niceName, source->description, source->getValue().clone(), source->minimumValue, source->maximumValue);
+			p->isSavable = false;
+			p->setControllableFeedbackOnly(true);
+		}
+		else if (p->hasRange()) p->setRange(source->minimumValue, source->maximumValue);
 	}
 	else
 	{
@@ -94,8 +99,15 @@ MappingFilter::ProcessResult  SimpleRemapFilter::processSingleParameterInternal(
 	return CHANGED;
 }
 
+float SimpleRemapFilter::processFloat(float value, Parameter* source, Parameter* out, int component, int multiplexIndex)
+{
+	return getRemappedFloat(value, source, multiplexIndex, component);
+}
+
 var SimpleRemapFilter::getRemappedValueFor(Parameter* source, int multiplexIndex)
 {
+	if (!source->isComplex()) return getRemappedFloatFor(source, multiplexIndex);
+
 	var sourceVal = source->getValue().clone(); //copy the value to avoid access problems
 	var targetVal = sourceVal;
 
@@ -206,6 +218,87 @@ var SimpleRemapFilter::getRemappedValueFor(Parameter* source, int multiplexIndex
 	return sourceVal;
 }
 
+void SimpleRemapFilter::processBatch(float* values, int numChannels, int numIndices)
+{
+	const bool customIn = useCustomInputRange->boolValue();
+	const bool uniformOut = !isFilterParamLinked(targetOut);
+	const bool uniformIn = !isFilterParamLinked(targetIn);
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		if (!isChannelEligible(c)) continue;
+		float* v = values + c * numIndices;
+
+		//Same remap for all indices : vectorized
+		float inMin = targetIn->x;
+		float inMax = targetIn->y;
+		if (uniformOut && (customIn ? uniformIn : getSharedSourceRange(c, inMin, inMax)))
+		{
+			const float outMin = targetOut->x;
+			const float outMax = targetOut->y;
+
+			if (outMin == outMax) FloatVectorOperations::fill(v, outMin, numIndices);
+			else if (inMin != inMax)
+			{
+				FloatVectorOperations::add(v, -inMin, numIndices);
+				FloatVectorOperations::multiply(v, (outMax - outMin) / (inMax - inMin), numIndices);
+				FloatVectorOperations::add(v, outMin, numIndices);
+			}
+
+			continue;
+		}
+
+		for (int i = 0; i < numIndices; i++) v[i] = getRemappedFloat(v[i], sourceParams.getReference(i)[c].get(), i);
+	}
+}
+
+float SimpleRemapFilter::getRemappedFloatFor(Parameter* source, int multiplexIndex)
+{
+	//Scalar version of getRemappedValueFor, without building intermediate var arrays
+	return getRemappedFloat(source->floatValue(), source, multiplexIndex);
+}
+
+float SimpleRemapFilter::getRemappedFloat(float sourceVal, Parameter* source, int multiplexIndex, int component)
+{
+	//linked values are only resolved when the param is linked, otherwise the point is read directly
+	float outMin = targetOut->x;
+	float outMax = targetOut->y;
+	if (isFilterParamLinked(targetOut))
+	{
+		var linkOut = filterParams.getLinkedValue(targetOut, multiplexIndex);
+		outMin = linkOut[0];
+		outMax = linkOut[1];
+	}
+
+	if (outMin == outMax) return outMin;
+
+	float inMin, inMax;
+	if (source == nullptr || !source->hasRange() || useCustomInputRange->boolValue())
+	{
+		inMin = targetIn->x;
+		inMax = targetIn->y;
+		if (isFilterParamLinked(targetIn))
+		{
+			var linkIn = filterParams.getLinkedValue(targetIn, multiplexIndex);
+			inMin = linkIn[0];
+			inMax = linkIn[1];
+		}
+	}
+	else if (component >= 0)
+	{
+		inMin = source->minimumValue[component];
+		inMax = source->maximumValue[component];
+	}
+	else
+	{
+		inMin = source->minimumValue;
+		inMax = source->maximumValue;
+	}
+
+	if (inMin == inMax) return sourceVal;
+	return jmap(sourceVal, inMin, inMax, outMin, outMax);
+}
+
 void SimpleRemapFilter::computeOutRanges()
 {
 	bool hasChanged = false;
@@ -27,7 +27,16 @@ public:
 	Parameter* setupSingleParameterInternal(Parameter* source, int multiplexIndex, bool rangeOnly) override;
 	ProcessResult processSingleParameterInternal(Parameter* source, Parameter* out, int multiplexIndex) override;
 
+	bool canProcessFloats() override { return true; }
+	float processFloat(float value, Parameter* source, Parameter* out, int component, int multiplexIndex) override;
+
+	bool canProcessBatch() override { return true; }
+	void processBatch(float* values, int numChannels, int numIndices) override;
+	bool canProcessIndicesInParallel() override { return true; }
+
 	var getRemappedValueFor(Parameter* source, int multiplexIndex); //allow for child classes to invoke this 
+	float getRemappedFloatFor(Parameter* source, int multiplexIndex);
+	float getRemappedFloat(float sourceVal, Parameter* source, int multiplexIndex, int component = -1); //component of the source range for points
 
 	void computeOutRanges();
 
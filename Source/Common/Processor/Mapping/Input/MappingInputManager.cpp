@@ -47,11 +47,17 @@ void MappingInputManager::lockInput(Array<Parameter*> input)
 Array<Parameter*> MappingInputManager::getInputReferences(int multiplexIndex)
 {
 	Array<Parameter*> result;
+	getInputReferences(multiplexIndex, result);
+	return result;
+}
+
+void MappingInputManager::getInputReferences(int multiplexIndex, Array<Parameter*>& result)
+{
+	result.clearQuick();
 	for (auto& i : items)
 	{
 		Parameter* ref = i->getInputAt(multiplexIndex);
 		if (i == nullptr || ref == nullptr) continue;
 		result.add(ref);
 	}
-	return result;
 }
@@ -24,4 +24,5 @@ public:
 	void lockInput(Array<Parameter*> input);
 
 	Array<Parameter *> getInputReferences(int multiplexIndex = 0);
+	void getInputReferences(int multiplexIndex, Array<Parameter*>& result);
 };
\ No newline at end of file
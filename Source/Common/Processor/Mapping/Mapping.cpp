@@ -13,13 +13,14 @@
 Mapping::Mapping(var params, Multiplex* multiplex, bool canBeDisabled) :
 	Processor("Mapping", canBeDisabled),
 	MultiplexTarget(multiplex),
-	Thread("Mapping"),
 	im(multiplex),
 	mappingParams("Parameters"),
 	fm(multiplex),
 	om(multiplex),
 	outValuesCC("Out Values"),
+	multiplexProcessor(this),
 	processMode(VALUE_CHANGE),
+	isScheduled(false),
 	isRebuilding(false),
 	isProcessing(false),
 	shouldRebuildAfterProcess(false),
@@ -39,6 +40,14 @@ Mapping::Mapping(var params, Multiplex* multiplex, bool canBeDisabled) :
 	sendAfterLoad = mappingParams.addBoolParameter("Send After Load", "This will force sending values once after loading", false);
 	sendOnActivate = mappingParams.addBoolParameter("Send on Activate", "This will force sending values once each time the mapping is activated", false);
 
+	achievedRate = mappingParams.addFloatParameter("Achieved Rate", "The rate at which this mapping has actually been processed by the scheduler, in Hz. Lower than Update rate means processing is overrunning", 0, 0);
+	processTime = mappingParams.addFloatParameter("Process Time", "The average time spent processing this mapping on each tick, in milliseconds", 0, 0);
+	for (auto& c : { achievedRate, processTime })
+	{
+		c->setControllableFeedbackOnly(true);
+		c->isSavable = false;
+	}
+
 	//updateRate->canBeDisabledByUser = true;
 
 
@@ -65,7 +74,6 @@ Mapping::Mapping(var params, Multiplex* multiplex, bool canBeDisabled) :
 
 Mapping::~Mapping()
 {
-	stopThread(100);
 	clearItem();
 }
 
@@ -139,7 +147,9 @@ void Mapping::updateMappingChain(MappingFilter* afterThisFilter, bool processAft
 		isRebuilding = true;
 		rebuildPending = false;
 
-		if (!rangeOnly) outValuesCC.clear();
+		//output parameters and index containers are kept and reused when their type still fits
+		bool outputShapeChanged = false;
+		fm.setBatchRebuilding(true);
 
 		for (int i = 0; i < getMultiplexCount(); i++)
 		{
@@ -154,46 +164,98 @@ void Mapping::updateMappingChain(MappingFilter* afterThisFilter, bool processAft
 			{
 				if (isMultiplexed())
 				{
-					ControllableContainer* multiplexOutCC = new ControllableContainer("Index " + String(i + 1));
-					outValuesCC.addChildControllableContainer(multiplexOutCC, true);
-					outCC = multiplexOutCC;
+					outCC = outValuesCC.controllableContainers[i].get();
+					if (outCC == nullptr)
+					{
+						outCC = new ControllableContainer("Index " + String(i + 1));
+						outValuesCC.addChildControllableContainer(outCC, true);
+					}
 				}
 
+				bool indexChanged = false;
+				bool rangeChanged = false;
 				Array<Parameter*> mOutParams;
 				for (auto& sp : processedParams)
 				{
 					if (sp == nullptr) continue;
 
-					Parameter* p = ControllableFactory::createParameterFrom(sp, false, false);
+					Parameter* p = (Parameter*)outCC->controllables[mOutParams.size()];
+					if (p == nullptr || p->type != sp->type || p->type == Parameter::ENUM || p->hasRange() != sp->hasRange())
+					{
+						//from here the outputs don't match anymore, recreate them
+						while (outCC->controllables.size() > mOutParams.size()) outCC->removeControllable(outCC->controllables.getLast());
+
+						p = ControllableFactory::createParameterFrom(sp, false, false);
+						outCC->addParameter(p);
+						p->setControllableFeedbackOnly(true);
+						p->setNiceName("Out " + String(mOutParams.size() + 1));
+						indexChanged = true;
+					}
+					else if (p->hasRange() && (p->minimumValue != sp->minimumValue || p->maximumValue != sp->maximumValue))
+					{
+						p->setRange(sp->minimumValue, sp->maximumValue);
+						rangeChanged = true;
+					}
+
 					mOutParams.add(p);
-					outCC->addParameter(p);
-					p->setControllableFeedbackOnly(true);
-					p->setNiceName("Out " + String(mOutParams.size()));
 					p->setValue(sp->value);
 				}
 
-				om.setOutParams(mOutParams, i);
+				while (outCC->controllables.size() > mOutParams.size())
+				{
+					outCC->removeControllable(outCC->controllables.getLast());
+					indexChanged = true;
+				}
+
+				//reused outputs still need to be pushed again when their range changed, outputs may depend on it
+				if (indexChanged || rangeChanged || om.outParams.size() <= i) om.setOutParams(mOutParams, i, false);
+				outputShapeChanged |= indexChanged;
 			}
 			else
 			{
 				if (isMultiplexed()) outCC = outValuesCC.controllableContainers[i];
 
+				bool rangeChanged = false;
+				Array<Parameter*> mOutParams;
 				for (int j = 0; j < processedParams.size(); j++)
 				{
 					if (Parameter* p = (Parameter*)outCC->controllables[j])
 					{
-						if (p->hasRange()) p->setRange(processedParams[j]->minimumValue, processedParams[j]->maximumValue);
+						if (p->hasRange() && (p->minimumValue != processedParams[j]->minimumValue || p->maximumValue != processedParams[j]->maximumValue))
+						{
+							p->setRange(processedParams[j]->minimumValue, processedParams[j]->maximumValue);
+							rangeChanged = true;
+						}
+						mOutParams.add(p);
 					}
 				}
+
+				if (rangeChanged) om.setOutParams(mOutParams, i, false);
 			}
 		}
 
+		fm.setBatchRebuilding(false);
+
 		if (!rangeOnly)
 		{
-			mappingNotifier.addMessage(new MappingEvent(MappingEvent::OUTPUT_TYPE_CHANGED, this));
+			while (outValuesCC.controllableContainers.size() > (isMultiplexed() ? getMultiplexCount() : 0))
+			{
+				outValuesCC.removeChildControllableContainer(outValuesCC.controllableContainers.getLast().get());
+				outputShapeChanged = true;
+			}
+
+			//one notification for the whole rebuild, and only if the outputs are not the same anymore
+			if (outputShapeChanged)
+			{
+				om.notifyOutputChanged();
+				mappingNotifier.addMessage(new MappingEvent(MappingEvent::OUTPUT_TYPE_CHANGED, this));
+			}
+
 			checkFiltersNeedContinuousProcess();
 		}
 
+		multiplexProcessor.compile();
+
 		isRebuilding = false;
 	}
 
@@ -225,6 +287,7 @@ void Mapping::process(bool sendOutput, int multiplexIndex)
 
 	if (multiplexIndex == -1) // -1 makes process all
 	{
+		if (isMultiplexed() && processAllIndices(sendOutput)) return;
 		for (int i = 0; i < getMultiplexCount(); i++) process(sendOutput, i);
 		return;
 	}
@@ -236,12 +299,12 @@ void Mapping::process(bool sendOutput, int multiplexIndex)
 
 		isProcessing = true;
 
-		Array<Parameter*> inputs = im.getInputReferences(multiplexIndex);
-		MappingFilter::ProcessResult filterResult = fm.processFilters(inputs, multiplexIndex);
+		im.getInputReferences(multiplexIndex, processInputs);
+		MappingFilter::ProcessResult filterResult = fm.processFilters(processInputs, multiplexIndex);
 
 		if (filterResult == MappingFilter::CHANGED || (filterResult == MappingFilter::UNCHANGED && !sendOnOutputChangeOnly->boolValue()))
 		{
-			Array<Parameter*> filteredParameters = fm.getLastFilteredParameters(multiplexIndex);
+			const Array<Parameter*>& filteredParameters = fm.getLastFilteredParameters(multiplexIndex);
 
 			ControllableContainer* outCC = isMultiplexed() ? outValuesCC.controllableContainers[multiplexIndex].get() : &outValuesCC;
 			for (int i = 0; i < filteredParameters.size(); i++)
@@ -272,17 +335,55 @@ void Mapping::process(bool sendOutput, int multiplexIndex)
 
 }
 
+bool Mapping::processAllIndices(bool sendOutput)
+{
+	bool processed = false;
+
+	{
+		GenericScopedLock lock(mappingLock);
+		ScopedLock filterLock(fm.filterLock);
+
+		if (multiplexProcessor.mode == MappingMultiplexProcessor::SERIAL) return false;
+
+		isProcessing = true;
+		processed = multiplexProcessor.process(sendOutput);
+		isProcessing = false;
+	}
+
+	if (shouldRebuildAfterProcess)
+	{
+		shouldRebuildAfterProcess = false;
+		updateMappingChain();
+	}
+
+	return processed;
+}
+
 void Mapping::updateContinuousProcess()
 {
 	if ((!canBeDisabled || enabled->boolValue()) && !forceDisabled)
 	{
-		if (updateRate->enabled) startThread();
+		if (updateRate->enabled)
+		{
+			MappingScheduler::getInstance()->registerMapping(this);
+			isScheduled = true;
+			return;
+		}
 		//for (int i = 0; i < getMultiplexCount(); i++) process(false, i);
 	}
-	else
-	{
-		stopThread(1000);
-	}
+
+	if (!isScheduled) return;
+
+	if (MappingScheduler* s = MappingScheduler::getInstanceWithoutCreating()) s->unregisterMapping(this);
+	isScheduled = false;
+	achievedRate->setValue(0);
+	processTime->setValue(0);
+}
+
+void Mapping::updateProcessStats(float rate, float time)
+{
+	achievedRate->setValue(rate);
+	processTime->setValue(time);
 }
 
 void Mapping::setForceDisabled(bool value, bool force)
@@ -390,7 +491,7 @@ void Mapping::inputParameterValueChanged(MappingInput* mi, int multiplexIndex)
 {
 	if (!mi->triggersProcess->boolValue()) return;
 
-	if (processMode == VALUE_CHANGE && !isThreadRunning())
+	if (processMode == VALUE_CHANGE && !isScheduled)
 	{
 		process(true, multiplexIndex);
 	}
@@ -424,16 +525,16 @@ void Mapping::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Co
 		checkFiltersNeedContinuousProcess();
 		updateContinuousProcess();
 	}
+	else if (c == updateRate)
+	{
+		if (isScheduled) MappingScheduler::getInstance()->updateMappingRate(this);
+	}
 }
 
 void Mapping::onControllableStateChanged(Controllable* c)
 {
 	Processor::onControllableStateChanged(c);
-	if (c == updateRate)
-	{
-		if (updateRate->enabled && !forceDisabled && (!canBeDisabled || enabled->boolValue())) startThread();
-		else stopThread(1000);
-	}
+	if (c == updateRate) updateContinuousProcess();
 }
 
 void Mapping::filterManagerNeedsRebuild(MappingFilter* afterThisFilter, bool rangeOnly)
@@ -452,6 +553,10 @@ void Mapping::filterManagerNeedsProcess()
 
 void Mapping::clearItem()
 {
+	//Unregister first, so no tick processes the mapping while it's being cleared
+	if (MappingScheduler* s = MappingScheduler::getInstanceWithoutCreating()) s->unregisterMapping(this, true);
+	isScheduled = false;
+
 	Processor::clearItem();
 
 	fm.removeFilterManagerListener(this);
@@ -459,35 +564,6 @@ void Mapping::clearItem()
 	im.clear();
 }
 
-void Mapping::run()
-{
-	wait(50); //make sure direct calls have been done before running this (especially if it was loading)
-
-	double millis;
-
-	while (!threadShouldExit())
-	{
-		double rateMillis = 1000.0 / updateRate->intValue();
-
-		if ((canBeDisabled && !enabled->boolValue()) || forceDisabled)
-		{
-			wait(rateMillis);
-			continue;
-		}
-
-		millis = Time::getMillisecondCounterHiRes();
-
-		process();
-
-		double newMillis = Time::getMillisecondCounterHiRes();
-
-		double millisToWait = rateMillis - jlimit<double>(0, rateMillis, newMillis - millis);
-		millis = newMillis;
-
-		if (millisToWait > 0) wait(millisToWait);
-	}
-}
-
 ProcessorUI* Mapping::getUI()
 {
 	return new MappingUI(this);
@@ -15,8 +15,7 @@ class Mapping :
 	public MultiplexTarget,
 	public MappingInput::Listener,
 	public MappingInputManager::ManagerListener,
-	public MappingFilterManager::FilterManagerListener,
-	public Thread
+	public MappingFilterManager::FilterManagerListener
 {
 public:
 	Mapping(var params = var(), Multiplex * multiplex = nullptr, bool canBeDisabled = true);
@@ -27,6 +26,7 @@ public:
 	MappingFilterManager fm;
 	MappingOutputManager om;
 	ControllableContainer outValuesCC;
+	MappingMultiplexProcessor multiplexProcessor;
 
 	IntParameter* updateRate;
 	BoolParameter* forceContinuousProcess;
@@ -34,11 +34,15 @@ public:
 	BoolParameter* sendOnOutputChangeOnly;
 	BoolParameter* sendAfterLoad;
 	BoolParameter* sendOnActivate;
+	FloatParameter* achievedRate;
+	FloatParameter* processTime;
 
 	enum ProcessMode { VALUE_CHANGE, MANUAL, TIMER };
 	ProcessMode processMode;
+	std::atomic<bool> isScheduled; //registered in the MappingScheduler
 
 	CriticalSection mappingLock;
+	Array<Parameter*> processInputs; //reused in process, protected by mappingLock
 	bool isRebuilding;
 	bool isProcessing;
 	bool shouldRebuildAfterProcess;
@@ -55,8 +59,10 @@ public:
 	virtual void multiplexPreviewIndexChanged() override;
 
 	void process(bool sendOutput = true, int multiplexIndex = -1);
+	bool processAllIndices(bool sendOutput); //false if the multiplex processor can't handle this chain
 
 	void updateContinuousProcess();
+	void updateProcessStats(float rate, float time);
 
 	void setForceDisabled(bool value, bool force = false) override;
 
@@ -82,7 +88,6 @@ public:
 	void filterManagerNeedsProcess() override;
 
 	virtual void clearItem() override;
-	virtual void run() override;
 	virtual void highlightLinkedInspectables(bool value) override;
 
 	ProcessorUI* getUI() override;
@@ -0,0 +1,374 @@
+/*
+  ==============================================================================
+
+    MappingMultiplexProcessor.cpp
+    Created: 18 Oct 2026 9:12:37pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/Processor/ProcessorIncludes.h"
+
+MappingMultiplexProcessor::MappingMultiplexProcessor(Mapping* mapping) :
+	mapping(mapping),
+	mode(SERIAL),
+	numIndices(0),
+	numChannels(0),
+	hasPrevInputs(false),
+	rangesAreDirty(true),
+	writtenPreviewIndex(-1),
+	numChunks(0),
+	nextChunk(0),
+	numChunksDone(0)
+{
+}
+
+MappingMultiplexProcessor::~MappingMultiplexProcessor()
+{
+}
+
+void MappingMultiplexProcessor::compile()
+{
+	mode = SERIAL;
+	stages.clearQuick();
+	jobs.clear();
+	hasPrevInputs = false;
+	rangesAreDirty = true;
+	writtenPreviewIndex = -1;
+
+	numIndices = mapping->getMultiplexCount();
+	if (!mapping->isMultiplexed() || numIndices < 2) return;
+
+	for (auto& f : mapping->fm.items)
+	{
+		if (f->enabled->boolValue()) stages.add(f);
+	}
+
+	//a filter that failed its setup is not part of the chain
+	if (mapping->fm.getLastEnabledFilter().get() != stages.getLast()) return;
+
+	mapping->im.getInputReferences(0, inputScratch);
+	numChannels = inputScratch.size();
+	if (numChannels == 0) return;
+
+	if (isBatchCompatible())
+	{
+		const int numValues = numChannels * numIndices;
+		values.allocate(numValues, true);
+		prevInputs.allocate(numValues, true);
+		mode = BATCH;
+	}
+	else if (numIndices >= minIndicesForParallel && isParallelCompatible())
+	{
+		const int numJobs = jmax(1, jmin(MappingScheduler::getInstance()->getNumMultiplexWorkers() + 1, numIndices / minIndicesPerJob));
+		for (int i = 0; i < numJobs; i++) jobs.add(new ChunkJob(this));
+		numChunks = (numIndices + chunkSize - 1) / chunkSize;
+
+		results.clearQuick();
+		results.insertMultiple(0, MappingFilter::STOP_HERE, numIndices);
+		mode = PARALLEL;
+	}
+
+	//previous values kept by the filters are not updated by the batch path
+	for (auto& f : stages) f->invalidatePreviousValues();
+}
+
+bool MappingMultiplexProcessor::isBatchCompatible()
+{
+	for (int i = 0; i < numIndices; i++)
+	{
+		mapping->im.getInputReferences(i, inputScratch);
+		if (inputScratch.size() != numChannels) return false;
+		for (auto& p : inputScratch)
+		{
+			if (p->type != Controllable::FLOAT) return false;
+		}
+	}
+
+	for (auto& f : stages)
+	{
+		if (!f->canProcessBatch() || f->filteredParameters.size() < numIndices) return false;
+
+		for (int i = 0; i < numIndices; i++)
+		{
+			OwnedArray<Parameter>* fParams = f->filteredParameters[i];
+			if (fParams == nullptr || fParams->size() != numChannels) return false;
+			for (auto& p : *fParams)
+			{
+				if (p == nullptr || p->type != Controllable::FLOAT) return false;
+			}
+		}
+	}
+
+	if (mapping->outValuesCC.controllableContainers.size() < numIndices) return false;
+	for (int i = 0; i < numIndices; i++)
+	{
+		ControllableContainer* outCC = mapping->outValuesCC.controllableContainers[i].get();
+		if (outCC == nullptr || outCC->controllables.size() != numChannels) return false;
+		for (auto& c : outCC->controllables)
+		{
+			if (c->type != Controllable::FLOAT) return false;
+		}
+	}
+
+	return true;
+}
+
+bool MappingMultiplexProcessor::isParallelCompatible()
+{
+	if (stages.isEmpty() || mapping->fm.filteredParameters.size() < numIndices) return false;
+
+	double numericValues[MappingFilter::maxNumericComponents];
+	for (int i = 0; i < numIndices; i++)
+	{
+		mapping->im.getInputReferences(i, inputScratch);
+		if (inputScratch.size() != numChannels) return false;
+		for (auto& p : inputScratch)
+		{
+			if (MappingFilter::getNumericValues(p, numericValues) < 0) return false;
+		}
+	}
+
+	//same number of parameters on all indices, so the filters can size their previous values before the jobs start
+	for (auto& f : stages)
+	{
+		if (!f->canProcessIndicesInParallel() || f->filteredParameters.size() < numIndices) return false;
+
+		for (int i = 0; i < numIndices; i++)
+		{
+			OwnedArray<Parameter>* fParams = f->filteredParameters[i];
+			if (fParams == nullptr || fParams->size() != f->filteredParameters[0]->size()) return false;
+		}
+	}
+
+	if (mapping->outValuesCC.controllableContainers.size() < numIndices) return false;
+
+	return true;
+}
+
+bool MappingMultiplexProcessor::process(bool sendOutput)
+{
+	switch (mode)
+	{
+	case BATCH: return processBatch(sendOutput);
+	case PARALLEL: return processParallel(sendOutput);
+	default: break;
+	}
+
+	return false;
+}
+
+void MappingMultiplexProcessor::updateRanges()
+{
+	const int numValues = numChannels * numIndices;
+	rangeMins.allocate(jmax(1, stages.size() * numValues), false);
+	rangeMaxs.allocate(jmax(1, stages.size() * numValues), false);
+	uniformRanges.clearQuick();
+
+	for (int s = 0; s < stages.size(); s++)
+	{
+		MappingFilter* f = stages.getUnchecked(s);
+		for (int c = 0; c < numChannels; c++)
+		{
+			float* mins = rangeMins + s * numValues + c * numIndices;
+			float* maxs = rangeMaxs + s * numValues + c * numIndices;
+			bool uniform = true;
+
+			for (int i = 0; i < numIndices; i++)
+			{
+				Parameter* p = f->filteredParameters[i]->getUnchecked(c);
+				float minVal = p->hasRange() ? (float)p->minimumValue : std::numeric_limits<float>::lowest();
+				float maxVal = p->hasRange() ? (float)p->maximumValue : std::numeric_limits<float>::max();
+				mins[i] = jmin(minVal, maxVal);
+				maxs[i] = jmax(minVal, maxVal);
+				uniform &= mins[i] == mins[0] && maxs[i] == maxs[0];
+			}
+
+			uniformRanges.add(uniform);
+		}
+	}
+
+	rangesAreDirty = false;
+}
+
+bool MappingMultiplexProcessor::processBatch(bool sendOutput)
+{
+	const int numValues = numChannels * numIndices;
+	float* v = values.get();
+
+	for (int i = 0; i < numIndices; i++)
+	{
+		mapping->im.getInputReferences(i, inputScratch);
+		if (inputScratch.size() != numChannels) return false;
+
+		for (int c = 0; c < numChannels; c++)
+		{
+			Parameter* p = inputScratch.getUnchecked(c);
+			if (p->type != Controllable::FLOAT) return false;
+			v[c * numIndices + i] = p->floatValue();
+		}
+	}
+
+	bool filtersAreDirty = false;
+	for (auto& f : stages) filtersAreDirty |= f->filterParamsAreDirty.load();
+	if (filtersAreDirty) rangesAreDirty = true;
+
+	//Same results as the serial path : no filter always means changed, otherwise changed if an input or a filter param has changed
+	const bool forceChanged = !hasPrevInputs || filtersAreDirty || stages.isEmpty();
+	results.clearQuick();
+	for (int i = 0; i < numIndices; i++)
+	{
+		bool changed = forceChanged;
+		for (int c = 0; c < numChannels && !changed; c++) changed = v[c * numIndices + i] != prevInputs[c * numIndices + i];
+		results.add(changed ? MappingFilter::CHANGED : MappingFilter::UNCHANGED);
+	}
+
+	FloatVectorOperations::copy(prevInputs, v, numValues);
+	hasPrevInputs = true;
+
+	if (rangesAreDirty) updateRanges();
+
+	const int previewIndex = mapping->getPreviewIndex();
+	const bool previewChanged = previewIndex != writtenPreviewIndex;
+	writtenPreviewIndex = previewIndex;
+
+	for (int s = 0; s < stages.size(); s++)
+	{
+		MappingFilter* f = stages.getUnchecked(s);
+		f->processBatch(v, numChannels, numIndices);
+		f->filterParamsAreDirty = false;
+
+		//apply the ranges of the filtered parameters, as setting their values would
+		for (int c = 0; c < numChannels; c++)
+		{
+			float* cv = v + c * numIndices;
+			const float* mins = rangeMins + s * numValues + c * numIndices;
+			const float* maxs = rangeMaxs + s * numValues + c * numIndices;
+
+			if (uniformRanges[s * numChannels + c]) FloatVectorOperations::clip(cv, cv, mins[0], maxs[0], numIndices);
+			else for (int i = 0; i < numIndices; i++) cv[i] = jlimit(mins[i], maxs[i], cv[i]);
+		}
+
+		//The last stage is kept in sync on all changed indices, as the serial path would leave it.
+		//Intermediate filtered parameters are only displayed for the preview index, only this one is written back
+		if (s == stages.size() - 1)
+		{
+			for (int i = 0; i < numIndices; i++)
+			{
+				if (results.getUnchecked(i) != MappingFilter::UNCHANGED) writeFilteredParameters(f, i);
+			}
+		}
+		else if (isPositiveAndBelow(previewIndex, numIndices) && (previewChanged || results.getUnchecked(previewIndex) != MappingFilter::UNCHANGED))
+		{
+			writeFilteredParameters(f, previewIndex);
+		}
+	}
+
+	const bool sendOnOutputChangeOnly = mapping->sendOnOutputChangeOnly->boolValue();
+	indicesToSend.clearQuick();
+	for (int i = 0; i < numIndices; i++)
+	{
+		if (results.getUnchecked(i) == MappingFilter::UNCHANGED && sendOnOutputChangeOnly) continue;
+
+		ControllableContainer* outCC = mapping->outValuesCC.controllableContainers[i].get();
+		for (int c = 0; c < numChannels; c++) ((Parameter*)outCC->controllables.getUnchecked(c))->setValue(v[c * numIndices + i]);
+		indicesToSend.add(i);
+	}
+
+	dispatchOutputs(sendOutput);
+	return true;
+}
+
+void MappingMultiplexProcessor::writeFilteredParameters(MappingFilter* f, int multiplexIndex)
+{
+	const float* v = values.get();
+	OwnedArray<Parameter>* fParams = f->filteredParameters[multiplexIndex];
+	for (int c = 0; c < numChannels; c++) fParams->getUnchecked(c)->setValue(v[c * numIndices + multiplexIndex]);
+}
+
+bool MappingMultiplexProcessor::processParallel(bool sendOutput)
+{
+	int numInputs = numChannels;
+	for (auto& f : stages)
+	{
+		f->prepareParallelProcess(numInputs);
+		numInputs = f->filteredParameters[0]->size();
+	}
+
+	nextChunk = 0;
+	numChunksDone = 0;
+	chunksFinished.reset();
+
+	MappingScheduler* scheduler = MappingScheduler::getInstance();
+	for (int i = 0; i < jobs.size() - 1; i++) scheduler->addMultiplexJob(jobs.getUnchecked(i));
+
+	//the calling thread takes chunks until none is left, even if no worker is free
+	ChunkJob* callerJob = jobs.getLast();
+	processChunks(callerJob->inputs, callerJob->stageParams);
+
+	//what remains has been taken by a running worker, so this wait always ends
+	if (numChunksDone < numChunks) chunksFinished.wait();
+
+	//workers that didn't start are taken out of the queue, the others have nothing left to do
+	for (int i = 0; i < jobs.size() - 1; i++) scheduler->removeMultiplexJob(jobs.getUnchecked(i));
+
+	const bool sendOnOutputChangeOnly = mapping->sendOnOutputChangeOnly->boolValue();
+	indicesToSend.clearQuick();
+	for (int i = 0; i < numIndices; i++)
+	{
+		MappingFilter::ProcessResult r = results.getUnchecked(i);
+		if (r == MappingFilter::STOP_HERE || (r == MappingFilter::UNCHANGED && sendOnOutputChangeOnly)) continue;
+
+		const Array<Parameter*>& filteredParameters = mapping->fm.getLastFilteredParameters(i);
+		ControllableContainer* outCC = mapping->outValuesCC.controllableContainers[i].get();
+		if (outCC == nullptr) continue;
+
+		for (int c = 0; c < filteredParameters.size(); c++)
+		{
+			if (Parameter* fp = filteredParameters[c])
+			{
+				if (Parameter* p = (Parameter*)outCC->controllables[c])
+				{
+					if (p->type == Parameter::ENUM) ((EnumParameter*)p)->setValueWithKey(((EnumParameter*)fp)->getValueKey());
+					else p->setValue(fp->value);
+				}
+			}
+		}
+
+		indicesToSend.add(i);
+	}
+
+	dispatchOutputs(sendOutput);
+	return true;
+}
+
+void MappingMultiplexProcessor::dispatchOutputs(bool sendOutput)
+{
+	if (!sendOutput || indicesToSend.isEmpty()) return;
+	mapping->om.updateOutputValuesBatch(indicesToSend, mapping->sendOnOutputChangeOnly->boolValue());
+}
+
+void MappingMultiplexProcessor::processChunks(Array<Parameter*>& inputs, Array<Parameter*>& stageParams)
+{
+	for (;;)
+	{
+		const int chunk = nextChunk++;
+		if (chunk >= numChunks) return;
+
+		const int end = jmin((chunk + 1) * chunkSize, numIndices);
+		for (int i = chunk * chunkSize; i < end; i++)
+		{
+			mapping->im.getInputReferences(i, inputs);
+			results.getReference(i) = mapping->fm.processFilters(inputs, i, stageParams);
+		}
+
+		if (++numChunksDone == numChunks) chunksFinished.signal();
+	}
+}
+
+ThreadPoolJob::JobStatus MappingMultiplexProcessor::ChunkJob::runJob()
+{
+	processor->processChunks(inputs, stageParams);
+	return jobHasFinished;
+}
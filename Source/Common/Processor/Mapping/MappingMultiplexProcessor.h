@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    MappingMultiplexProcessor.h
+    Created: 18 Oct 2026 9:12:37pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class Mapping;
+
+/*
+	Processes all the multiplex indices of a mapping at once, instead of running the filter chain index by index.
+	BATCH : all inputs are floats and all filters can process batches, the values of all indices are gathered
+	in structure-of-arrays buffers (values[channel * numIndices + index]) and each filter runs once over them, vectorized when possible.
+	PARALLEL : all filters only touch the state of the index they process, indices are split in chunks taken by the calling thread
+	and the workers of the MappingScheduler multiplex pool. The calling thread takes every chunk no worker has started,
+	so it only ever waits for chunks that are being processed, never for a job still queued in the pool.
+	In both cases outputs are then dispatched as a batch from the calling thread.
+	SERIAL : fallback to the per-index processing in Mapping.
+*/
+class MappingMultiplexProcessor
+{
+public:
+	MappingMultiplexProcessor(Mapping* mapping);
+	~MappingMultiplexProcessor();
+
+	enum Mode { SERIAL, BATCH, PARALLEL };
+
+	static const int minIndicesForParallel = 64;
+	static const int minIndicesPerJob = 16;
+	static const int chunkSize = 16;
+
+	Mapping* mapping;
+	Mode mode;
+
+	void compile(); //after each chain rebuild, with the mapping lock held
+	bool process(bool sendOutput); //false if the mapping has to be processed serially
+
+private:
+	int numIndices;
+	int numChannels;
+	Array<MappingFilter*> stages; //enabled filters, in chain order
+
+	//Batch buffers
+	HeapBlock<float> values;
+	HeapBlock<float> prevInputs;
+	HeapBlock<float> rangeMins; //[stage][channel * numIndices + index]
+	HeapBlock<float> rangeMaxs;
+	Array<bool> uniformRanges; //[stage * numChannels + channel], same range on all indices
+	bool hasPrevInputs;
+	bool rangesAreDirty;
+	int writtenPreviewIndex; //intermediate stages are only written back for this index
+	Array<Parameter*> inputScratch;
+
+	Array<int> indicesToSend;
+	Array<MappingFilter::ProcessResult> results;
+
+	class ChunkJob :
+		public ThreadPoolJob
+	{
+	public:
+		ChunkJob(MappingMultiplexProcessor* processor) : ThreadPoolJob("Multiplex Chunk"), processor(processor) {}
+
+		MappingMultiplexProcessor* processor;
+		Array<Parameter*> inputs;
+		Array<Parameter*> stageParams;
+
+		JobStatus runJob() override;
+	};
+
+	OwnedArray<ChunkJob> jobs; //the last one is run by the calling thread
+	int numChunks;
+	std::atomic<int> nextChunk;
+	std::atomic<int> numChunksDone;
+	WaitableEvent chunksFinished;
+
+	bool isBatchCompatible();
+	bool isParallelCompatible();
+
+	void updateRanges();
+	bool processBatch(bool sendOutput);
+	void writeFilteredParameters(MappingFilter* f, int multiplexIndex);
+	bool processParallel(bool sendOutput);
+	void processChunks(Array<Parameter*>& inputs, Array<Parameter*>& stageParams);
+	void dispatchOutputs(bool sendOutput);
+
+	JUCE_DECLARE_NON_COPYABLE(MappingMultiplexProcessor)
+};
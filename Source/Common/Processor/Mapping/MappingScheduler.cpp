@@ -0,0 +1,262 @@
+/*
+  ==============================================================================
+
+    MappingScheduler.cpp
+    Created: 18 Oct 2026 2:15:42pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/Processor/ProcessorIncludes.h"
+
+juce_ImplementSingleton(MappingScheduler);
+
+MappingScheduler::MappingScheduler() :
+	Thread("Mapping Scheduler"),
+	pool(jlimit(1, 8, SystemStats::getNumCpus() / 2)),
+	numWorkers(jlimit(1, 8, SystemStats::getNumCpus() / 2)),
+	multiplexPool(jlimit(1, 8, SystemStats::getNumCpus() / 2)),
+	currentTick(0)
+{
+}
+
+MappingScheduler::~MappingScheduler()
+{
+	signalThreadShouldExit();
+	notify();
+	stopThread(1000);
+	pool.removeAllJobs(true, 1000);
+	multiplexPool.removeAllJobs(true, 1000);
+}
+
+void MappingScheduler::registerMapping(Mapping* m)
+{
+	{
+		GenericScopedLock lock(schedulerLock);
+		if (mappingGroupMap.contains(m)) return;
+
+		RateGroup* g = getOrCreateGroup(m->updateRate->intValue());
+		g->mappings.add(new ScheduledMapping(m));
+		mappingGroupMap.set(m, g);
+
+		if (g->slot == -1)
+		{
+			g->nextTime = Time::getMillisecondCounterHiRes() + g->period;
+			scheduleGroup(g);
+		}
+	}
+
+	if (!isThreadRunning()) startThread();
+	else notify();
+}
+
+void MappingScheduler::unregisterMapping(Mapping* m, bool waitForCompletion)
+{
+	ScheduledMapping::Ptr sm;
+
+	{
+		GenericScopedLock lock(schedulerLock);
+		RateGroup* g = mappingGroupMap[m];
+		if (g == nullptr) return;
+
+		sm = removeFromGroup(m, g);
+		mappingGroupMap.remove(m);
+	}
+
+	if (sm == nullptr) return;
+	sm->active = false;
+
+	if (!waitForCompletion) return;
+
+	//A batch may be processing this mapping right now, its lock is released when it's done.
+	//No batch processes it after that since it's not active anymore. Reentrant if we are called from inside the processing.
+	GenericScopedLock processLock(sm->processLock);
+}
+
+void MappingScheduler::updateMappingRate(Mapping* m)
+{
+	GenericScopedLock lock(schedulerLock);
+	RateGroup* g = mappingGroupMap[m];
+	if (g == nullptr || g->rate == m->updateRate->intValue()) return;
+
+	ScheduledMapping::Ptr sm = removeFromGroup(m, g);
+	if (sm == nullptr) return;
+
+	RateGroup* ng = getOrCreateGroup(m->updateRate->intValue());
+	ng->mappings.add(sm);
+	mappingGroupMap.set(m, ng);
+
+	if (ng->slot == -1)
+	{
+		ng->nextTime = Time::getMillisecondCounterHiRes() + ng->period;
+		scheduleGroup(ng);
+	}
+}
+
+bool MappingScheduler::isRegistered(Mapping* m)
+{
+	GenericScopedLock lock(schedulerLock);
+	return mappingGroupMap.contains(m);
+}
+
+void MappingScheduler::addMultiplexJob(ThreadPoolJob* job)
+{
+	multiplexPool.addJob(job, false);
+}
+
+void MappingScheduler::removeMultiplexJob(ThreadPoolJob* job)
+{
+	multiplexPool.removeJob(job, false, -1);
+}
+
+void MappingScheduler::run()
+{
+	currentTick = (int64)Time::getMillisecondCounterHiRes();
+
+	while (!threadShouldExit())
+	{
+		const double now = Time::getMillisecondCounterHiRes();
+		const int64 nowTick = (int64)now;
+
+		bool hasMappings = false;
+
+		{
+			GenericScopedLock lock(schedulerLock);
+
+			if (nowTick - currentTick > wheelSize) currentTick = nowTick - wheelSize; //we fell behind a full turn, each slot is visited once
+
+			//Only past ticks are processed, so a group is never dispatched before its time and at most 1ms late
+			while (currentTick < nowTick)
+			{
+				Array<RateGroup*>& slot = wheel[currentTick % wheelSize];
+				for (int i = slot.size() - 1; i >= 0; i--)
+				{
+					RateGroup* g = slot[i];
+					if (g->nextTime >= currentTick + 1) continue;
+
+					slot.remove(i);
+					g->slot = -1;
+
+					dispatchGroup(g);
+
+					g->nextTime += g->period;
+					if (g->nextTime <= now) g->nextTime = now + g->period; //overrun, skip the missed ticks instead of bursting
+					scheduleGroup(g);
+				}
+
+				currentTick++;
+			}
+
+			hasMappings = mappingGroupMap.size() > 0;
+		}
+
+		wait(hasMappings ? 1 : 100); //registerMapping notifies when the first mapping comes in
+	}
+}
+
+MappingScheduler::RateGroup* MappingScheduler::getOrCreateGroup(int rate)
+{
+	rate = jmax(rate, 1);
+	if (RateGroup* g = groupMap[rate]) return g;
+
+	//Groups are never deleted, their jobs may still be owned by the pool
+	RateGroup* g = groups.add(new RateGroup(rate));
+	groupMap.set(rate, g);
+	return g;
+}
+
+MappingScheduler::ScheduledMapping::Ptr MappingScheduler::removeFromGroup(Mapping* m, RateGroup* g)
+{
+	ScheduledMapping::Ptr result;
+	for (int i = 0; i < g->mappings.size(); i++)
+	{
+		if (g->mappings[i]->mapping == m)
+		{
+			result = g->mappings[i];
+			g->mappings.remove(i);
+			break;
+		}
+	}
+
+	if (g->mappings.isEmpty()) unscheduleGroup(g);
+	return result;
+}
+
+void MappingScheduler::scheduleGroup(RateGroup* g)
+{
+	g->slot = (int)((int64)g->nextTime % wheelSize);
+	wheel[g->slot].add(g);
+}
+
+void MappingScheduler::unscheduleGroup(RateGroup* g)
+{
+	if (g->slot == -1) return;
+	wheel[g->slot].removeFirstMatchingValue(g);
+	g->slot = -1;
+}
+
+void MappingScheduler::dispatchGroup(RateGroup* g)
+{
+	const int numMappings = g->mappings.size();
+	if (numMappings == 0) return;
+
+	const int numJobs = jlimit(1, numWorkers, (numMappings + minMappingsPerJob - 1) / minMappingsPerJob);
+	while (g->jobs.size() < numJobs) g->jobs.add(new BatchJob());
+
+	const int mappingsPerJob = (numMappings + numJobs - 1) / numJobs;
+
+	for (int j = 0; j < numJobs; j++)
+	{
+		BatchJob* job = g->jobs[j];
+		if (pool.contains(job)) continue; //previous batch is still running, this tick is skipped and shows in the achieved rate
+
+		job->batch.clearQuick();
+		const int end = jmin(numMappings, (j + 1) * mappingsPerJob);
+		for (int i = j * mappingsPerJob; i < end; i++) job->batch.add(g->mappings[i]);
+
+		pool.addJob(job, false);
+	}
+}
+
+
+
+// BatchJob
+
+ThreadPoolJob::JobStatus MappingScheduler::BatchJob::runJob()
+{
+	for (auto& sm : batch)
+	{
+		if (shouldExit()) break;
+
+		//A mapping that just moved to another rate group may be in two batches at once, only one processes it
+		int expected = 0;
+		if (!sm->running.compare_exchange_strong(expected, 1)) continue;
+
+		{
+			GenericScopedLock processLock(sm->processLock);
+
+			if (sm->active)
+			{
+				const double startTime = Time::getMillisecondCounterHiRes();
+				sm->mapping->process();
+				const double endTime = Time::getMillisecondCounterHiRes();
+
+				sm->processCount++;
+				sm->processTimeSum += endTime - startTime;
+
+				if (endTime - sm->lastStatsTime > 500)
+				{
+					if (sm->lastStatsTime > 0) sm->mapping->updateProcessStats((float)(sm->processCount * 1000.0 / (endTime - sm->lastStatsTime)), (float)(sm->processTimeSum / sm->processCount));
+					sm->lastStatsTime = endTime;
+					sm->processCount = 0;
+					sm->processTimeSum = 0;
+				}
+			}
+		}
+
+		sm->running = 0;
+	}
+
+	return jobHasFinished;
+}
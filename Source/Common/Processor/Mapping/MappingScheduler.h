@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    MappingScheduler.h
+    Created: 18 Oct 2026 2:15:42pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class Mapping;
+
+/*
+	Shared clock for all continuously processed mappings.
+	Mappings are grouped by update rate, each group sits in a 1ms-resolution timing wheel
+	and is dispatched in batches to a fixed pool of workers when its tick comes.
+*/
+class MappingScheduler :
+	public Thread
+{
+public:
+	juce_DeclareSingleton(MappingScheduler, true);
+
+	MappingScheduler();
+	~MappingScheduler();
+
+	static const int wheelSize = 1024; //must be greater than the longest period (1000ms at 1Hz)
+	static const int minMappingsPerJob = 16;
+
+	class ScheduledMapping :
+		public ReferenceCountedObject
+	{
+	public:
+		ScheduledMapping(Mapping* m) : mapping(m), active(true), running(0), processCount(0), processTimeSum(0), lastStatsTime(0) {}
+
+		Mapping* mapping; //only dereferenced while active, with processLock held
+		std::atomic<bool> active;
+		std::atomic<int> running; //in a batch right now
+		CriticalSection processLock; //held while processing, unregistering takes it to wait for the end of the processing
+
+		//Only touched by the batch that holds running
+		int processCount;
+		double processTimeSum;
+		double lastStatsTime;
+
+		typedef ReferenceCountedObjectPtr<ScheduledMapping> Ptr;
+	};
+
+	class BatchJob :
+		public ThreadPoolJob
+	{
+	public:
+		BatchJob() : ThreadPoolJob("Mapping Batch") {}
+		ReferenceCountedArray<ScheduledMapping> batch;
+		JobStatus runJob() override;
+	};
+
+	class RateGroup
+	{
+	public:
+		RateGroup(int rate) : rate(rate), period(1000.0 / rate), nextTime(0), slot(-1) {}
+
+		int rate;
+		double period;
+		double nextTime;
+		int slot;
+
+		ReferenceCountedArray<ScheduledMapping> mappings;
+		OwnedArray<BatchJob> jobs;
+	};
+
+	void registerMapping(Mapping* m);
+	void unregisterMapping(Mapping* m, bool waitForCompletion = false); //wait before deleting the mapping
+	void updateMappingRate(Mapping* m);
+	bool isRegistered(Mapping* m);
+
+	//Chunks of multiplex indices processed in parallel, see MappingMultiplexProcessor.
+	//Separate from the batch pool so a batch waiting for its chunks never starves them
+	void addMultiplexJob(ThreadPoolJob* job);
+	void removeMultiplexJob(ThreadPoolJob* job); //removes it if it has not started, waits for it otherwise
+	int getNumMultiplexWorkers() const { return numWorkers; }
+
+	void run() override;
+
+private:
+	CriticalSection schedulerLock;
+	ThreadPool pool;
+	int numWorkers;
+	ThreadPool multiplexPool;
+
+	OwnedArray<RateGroup> groups;
+	HashMap<int, RateGroup*> groupMap; //rate -> group
+	HashMap<Mapping*, RateGroup*> mappingGroupMap;
+	Array<RateGroup*> wheel[wheelSize];
+	int64 currentTick;
+
+	RateGroup* getOrCreateGroup(int rate);
+	ScheduledMapping::Ptr removeFromGroup(Mapping* m, RateGroup* g);
+
+	void scheduleGroup(RateGroup* g);
+	void unscheduleGroup(RateGroup* g);
+	void dispatchGroup(RateGroup* g);
+
+	JUCE_DECLARE_NON_COPYABLE(MappingScheduler)
+};
@@ -31,7 +31,7 @@ void MappingOutput::setOutParams(Array<WeakReference<Parameter>> mOutParams, int
 	outParams.ensureStorageAllocated(multiplexIndex + 1);
 	outParams.set(multiplexIndex, mOutParams);
 	
-	updateCommandOutParams();
+	if (multiplexIndex == 0) updateCommandOutParams(); //the command only looks at the first index
 }
 
 void MappingOutput::updateCommandOutParams()
@@ -60,4 +60,10 @@ void MappingOutput::setValue(var value, int multiplexIndex)
 {
 	if (!enabled->boolValue() || forceDisabled) return;
 	if(command != nullptr) command->setValue(value, multiplexIndex);
+}
+
+void MappingOutput::setValues(const Array<var>& values, const Array<int>& multiplexIndices)
+{
+	if (!enabled->boolValue() || forceDisabled || command == nullptr) return;
+	command->setValues(values, multiplexIndices);
 }
\ No newline at end of file
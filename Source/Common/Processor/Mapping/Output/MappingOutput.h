@@ -31,6 +31,7 @@ public:
 	virtual void setCommand(CommandDefinition * cd) override;
 
 	void setValue(var value, int multiplexIndex);
+	void setValues(const Array<var>& values, const Array<int>& multiplexIndices);
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MappingOutput)
 };
\ No newline at end of file
@@ -44,7 +44,7 @@ void MappingOutputManager::setForceDisabled(bool value)
 	for (auto& i : items) i->forceDisabled = value;
 }
 
-void MappingOutputManager::setOutParams(Array<Parameter *> params, int multiplexIndex)
+void MappingOutputManager::setOutParams(Array<Parameter *> params, int multiplexIndex, bool notify)
 {
 	outParams.ensureStorageAllocated(multiplexIndex + 1);
 	outParams.set(multiplexIndex, Array<WeakReference<Parameter>>(params.getRawDataPointer(), params.size()));
@@ -53,6 +53,11 @@ void MappingOutputManager::setOutParams(Array<Parameter *> params, int multiplex
 	prevMergedValue.ensureStorageAllocated(multiplexIndex+1);
 	prevMergedValue.set(multiplexIndex, getMergedOutValue(multiplexIndex));
 
+	if (notify) notifyOutputChanged();
+}
+
+void MappingOutputManager::notifyOutputChanged()
+{
 	omAsyncNotifier.addMessage(new OutputManagerEvent(OutputManagerEvent::OUTPUT_CHANGED));
 }
 
@@ -67,6 +72,27 @@ void MappingOutputManager::updateOutputValues(int multiplexIndex, bool sendOnOut
 	prevMergedValue.set(multiplexIndex, value);
 }
 
+void MappingOutputManager::updateOutputValuesBatch(const Array<int>& multiplexIndices, bool sendOnOutputChangedOnly)
+{
+	batchValues.clearQuick();
+	batchIndices.clearQuick();
+
+	for (auto& multiplexIndex : multiplexIndices)
+	{
+		var value = getMergedOutValue(multiplexIndex);
+		if (value.isVoid()) continue;
+		if (sendOnOutputChangedOnly && value == prevMergedValue[multiplexIndex]) continue;
+
+		prevMergedValue.set(multiplexIndex, value);
+		batchValues.add(value);
+		batchIndices.add(multiplexIndex);
+	}
+
+	if (batchIndices.isEmpty()) return;
+
+	for (auto& i : items) i->setValues(batchValues, batchIndices);
+}
+
 void MappingOutputManager::updateOutputValue(MappingOutput * o, int multiplexIndex)
 {
 	if (forceDisabled) return;
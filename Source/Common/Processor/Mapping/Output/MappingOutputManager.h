@@ -24,15 +24,21 @@ public:
 	Array<Array<WeakReference<Parameter>>> outParams;
 	Array<var> prevMergedValue;
 
+	//Reused in updateOutputValuesBatch
+	Array<var> batchValues;
+	Array<int> batchIndices;
+
 	void clear() override;
 
 	MappingOutput* createItem() override;
 
 	void setForceDisabled(bool value);
 
-	void setOutParams(Array<Parameter*> params, int multiplexIndex);
+	void setOutParams(Array<Parameter*> params, int multiplexIndex, bool notify = true);
+	void notifyOutputChanged();
 
 	void updateOutputValues(int multiplexIndex, bool sendOnOutputChangedOnly = false);
+	void updateOutputValuesBatch(const Array<int>& multiplexIndices, bool sendOnOutputChangedOnly = false); //each output receives all the indices at once
 	void updateOutputValue(MappingOutput* o, int multiplexIndex);
 
 	var getMergedOutValue(int multiplexIndex);
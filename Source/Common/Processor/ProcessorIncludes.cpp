@@ -50,6 +50,7 @@
 #include "Action/Consequence/Consequence.cpp"
 #include "Action/Consequence/ConsequenceManager.cpp"
 #include "Action/Consequence/ConsequenceGroup.cpp"
+#include "Action/Consequence/DelayedConsequenceScheduler.cpp"
 #include "Action/Consequence/ui/ConsequenceManagerEditor.cpp"
 #include "Action/ui/ActionUI.cpp"
 
@@ -47,6 +47,7 @@
 #include "Action/Condition/conditions/MultiplexIndex/MultiplexIndexCondition.h"
 
 #include "Action/Consequence/Consequence.h"
+#include "Action/Consequence/DelayedConsequenceScheduler.h"
 #include "Action/Consequence/ConsequenceManager.h"
 #include "Action/Consequence/ConsequenceGroup.h"
 #include "Action/Consequence/ui/ConsequenceManagerEditor.h"
@@ -63,7 +64,9 @@
 #include "Mapping/Output/MappingOutput.h"
 #include "Mapping/Output/MappingOutputManager.h"
 
+#include "Mapping/MappingMultiplexProcessor.h"
 #include "Mapping/Mapping.h"
+#include "Mapping/MappingScheduler.h"
 
 #include "Mapping/Filter/filters/ScriptFilter.h"
 #include "Mapping/Filter/filters/color/ColorShiftFilter.h"
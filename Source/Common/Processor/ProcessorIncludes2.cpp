@@ -52,6 +52,8 @@
 #include "Mapping/Input/MappingInputManager.cpp"
 #include "Mapping/Input/ui/MappingInputEditor.cpp"
 #include "Mapping/Mapping.cpp"
+#include "Mapping/MappingMultiplexProcessor.cpp"
+#include "Mapping/MappingScheduler.cpp"
 #include "Mapping/Output/MappingOutput.cpp"
 #include "Mapping/Output/MappingOutputManager.cpp"
 #include "Mapping/Output/ui/MappingOutputManagerEditor.cpp"
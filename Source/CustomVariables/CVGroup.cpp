@@ -12,12 +12,8 @@
 
 CVGroup::CVGroup(const String& name) :
 	BaseItem(name),
-	Thread("CV Interpolation"),
 	params("Parameters"),
-	defaultInterpolation("Default Preset Interpolation"),
-	targetPreset(nullptr),
-	interpolationAutomation(nullptr),
-	interpolationTime(0)
+	defaultInterpolation("Default Preset Interpolation")
 {
 
 	setHasCustomColor(true);
@@ -33,8 +29,8 @@ CVGroup::CVGroup(const String& name) :
 	controlMode = params.addEnumParameter("Control Mode", "Defines how the variables are controlled.\n \
 Free mode lets you can change manually the values or tween them to preset values punctually.\n \
 Weights mode locks the values and interpolate them continuously depending on preset weights.\n \
-Voronoi and Gradient Band (not implemented yet) also locks values but interpolates them using 2D interpolators");
-	controlMode->addOption("Free", FREE)->addOption("Weights", WEIGHTS)->addOption("2D Voronoi", VORONOI);// ->addOption("Gradient Band", GRADIENT_BAND);
+Voronoi and Gradient Band also locks values but interpolates them using 2D interpolators");
+	controlMode->addOption("Free", FREE)->addOption("Weights", WEIGHTS)->addOption("2D Voronoi", VORONOI)->addOption("Gradient Band", GRADIENT_BAND);
 
 	randomize = params.addTrigger("Randomize", "Randomize all values");
 
@@ -58,7 +54,7 @@ Voronoi and Gradient Band (not implemented yet) also locks values but interpolat
 CVGroup::~CVGroup()
 {
 	if (morpher != nullptr) morpher->removeMorpherListener(this);
-	stopThread(100);
+	if (CVInterpolationScheduler* s = CVInterpolationScheduler::getInstanceWithoutCreating()) s->stopTransition(this, true);
 }
 
 void CVGroup::addItemFromParameter(Parameter* source, bool linkAsMaster)
@@ -88,15 +84,26 @@ void CVGroup::itemsAdded(Array<GenericControllableItem*> items)
 	for (auto& i : items) i->controllable->userCanSetReadOnly = true;
 }
 
+void CVGroup::itemRemoved(GenericControllableItem* item)
+{
+	//the running transition holds this variable, wait for the tick to be done with it before it's deleted
+	if (CVInterpolationScheduler* s = CVInterpolationScheduler::getInstanceWithoutCreating()) s->stopTransition(this, true);
+}
+
+void CVGroup::itemsRemoved(Array<GenericControllableItem*> items)
+{
+	if (CVInterpolationScheduler* s = CVInterpolationScheduler::getInstanceWithoutCreating()) s->stopTransition(this, true);
+}
+
 void CVGroup::setValuesToPreset(CVPreset* preset)
 {
 	if (!enabled->boolValue()) return;
 
-	for (auto& v : values.items)
+	for (int i = 0; i < values.items.size(); i++)
 	{
-		Parameter* p = dynamic_cast<Parameter*>(v->controllable);
+		Parameter* p = dynamic_cast<Parameter*>(values.items[i]->controllable);
 		if (p == nullptr) continue;
-		ParameterPreset* pp = preset->values.getParameterPresetForSource(p);
+		ParameterPreset* pp = preset->values.getParameterPresetAt(i);
 		if (pp != nullptr) p->setValue(pp->parameter->value);
 	}
 }
@@ -105,12 +112,12 @@ void CVGroup::lerpPresets(CVPreset* p1, CVPreset* p2, float weight)
 {
 	if (!enabled->boolValue()) return;
 
-	for (auto& v : values.items)
+	for (int i = 0; i < values.items.size(); i++)
 	{
-		Parameter* p = dynamic_cast<Parameter*>(v->controllable);
+		Parameter* p = dynamic_cast<Parameter*>(values.items[i]->controllable);
 		if (p == nullptr) continue;
-		ParameterPreset* pp1 = p1->values.getParameterPresetForSource(p);
-		ParameterPreset* pp2 = p2->values.getParameterPresetForSource(p);
+		ParameterPreset* pp1 = p1->values.getParameterPresetAt(i);
+		ParameterPreset* pp2 = p2->values.getParameterPresetAt(i);
 
 		if (pp1 != nullptr && pp2 != nullptr)
 		{
@@ -132,62 +139,22 @@ void CVGroup::lerpPresets(CVPreset* p1, CVPreset* p2, float weight)
 	}
 }
 
-void CVGroup::lerpPresets(Array<var> sourceValues, CVPreset* endPreset, float weight)
-{
-	int numValues = values.items.size();
-
-	jassert(sourceValues.size() == numValues);
-	if (endPreset == nullptr) return;
-
-	for (int i = 0; i < numValues; i++)
-	{
-		Parameter* p = dynamic_cast<Parameter*>(values.items[i]->controllable);
-		if (p == nullptr) continue;
-		var startValue = sourceValues[i];
-		ParameterPreset* endParam = endPreset->values.getParameterPresetForSource(p);
-
-		if (endParam != nullptr)
-		{
-			ParameterPreset::InterpolationMode mode = endParam->interpolationMode->getValueDataAsEnum<ParameterPreset::InterpolationMode>();
-
-			if (mode == ParameterPreset::NONE) continue;
-
-			var tValue;
-			if (weight == 0) tValue = startValue;
-			else if (weight == 1) tValue = endParam->parameter->value;
-			else
-			{
-				if (mode == ParameterPreset::INTERPOLATE) tValue = endParam->parameter->getLerpValueTo(startValue, 1 - weight);
-				else tValue = mode == ParameterPreset::CHANGE_AT_END ? startValue : endParam->parameter->value;
-			}
-
-			p->setValue(tValue);
-		}
-	}
-}
-
 void CVGroup::goToPreset(CVPreset* p, float time, Automation* curve)
 {
 	if (time == 0)
 	{
+		stopInterpolation();
 		setValuesToPreset(p);
 		return;
 	}
 
-	stopThread(1000);
-
-	targetPreset = p;
-	interpolationAutomation = curve;
-	automationRef = curve;
-
-	interpolationTime = time;
-
-	startThread();
+	CVInterpolationScheduler::getInstance()->startTransition(this, p, time, curve);
 }
 
 void CVGroup::stopInterpolation()
 {
-	stopThread(1000);
+	if (CVInterpolationScheduler* s = CVInterpolationScheduler::getInstanceWithoutCreating()) s->stopTransition(this, true);
+	interpolationProgress->setValue(0);
 }
 
 void CVGroup::randomizeValues()
@@ -246,20 +213,66 @@ void CVGroup::computeValues()
 	case VORONOI:
 	case GRADIENT_BAND:
 	case WEIGHTS:
+	{
+		//Float, point and color variables are blended all at once as packed float arrays, the others one by one
+		const int numSlotValues = pm->items.isEmpty() ? 0 : pm->items[0]->values.getNumSlotValues();
+		bool blendPacked = numSlotValues > 0;
+		for (auto& p : pm->items) blendPacked &= p->values.getNumSlotValues() == numSlotValues;
+
+		//computeValues runs on the message thread and on the morpher thread, each thread blends in its own scratch buffer, grown only when needed
+		static thread_local HeapBlock<float> blendValues;
+		static thread_local int blendCapacity = 0;
 
-		for (auto& v : values.items)
+		if (blendPacked)
 		{
-			Array<var> pValues;
-			Parameter* vp = static_cast<Parameter*>(v->controllable);
+			if (numSlotValues > blendCapacity)
+			{
+				blendValues.allocate(numSlotValues, false);
+				blendCapacity = numSlotValues;
+			}
+
+			FloatVectorOperations::clear(blendValues.get(), numSlotValues);
+			for (int i = 0; i < pm->items.size(); i++)
+			{
+				if (weights[i] != 0) pm->items[i]->values.addWeightedSlotValues(blendValues.get(), weights[i]);
+			}
+		}
+
+		int offset = 0;
+		Array<var> pValues;
+		for (int i = 0; i < values.items.size(); i++)
+		{
+			Parameter* vp = dynamic_cast<Parameter*>(values.items[i]->controllable);
+			if (vp == nullptr) continue;
+
+			const int numPacked = PresetParameterContainer::getNumPackedValues(vp);
+			if (blendPacked && numPacked > 0 && offset + numPacked <= numSlotValues)
+			{
+				if (numPacked == 1) vp->setValue(blendValues[offset]);
+				else
+				{
+					var v;
+					for (int j = 0; j < numPacked; j++) v.append(blendValues[offset + j]);
+					vp->setValue(v);
+				}
+
+				offset += numPacked;
+				continue;
+			}
+
+			offset += numPacked;
+
+			pValues.clearQuick();
 			for (auto& p : pm->items)
 			{
-				ParameterPreset* spp = p->values.getParameterPresetForSource(vp);
+				ParameterPreset* spp = p->values.getParameterPresetAt(i);
 				if (spp != nullptr) pValues.add(spp->parameter->value);
 			}
 
 			if (pValues.size() == weights.size()) vp->setWeightedValue(pValues, weights);
 		}
-		break;
+	}
+	break;
 
 	default:
 		break;
@@ -315,9 +328,11 @@ void CVGroup::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Co
 			{
 				morpher.reset(new Morpher(pm.get()));
 				morpher->addMorpherListener(this);
-				morpher->blendMode = cm == VORONOI ? Morpher::VORONOI : Morpher::GRADIENT_BAND;
 				addChildControllableContainer(morpher.get());
 			}
+
+			morpher->blendMode = cm == VORONOI ? Morpher::VORONOI : Morpher::GRADIENT_BAND;
+			morpher->computeZones();
 		}
 		else
 		{
@@ -375,49 +390,6 @@ void CVGroup::loadJSONDataInternal(var data)
 	}
 }
 
-void CVGroup::run()
-{
-	if (targetPreset == nullptr || interpolationTime <= 0) return;
-
-
-	Array<var> sourceValues;
-	for (auto& v : values.items) sourceValues.add(((Parameter*)v->controllable)->value);
-
-	CVPreset p2(this);
-	p2.loadJSONData(targetPreset->getJSONData());
-	for (auto& v : p2.values.manager->items)
-	{
-		if (Parameter* p = dynamic_cast<Parameter*>(v->controllable)) p->isOverriden = true; //force use
-	}
-
-	Automation a;
-	a.isSelectable = false;
-	a.hideInEditor = true;
-	if (interpolationAutomation != nullptr && !automationRef.wasObjectDeleted()) a.loadJSONData(interpolationAutomation->getJSONData());
-
-	interpolationProgress->setValue(0);
-
-	double timeAtStart = Time::getMillisecondCounter() / 1000.0;
-
-	while (!threadShouldExit())
-	{
-		double curTime = Time::getMillisecondCounter() / 1000.0;
-		double rel = jlimit<double>(0., 1., (curTime - timeAtStart) / interpolationTime);
-
-		interpolationProgress->setValue(rel);
-
-		float weight = a.getValueAtPosition(rel);
-		lerpPresets(sourceValues, &p2, weight);
-
-		if (rel == 1) break;
-
-		wait(20); //50fps
-	}
-
-	interpolationProgress->setValue(0);
-	interpolationAutomation = nullptr;
-}
-
 CVGroup::ValuesManager::ValuesManager() :
 	GenericControllableManager("Variables", false, false, true, true)
 {
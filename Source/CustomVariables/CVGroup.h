@@ -16,7 +16,6 @@ class CVPresetManager;
 class CVGroup :
 	public BaseItem,
 	public Morpher::MorpherListener,
-	public Thread,
 	public GenericControllableManager::ManagerListener
 {
 public:
@@ -45,13 +44,8 @@ public:
 	std::unique_ptr<CVPresetManager> pm;
 	std::unique_ptr<Morpher> morpher;
 
-	//Animated interpolation
+	//Animated interpolation, run by the CVInterpolationScheduler
 	Automation defaultInterpolation;
-
-	CVPreset* targetPreset;
-	Automation* interpolationAutomation;
-	WeakReference<Inspectable> automationRef;
-	float interpolationTime;
 	FloatParameter* interpolationProgress;
 
 	void addItemFromParameter(Parameter* source, bool linkAsMaster = true);
@@ -59,10 +53,11 @@ public:
 
 	void itemAdded(GenericControllableItem* item) override;
 	void itemsAdded(Array<GenericControllableItem*> item) override;
+	void itemRemoved(GenericControllableItem* item) override;
+	void itemsRemoved(Array<GenericControllableItem*> items) override;
 	
 	void setValuesToPreset(CVPreset * preset);
 	void lerpPresets(CVPreset * p1, CVPreset * p2, float weight);
-	void lerpPresets(Array<var> sourceValues, CVPreset* endPreset, float weight);
 
 	void goToPreset(CVPreset* p, float time, Automation* curve);
 	void stopInterpolation();
@@ -79,8 +74,6 @@ public:
 	var getJSONData() override;
 	void loadJSONDataInternal(var data) override;
 
-	void run() override;
-
 
 	DECLARE_TYPE("CVGroup")
 };
\ No newline at end of file
@@ -18,12 +18,20 @@ CVGroupManager::CVGroupManager(const String& name) :
 	itemDataType = "CVGroup";
 	module.reset(new CustomVariablesModule(this));
 	addChildControllableContainer(module.get());
+
+	interpolationRate = addIntParameter("Interpolation Rate", "Rate (in Hz) at which the values of all groups are updated when going to a preset", 50, 1, 200);
 }
 
 CVGroupManager::~CVGroupManager()
 {
 }
 
+void CVGroupManager::onContainerParameterChanged(Parameter* p)
+{
+	BaseManager::onContainerParameterChanged(p);
+	if (p == interpolationRate) CVInterpolationScheduler::getInstance()->setRate(interpolationRate->intValue());
+}
+
 void CVGroupManager::showMenuAndGetContainer(ControllableContainer* startFromCC, std::function<void(ControllableContainer*)> returnFunc)
 {
 	PopupMenu menu;
@@ -23,6 +23,10 @@ public:
 
 	std::unique_ptr<CustomVariablesModule> module;
 
+	IntParameter* interpolationRate;
+
+	void onContainerParameterChanged(Parameter* p) override;
+
 	//Input values menu
 	static void showMenuAndGetContainer(ControllableContainer* startFromCC, std::function<void(ControllableContainer*)> returnFunc);
 	static void showMenuAndGetVariable(const StringArray& typeFilters, const StringArray& excludeTypeFilters, ControllableContainer* startFromCC, std::function<void(Controllable*)> returnFunc);
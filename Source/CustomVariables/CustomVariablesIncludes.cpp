@@ -14,6 +14,7 @@
 #include "CVGroupManager.cpp"
 #include "Preset/CVPreset.cpp"
 #include "Preset/CVPresetManager.cpp"
+#include "Preset/CVInterpolationScheduler.cpp"
 #include "Preset/Morpher/MorphTarget.cpp"
 
 #include "Preset/Morpher/Morpher.cpp"
@@ -22,6 +22,7 @@
 
 #include "CVGroup.h"
 #include "CVGroupManager.h"
+#include "Preset/CVInterpolationScheduler.h"
 
 #include "Preset/Morpher/ui/CVPresetMorphUI.h"
 #include "Preset/Morpher/ui/MorphTargetUI.h"
@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+    CVInterpolationScheduler.cpp
+    Created: 18 Oct 2026 11:02:14pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "CustomVariables/CustomVariablesIncludes.h"
+
+juce_ImplementSingleton(CVInterpolationScheduler);
+
+CVInterpolationScheduler::CVInterpolationScheduler() :
+	Thread("CV Interpolation"),
+	rate(50)
+{
+}
+
+CVInterpolationScheduler::~CVInterpolationScheduler()
+{
+	signalThreadShouldExit();
+	notify();
+	stopThread(1000);
+}
+
+void CVInterpolationScheduler::startTransition(CVGroup* group, CVPreset* preset, float time, Automation* curve)
+{
+	if (group == nullptr || preset == nullptr || time <= 0) return;
+
+	Transition::Ptr t = new Transition(group);
+	t->startTime = Time::getMillisecondCounterHiRes();
+	t->time = time * 1000.0;
+
+	//Snapshot, starting from the current values so a running transition is continued from where it is
+	for (int i = 0; i < group->values.items.size(); i++)
+	{
+		Parameter* p = dynamic_cast<Parameter*>(group->values.items[i]->controllable);
+		if (p == nullptr) continue;
+
+		ParameterPreset* pp = preset->values.getParameterPresetAt(i);
+		if (pp == nullptr) continue;
+
+		ParameterPreset::InterpolationMode mode = pp->interpolationMode->getValueDataAsEnum<ParameterPreset::InterpolationMode>();
+		if (mode == ParameterPreset::NONE) continue;
+
+		var startValue = p->value.clone();
+		var targetValue = pp->parameter->value.clone();
+
+		t->targetParams.add(p);
+		t->targetValues.add(targetValue);
+
+		const int size = startValue.isArray() ? startValue.size() : 1;
+		bool canInterpolate = false;
+		if (mode == ParameterPreset::INTERPOLATE)
+		{
+			switch (p->type)
+			{
+			case Parameter::FLOAT:
+			case Parameter::INT:
+				canInterpolate = !startValue.isArray() && !targetValue.isArray();
+				break;
+
+			case Parameter::POINT2D:
+			case Parameter::POINT3D:
+			case Parameter::COLOR:
+				canInterpolate = startValue.isArray() && targetValue.isArray() && targetValue.size() == size;
+				break;
+
+			default:
+				break;
+			}
+		}
+
+		if (!canInterpolate)
+		{
+			t->switchedParams.add(p);
+			t->changeAtStart.add(mode != ParameterPreset::CHANGE_AT_END);
+			t->switchedStartValues.add(startValue);
+			t->switchedTargetValues.add(targetValue);
+			continue;
+		}
+
+		t->interpolatedParams.add(p);
+		t->offsets.add(t->numValues);
+		t->sizes.add(size);
+		t->numValues += size;
+
+		for (int j = 0; j < size; j++)
+		{
+			const float start = startValue.isArray() ? (float)startValue[j] : (float)startValue;
+			const float target = targetValue.isArray() ? (float)targetValue[j] : (float)targetValue;
+			t->startValues.add(start);
+			t->deltaValues.add(target - start);
+		}
+	}
+
+	t->currentValues.allocate(jmax(1, t->numValues), true);
+
+	//Curve sampled on the calling thread, no copy of the automation
+	for (int i = 0; i <= curveResolution; i++)
+	{
+		const float rel = i * 1.0f / curveResolution;
+		t->curve[i] = curve != nullptr ? (float)curve->getValueAtPosition(rel) : rel;
+	}
+
+	Transition::Ptr previous;
+	{
+		GenericScopedLock lock(transitionsLock);
+		previous = removeTransition(group);
+		transitions.add(t);
+	}
+
+	if (previous != nullptr) previous->active = false;
+
+	if (!isThreadRunning()) startThread();
+	else notify();
+}
+
+void CVInterpolationScheduler::stopTransition(CVGroup* group, bool waitForCompletion)
+{
+	Transition::Ptr t;
+	{
+		GenericScopedLock lock(transitionsLock);
+		t = removeTransition(group);
+	}
+
+	if (t == nullptr) return;
+	t->active = false;
+
+	if (!waitForCompletion) return;
+
+	//The tick may be processing a transition of this group right now, the lock is released when it's done.
+	//All transitions of the group are inactive now, so no tick processes them after that. Reentrant if we are called from inside the tick.
+	GenericScopedLock lock(processLock);
+}
+
+bool CVInterpolationScheduler::isInterpolating(CVGroup* group)
+{
+	GenericScopedLock lock(transitionsLock);
+	for (auto& t : transitions) if (t->group == group) return true;
+	return false;
+}
+
+void CVInterpolationScheduler::setRate(int newRate)
+{
+	rate = jlimit(1, 1000, newRate);
+	notify();
+}
+
+CVInterpolationScheduler::Transition::Ptr CVInterpolationScheduler::removeTransition(CVGroup* group)
+{
+	for (int i = 0; i < transitions.size(); i++)
+	{
+		if (transitions[i]->group != group) continue;
+		Transition::Ptr t = transitions[i];
+		transitions.remove(i);
+		return t;
+	}
+
+	return nullptr;
+}
+
+void CVInterpolationScheduler::run()
+{
+	double nextTime = Time::getMillisecondCounterHiRes();
+
+	while (!threadShouldExit())
+	{
+		ReferenceCountedArray<Transition> toProcess;
+		{
+			GenericScopedLock lock(transitionsLock);
+			toProcess = transitions;
+		}
+
+		if (toProcess.isEmpty())
+		{
+			wait(100); //startTransition notifies when a transition comes in
+			nextTime = Time::getMillisecondCounterHiRes();
+			continue;
+		}
+
+		const double now = Time::getMillisecondCounterHiRes();
+		if (now < nextTime)
+		{
+			wait(jmax(1, (int)(nextTime - now)));
+			continue;
+		}
+
+		const double period = 1000.0 / rate;
+		nextTime += period;
+		if (nextTime <= now) nextTime = now + period; //overrun, skip the missed ticks
+
+		for (auto& t : toProcess)
+		{
+			bool finished = false;
+			{
+				GenericScopedLock lock(processLock);
+				if (t->active) finished = processTransition(t, now);
+			}
+
+			if (!finished) continue;
+
+			GenericScopedLock lock(transitionsLock);
+			if (transitions.contains(t)) transitions.removeObject(t);
+			t->active = false;
+		}
+	}
+}
+
+bool CVInterpolationScheduler::processTransition(Transition* t, double currentTime)
+{
+	CVGroup* group = t->group;
+
+	const double rel = jlimit(0.0, 1.0, (currentTime - t->startTime) / t->time);
+	group->interpolationProgress->setValue(rel);
+
+	const float weight = t->getWeight(rel);
+
+	if (weight == 1)
+	{
+		for (int i = 0; i < t->targetParams.size(); i++)
+		{
+			if (Parameter* p = t->targetParams.getReference(i).get()) p->setValue(t->targetValues[i]);
+		}
+	}
+	else
+	{
+		if (t->numValues > 0)
+		{
+			FloatVectorOperations::copy(t->currentValues.get(), t->startValues.getRawDataPointer(), t->numValues);
+			FloatVectorOperations::addWithMultiply(t->currentValues.get(), t->deltaValues.getRawDataPointer(), weight, t->numValues);
+		}
+
+		for (int i = 0; i < t->interpolatedParams.size(); i++)
+		{
+			Parameter* p = t->interpolatedParams.getReference(i).get();
+			if (p == nullptr) continue; //removed from the group since the start
+
+			const float* v = t->currentValues + t->offsets.getUnchecked(i);
+			const int size = t->sizes.getUnchecked(i);
+
+			if (p->type == Parameter::FLOAT || p->type == Parameter::INT)
+			{
+				if (p->type == Parameter::INT) p->setValue(roundToInt(v[0]));
+				else p->setValue(v[0]);
+				continue;
+			}
+
+			var value;
+			for (int j = 0; j < size; j++) value.append(v[j]);
+			p->setValue(value);
+		}
+
+		for (int i = 0; i < t->switchedParams.size(); i++)
+		{
+			Parameter* p = t->switchedParams.getReference(i).get();
+			if (p == nullptr) continue;
+
+			const bool useTarget = t->changeAtStart.getUnchecked(i) && weight != 0;
+			p->setValue(useTarget ? t->switchedTargetValues[i] : t->switchedStartValues[i]);
+		}
+	}
+
+	if (rel < 1) return false;
+
+	group->interpolationProgress->setValue(0);
+	return true;
+}
+
+float CVInterpolationScheduler::Transition::getWeight(double rel) const
+{
+	const double pos = jlimit(0.0, 1.0, rel) * curveResolution;
+	const int index = jmin((int)pos, curveResolution - 1);
+	const float frac = (float)(pos - index);
+	return curve[index] + (curve[index + 1] - curve[index]) * frac;
+}
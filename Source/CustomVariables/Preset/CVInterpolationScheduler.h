@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    CVInterpolationScheduler.h
+    Created: 18 Oct 2026 11:02:14pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class CVGroup;
+class CVPreset;
+
+/*
+	Runs the preset transitions of all CVGroups (goToPreset) on one thread, at a common rate.
+	Start and target values are copied when the transition starts : interpolated values in float buffers,
+	the others as vars, and the curve is sampled in a table, so the tick doesn't touch the preset or the automation.
+	Going to another preset while a transition is running replaces it, starting from the current values.
+*/
+class CVInterpolationScheduler :
+	public Thread
+{
+public:
+	juce_DeclareSingleton(CVInterpolationScheduler, true);
+
+	CVInterpolationScheduler();
+	~CVInterpolationScheduler();
+
+	static const int curveResolution = 256;
+
+	class Transition :
+		public ReferenceCountedObject
+	{
+	public:
+		Transition(CVGroup* group) : group(group), active(true), startTime(0), time(0), numValues(0) {}
+
+		CVGroup* group; //only dereferenced while active, with processLock held
+		std::atomic<bool> active;
+
+		double startTime;
+		double time; //ms
+
+		//Interpolated variables (float, int, point and color), current = start + delta * weight
+		Array<WeakReference<Parameter>> interpolatedParams; //weak, variables can be removed from the group during the transition
+		Array<int> offsets;
+		Array<int> sizes;
+		Array<float> startValues;
+		Array<float> deltaValues;
+		HeapBlock<float> currentValues;
+		int numValues;
+
+		//Variables that jump from start to target : change at start / end modes, and types that can't be interpolated as floats
+		Array<WeakReference<Parameter>> switchedParams;
+		Array<bool> changeAtStart;
+		Array<var> switchedStartValues;
+		Array<var> switchedTargetValues;
+
+		//All variables, set exactly at the end
+		Array<WeakReference<Parameter>> targetParams;
+		Array<var> targetValues;
+
+		float curve[curveResolution + 1];
+		float getWeight(double rel) const;
+
+		typedef ReferenceCountedObjectPtr<Transition> Ptr;
+	};
+
+	void startTransition(CVGroup* group, CVPreset* preset, float time, Automation* curve);
+	void stopTransition(CVGroup* group, bool waitForCompletion = false); //wait before deleting the group
+	bool isInterpolating(CVGroup* group);
+
+	void setRate(int rate);
+
+	void run() override;
+
+private:
+	CriticalSection transitionsLock;
+	CriticalSection processLock; //held by the tick while processing a transition, stopping takes it to wait for the end of the processing
+	ReferenceCountedArray<Transition> transitions;
+	std::atomic<int> rate;
+
+	Transition::Ptr removeTransition(CVGroup* group);
+	bool processTransition(Transition* t, double currentTime); //true when finished
+
+	JUCE_DECLARE_NON_COPYABLE(CVInterpolationScheduler)
+};
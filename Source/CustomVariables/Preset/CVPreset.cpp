@@ -98,6 +98,10 @@ PresetParameterContainer::PresetParameterContainer(const String& name, GenericCo
 	ControllableContainer(name),
 	manager(manager),
 	keepValuesInSync(keepValuesInSync),
+	numSlotValues(0),
+	hasAllPackedSlots(true),
+	slotsAreDirty(true),
+	slotValuesAreDirty(true),
 	linkedComparator(manager)
 {
 	saveAndLoadRecursiveData = true;
@@ -131,6 +135,8 @@ void PresetParameterContainer::resetAndBuildValues(bool syncValues)
 
 	clear();
 	linkMap.clear();
+	sourceMap.clear();
+	slotsAreDirty = true;
 
 	for (auto& gci : manager->items)
 	{
@@ -146,6 +152,8 @@ void PresetParameterContainer::addValueFromItem(Parameter* source)
 	Parameter* p = dynamic_cast<Parameter*>(c);
 	ParameterPreset* pp = new ParameterPreset(p);
 	linkMap.set(pp, source);
+	sourceMap.set(source, pp);
+	slotsAreDirty = true;
 	source->addControllableListener(this);
 	source->addParameterListener(this);
 	p->forceSaveValue = true;
@@ -236,7 +244,9 @@ void PresetParameterContainer::itemRemoved(GenericControllableItem* gci)
 	{
 		linkMap[pp]->removeControllableListener(this);
 		linkMap[pp]->removeParameterListener(this);
+		sourceMap.remove(linkMap[pp]);
 		linkMap.remove(pp);
+		slotsAreDirty = true;
 
 		removeChildControllableContainer(pp);
 	}
@@ -252,7 +262,9 @@ void PresetParameterContainer::itemsRemoved(Array<GenericControllableItem*> item
 		{
 			linkMap[pp]->removeControllableListener(this);
 			linkMap[pp]->removeParameterListener(this);
+			sourceMap.remove(linkMap[pp]);
 			linkMap.remove(pp);
+			slotsAreDirty = true;
 
 			removeChildControllableContainer(pp);
 		}
@@ -263,6 +275,7 @@ void PresetParameterContainer::itemsRemoved(Array<GenericControllableItem*> item
 void PresetParameterContainer::itemsReordered()
 {
 	controllables.sort(linkedComparator);
+	slotsAreDirty = true;
 	controllableContainerListeners.call(&ControllableContainerListener::controllableContainerReordered, this);
 	queuedNotifier.addMessage(new ContainerAsyncEvent(ContainerAsyncEvent::ControllableContainerReordered, this));
 }
@@ -294,11 +307,107 @@ void PresetParameterContainer::controllableNameChanged(Controllable* sourceC)
 	syncItem(pp, keepValuesInSync);
 }
 
+void PresetParameterContainer::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
+{
+	ControllableContainer::onControllableFeedbackUpdateInternal(cc, c);
+	slotValuesAreDirty = true;
+}
+
 ParameterPreset* PresetParameterContainer::getParameterPresetForSource(Parameter* p)
 {
-	HashMap<ParameterPreset*, Parameter*>::Iterator i(linkMap);
-	while (i.next()) if (p == i.getValue()) return i.getKey();
-	return nullptr;
+	return sourceMap.contains(p) ? sourceMap[p] : nullptr;
+}
+
+int PresetParameterContainer::getNumPackedValues(Parameter* p)
+{
+	if (p == nullptr) return 0;
+
+	switch (p->type)
+	{
+	case Parameter::FLOAT: return 1;
+	case Parameter::POINT2D: return 2;
+	case Parameter::POINT3D: return 3;
+	case Parameter::COLOR: return 4;
+	default: break;
+	}
+
+	return 0;
+}
+
+ParameterPreset* PresetParameterContainer::getParameterPresetAt(int slot)
+{
+	GenericScopedLock lock(slotLock);
+	if (slotsAreDirty) updateSlots();
+	return slotPresets[slot];
+}
+
+int PresetParameterContainer::getNumSlotValues()
+{
+	GenericScopedLock lock(slotLock);
+	if (slotsAreDirty) updateSlots();
+	return hasAllPackedSlots ? numSlotValues : -1;
+}
+
+void PresetParameterContainer::addWeightedSlotValues(float* dest, float weight)
+{
+	GenericScopedLock lock(slotLock);
+	if (slotsAreDirty) updateSlots();
+	if (slotValuesAreDirty) updateSlotValues();
+	if (numSlotValues > 0) FloatVectorOperations::addWithMultiply(dest, slotValues.get(), weight, numSlotValues);
+}
+
+void PresetParameterContainer::updateSlots()
+{
+	slotPresets.clearQuick();
+	slotOffsets.clearQuick();
+	numSlotValues = 0;
+	hasAllPackedSlots = true;
+
+	for (auto& gci : manager->items)
+	{
+		Parameter* source = dynamic_cast<Parameter*>(gci->controllable);
+		ParameterPreset* pp = getParameterPresetForSource(source);
+		slotPresets.add(pp);
+
+		const int numValues = getNumPackedValues(source);
+		if (numValues > 0 && pp == nullptr) hasAllPackedSlots = false;
+		slotOffsets.add(numValues > 0 ? numSlotValues : -1);
+		numSlotValues += numValues;
+	}
+
+	slotValues.allocate(jmax(1, numSlotValues), true);
+	slotsAreDirty = false;
+	slotValuesAreDirty = true;
+}
+
+void PresetParameterContainer::updateSlotValues()
+{
+	//cleared first, so it can't be missed if a value changes while it's read
+	slotValuesAreDirty = false;
+
+	for (int i = 0; i < slotPresets.size(); i++)
+	{
+		const int offset = slotOffsets.getUnchecked(i);
+		ParameterPreset* pp = slotPresets.getUnchecked(i);
+		if (offset < 0) continue;
+
+		if (pp == nullptr)
+		{
+			slotValues[offset] = 0;
+			continue;
+		}
+
+		Parameter* p = pp->parameter;
+		if (p->type == Parameter::FLOAT)
+		{
+			slotValues[offset] = p->floatValue();
+			continue;
+		}
+
+		const int numValues = getNumPackedValues(p);
+		var v = p->value;
+		for (int j = 0; j < numValues; j++) slotValues[offset + j] = j < v.size() ? (float)v[j] : 0;
+	}
 }
 
 void PresetParameterContainer::loadJSONData(var data, bool createIfNotThere)
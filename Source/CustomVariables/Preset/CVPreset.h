@@ -38,9 +38,27 @@ public:
 	GenericControllableManager* manager;
 	//OwnedArray<ParameterPreset> presets;
 	HashMap<ParameterPreset*,  Parameter*> linkMap;
+	HashMap<Parameter*, ParameterPreset*> sourceMap;
 
 	bool keepValuesInSync;
 
+	//Dense storage, indexed by the slot of the source in the manager's items.
+	//Float, point and color values are also packed in slotValues so presets can be blended as plain float arrays.
+	SpinLock slotLock;
+	Array<ParameterPreset*> slotPresets;
+	Array<int> slotOffsets; //offset in slotValues, -1 if the value is not packed
+	HeapBlock<float> slotValues;
+	int numSlotValues;
+	bool hasAllPackedSlots;
+	std::atomic<bool> slotsAreDirty;
+	std::atomic<bool> slotValuesAreDirty;
+
+	static int getNumPackedValues(Parameter* p); //0 if the type can't be blended as floats
+
+	ParameterPreset* getParameterPresetAt(int slot);
+	int getNumSlotValues(); //-1 if a packed value has no preset entry
+	void addWeightedSlotValues(float* dest, float weight); //dest holds getNumSlotValues() floats
+
 	void resetAndBuildValues(bool syncValues = true);
 
 	void addValueFromItem(Parameter* source);
@@ -59,9 +77,13 @@ public:
 	void parameterValueChanged(Parameter*) override;
 	void parameterRangeChanged(Parameter*) override;
 	void controllableNameChanged(Controllable*) override;
+	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 
 	ParameterPreset * getParameterPresetForSource(Parameter* p);
 
+	void updateSlots(); //with slotLock held
+	void updateSlotValues(); //with slotLock held
+
 	//var getJSONData() override;
 	void loadJSONData(var data, bool createIfNotThere = false) override;
 
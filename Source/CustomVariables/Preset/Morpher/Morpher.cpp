@@ -106,11 +106,17 @@ CVPreset* Morpher::getEnabledTargetAtIndex(int index)
 
 void Morpher::computeZones()
 {
-	GenericScopedLock lock(voronoiLock);
+	voronoiLock.enter();
 
 	Array<Point<float>> points = getNormalizedTargetPoints();
 
-	if (points.size() == 0) return;
+	if (points.size() == 0)
+	{
+		siteData.clearQuick();
+		edgeData.clearQuick();
+		voronoiLock.exit();
+		return;
+	}
 
 	Array<jcv_point> jPoints;
 
@@ -126,7 +132,117 @@ void Morpher::computeZones()
 	if (diagram->internal != nullptr && diagram->internal->memctx != nullptr) jcv_diagram_free(diagram.get());
 	jcv_diagram_generate(points.size(), jPoints.getRawDataPointer(), nullptr, diagram.get());
 
-	computeWeights();
+	cacheSites();
+	computeWeightField();
+
+	voronoiLock.exit();
+
+	computeWeights(); //only try-locks, so after releasing the lock
+}
+
+void Morpher::cacheSites()
+{
+	siteData.clearQuick();
+	edgeData.clearQuick();
+
+	for (int i = 0; i < presetManager->items.size(); i++)
+	{
+		CVPreset* p = presetManager->items[i];
+		if (!p->enabled->boolValue()) continue;
+		siteData.add({ p->viewUIPosition->getPoint(), p, i, 0, 0 });
+	}
+
+	//jcv sorts its sites, s.index is the index in the points given to the diagram, so the index in siteData
+	const jcv_site* sites = jcv_diagram_get_sites(diagram.get());
+	for (int i = 0; i < diagram->numsites; ++i)
+	{
+		const jcv_site& s = sites[i];
+		if (!isPositiveAndBelow(s.index, siteData.size())) continue;
+
+		SiteData& sd = siteData.getReference(s.index);
+		sd.firstEdge = edgeData.size();
+
+		for (jcv_graphedge* edge = s.edges; edge != nullptr; edge = edge->next)
+		{
+			if (edge->neighbor == nullptr || !isPositiveAndBelow(edge->neighbor->index, siteData.size())) continue;
+			Line<float> line(Point<float>(edge->pos[0].x, edge->pos[0].y), Point<float>(edge->pos[1].x, edge->pos[1].y));
+			edgeData.add({ line, edge->neighbor->index });
+		}
+
+		sd.numEdges = edgeData.size() - sd.firstEdge;
+	}
+
+	int maxEdges = 0;
+	for (auto& sd : siteData) maxEdges = jmax(maxEdges, sd.numEdges);
+	edgeDists.ensureStorageAllocated(maxEdges);
+	edgeNeighbourDists.ensureStorageAllocated(maxEdges);
+	siteWeights.ensureStorageAllocated(siteData.size());
+	presetWeights.ensureStorageAllocated(presetManager->items.size());
+}
+
+void Morpher::computeWeightField()
+{
+	const int numSites = siteData.size();
+	if (blendMode != GRADIENT_BAND || numSites < 2)
+	{
+		weightField.free();
+		return;
+	}
+
+	Rectangle<float> bounds(siteData[0].position, siteData[0].position);
+	for (auto& sd : siteData) bounds = bounds.getUnion(Rectangle<float>(sd.position, sd.position));
+
+	//some room around the sites, the target is clamped to the field
+	const float margin = jmax(bounds.getWidth(), bounds.getHeight(), .1f) * .5f;
+	weightFieldBounds = bounds.expanded(margin);
+
+	const int res = weightFieldResolution;
+	weightField.allocate(res * res * numSites, false);
+
+	for (int y = 0; y < res; y++)
+	{
+		for (int x = 0; x < res; x++)
+		{
+			Point<float> p = weightFieldBounds.getRelativePoint(x / (res - 1.0f), y / (res - 1.0f));
+			float* w = weightField + (y * res + x) * numSites;
+
+			float total = 0;
+			for (int i = 0; i < numSites; i++)
+			{
+				w[i] = getGradientBandWeight(i, p);
+				total += w[i];
+			}
+
+			if (total > 0) FloatVectorOperations::multiply(w, 1.0f / total, numSites);
+			else
+			{
+				//far outside the sites, all bands are 0
+				FloatVectorOperations::clear(w, numSites);
+				w[getNearestSite(p)] = 1;
+			}
+		}
+	}
+}
+
+float Morpher::getGradientBandWeight(int siteIndex, Point<float> p) const
+{
+	//Gradient band : for each other site, 1 at this site going down to 0 at the other one, projected on the line between them
+	const Point<float> si = siteData.getReference(siteIndex).position;
+	const Point<float> ps = p - si;
+
+	float w = 1;
+	for (int j = 0; j < siteData.size(); j++)
+	{
+		if (j == siteIndex) continue;
+
+		const Point<float> sij = siteData.getReference(j).position - si;
+		const float lengthSquared = sij.getDotProduct(sij);
+		if (lengthSquared == 0) continue;
+
+		w = jmin(w, 1 - ps.getDotProduct(sij) / lengthSquared);
+	}
+
+	return jmax(w, 0.0f);
 }
 
 int Morpher::getSiteIndexForPoint(Point<float> p)
@@ -153,161 +269,174 @@ int Morpher::getSiteIndexForPoint(Point<float> p)
 }
 
 
+int Morpher::getNearestSite(Point<float> p) const
+{
+	int index = -1;
+	float minDist = 0;
+	for (int i = 0; i < siteData.size(); i++)
+	{
+		float dist = p.getDistanceSquaredFrom(siteData.getReference(i).position);
+		if (index == -1 || dist < minDist)
+		{
+			minDist = dist;
+			index = i;
+		}
+	}
+
+	return index;
+}
+
 void Morpher::computeWeights()
 {
 	if (!voronoiLock.tryEnter()) return;
 
+	Point<float> mp = mainTarget.viewUIPosition->getPoint();
+
+	bool hasWeights = false;
 	switch (blendMode)
 	{
-	case VORONOI:
-	{
-		if (diagram->numsites <= 1) break;
-
-		Point<float> mp = mainTarget.viewUIPosition->getPoint();
+	case VORONOI: hasWeights = computeVoronoiWeights(mp); break;
+	case GRADIENT_BAND: hasWeights = computeGradientBandWeights(mp); break;
+	default: break;
+	}
 
-		for (CVPreset* mt : presetManager->items) mt->weight->setValue(0);
+	if (hasWeights) publishWeights();
 
-		HashMap<CVPreset*, float> rawWeights;
-		float totalRawWeight = 0;
+	voronoiLock.exit();
+	morpherListeners.call(&MorpherListener::weightsUpdated);
+}
 
+bool Morpher::computeVoronoiWeights(Point<float> mp)
+{
+	if (diagram->numsites <= 1 || siteData.size() <= 1) return false;
 
-		int index = getSiteIndexForPoint(mp);
-		if (index == -1) break;
+	int index = getNearestSite(mp);
+	if (index == -1) return false;
 
-		const jcv_site* sites = jcv_diagram_get_sites(diagram.get());
+	siteWeights.clearQuick();
+	siteWeights.insertMultiple(0, 0, siteData.size());
 
-		jcv_site s = sites[index];
+	const SiteData& s = siteData.getReference(index);
+	float safeZ = safeZone->floatValue();
 
-		//curZoneIndex->setValue(getSiteIndexForPoint(mp));
+	//Compute direct site
+	float d = jmax<float>(mp.getDistanceFrom(s.position) - safeZ, 0);
 
-		float safeZ = safeZone->floatValue();
+	if (d == 0)
+	{
+		siteWeights.set(index, 1);
+		return true;
+	}
 
-		//Compute direct site
-		CVPreset* mt = getEnabledTargetAtIndex(s.index);
-		float d = jmax<float>(mp.getDistanceFrom(Point<float>(s.p.x, s.p.y)) - safeZ, 0);
+	float totalRawWeight = 1.0f / d;
+	siteWeights.set(index, totalRawWeight);
 
-		if (d == 0)
-		{
-			mt->weight->setValue(1);
-			break;
-		}
+	//Fill edge distances
+	edgeDists.clearQuick();
+	edgeNeighbourDists.clearQuick();
 
-		float mw = (float)INT32_MAX;
-		if (d != 0) mw = 1.0f / d;
-		rawWeights.set(mt, mw);
-		totalRawWeight += mw;
+	for (int i = 0; i < s.numEdges; i++)
+	{
+		const EdgeData& e = edgeData.getReference(s.firstEdge + i);
 
+		Point<float> np;
+		float distToEdge = e.line.getDistanceFromPoint(mp, np);
+		float distNeighbourToEdge = jmax<float>(np.getDistanceFrom(siteData.getReference(e.neighbour).position) - safeZ, 0);
 
+		edgeDists.add(distToEdge);
+		edgeNeighbourDists.add(distNeighbourToEdge);
+	}
 
-		//Fill edge distances
-		jcv_graphedge* edge = s.edges;
-		Array<jcv_graphedge*> edges;
+	//Compute weight for each neighbour
+	for (int i = 0; i < s.numEdges; ++i)
+	{
+		const EdgeData& e = edgeData.getReference(s.firstEdge + i);
 
-		Array<float> edgeDists;
-		Array<float> edgeNeighbourDists;
-		Array<jcv_site*> neighbourSites;
-		Array<Line<float>> edgeLines;
+		float edgeDist = edgeDists.getUnchecked(i);
+		float totalDist = edgeDist + edgeNeighbourDists.getUnchecked(i);
 
-		while (edge != nullptr)
+		float w = 0;
+		if (s.numEdges > 1)
 		{
-			jcv_site* ns = edge->neighbor;// e->sites[0]->index == s.index ? e->sites[1] : e->sites[0];
-
-			if (ns == nullptr)
+			float minOtherEdgeDist = (float)INT32_MAX;
+			for (int j = 0; j < s.numEdges; j++)
 			{
-				edge = edge->next;
-				continue;
+				if (i != j) minOtherEdgeDist = jmin(minOtherEdgeDist, edgeDists.getUnchecked(j));
 			}
 
-			//DBG("Site " << s.index << " : Edge has sites " << e->sites[0]->index << "and " << e->sites[1]->index << ", chosen " << ns->index);
-			//DBG("\t\t" << edge->pos[0].x << " / " << edge->pos[0].y << " / " << edge->pos[1].x << " / " << edge->pos[1].y);
-
-			Line<float> line(Point<float>(edge->pos[0].x, edge->pos[0].y), Point<float>(edge->pos[1].x, edge->pos[1].y));
-			Point<float> np;
-			float distToEdge = line.getDistanceFromPoint(mp, np);
-			float distNeighbourToEdge = jmax<float>(np.getDistanceFrom(Point<float>(ns->p.x, ns->p.y)) - safeZ, 0);
-
-			edges.add(edge);
-
-			edgeDists.add(distToEdge);
-			edgeNeighbourDists.add(distNeighbourToEdge);
-			neighbourSites.add(ns);
-			edgeLines.add(line);
-
-			edge = edge->next;
+			float ratio = 1 - (edgeDist / (edgeDist + minOtherEdgeDist));
+			w = ratio / totalDist;
 		}
-
-		//DBG("Num edges to test " << edges.size());
-
-		//Compute weight for each neighbour
-		for (int i = 0; i < edges.size(); ++i)
+		else
 		{
-			float edgeDist = edgeDists[i];
-			float edgeNDist = edgeNeighbourDists[i];
-			float totalDist = edgeDist + edgeNDist;
-
-
-			float minOtherEdgeDist = (float)INT32_MAX;
-			jcv_graphedge* minEdge = nullptr;
-
-			for (int j = 0; j < edges.size(); j++)
-			{
-				if (i == j) continue;
-
-				//if (checkSitesAreNeighbours(edges[i]->neighbor, edges[j]->neighbor)) continue;
-
-				float ed = edgeDists[j];
-				if (ed < minOtherEdgeDist)
-				{
-					minOtherEdgeDist = ed;
-					minEdge = edges[j];
-				}
-			}
-
-
-			float w = 0;
-			if (minEdge != nullptr)
-			{
-				float ratio = 1 - (edgeDist / (edgeDist + minOtherEdgeDist));
-				w = ratio / totalDist;
-			}
-			else
-			{
-				float directDist = jmax<float>(mp.getDistanceFrom(Point<float>(neighbourSites[i]->p.x, neighbourSites[i]->p.y)) - safeZ, 0); //if we want to check direct distance instead of path to point
-				if (directDist > 0) w = 1.0f / directDist;
-				else w = (float)INT32_MAX;
-			}
-
-			CVPreset* nmt = getEnabledTargetAtIndex(neighbourSites[i]->index);
-			rawWeights.set(nmt, w);
-			totalRawWeight += w;
+			float directDist = jmax<float>(mp.getDistanceFrom(siteData.getReference(e.neighbour).position) - safeZ, 0); //if we want to check direct distance instead of path to point
+			if (directDist > 0) w = 1.0f / directDist;
+			else w = (float)INT32_MAX;
 		}
 
-		//DBG("Cur site " << s.index << " : " << mt->niceName << ": " << mw << ", total =  " << totalRawWeight << ", numWeighted neighbours " << rawWeights.size());
+		siteWeights.set(e.neighbour, w);
+		totalRawWeight += w;
+	}
 
+	//Normalize weights
+	FloatVectorOperations::multiply(siteWeights.getRawDataPointer(), 1.0f / totalRawWeight, siteWeights.size());
+	return true;
+}
 
-		//Normalize weights
-		for (HashMap<CVPreset*, float>::Iterator i(rawWeights); i.next();)
-		{
-			float val = i.getValue() / totalRawWeight;
-			i.getKey()->weight->setValue(val);
+bool Morpher::computeGradientBandWeights(Point<float> mp)
+{
+	const int numSites = siteData.size();
+	if (numSites == 0) return false;
 
-		}
+	siteWeights.clearQuick();
+	siteWeights.insertMultiple(0, 0, numSites);
 
+	if (numSites == 1)
+	{
+		siteWeights.set(0, 1);
+		return true;
 	}
-	break;
 
+	if (weightField == nullptr) return false;
+
+	int nearest = getNearestSite(mp);
+	if (mp.getDistanceFrom(siteData.getReference(nearest).position) <= safeZone->floatValue())
+	{
+		siteWeights.set(nearest, 1);
+		return true;
+	}
 
+	//Bilinear interpolation between the 4 cells around the target
+	const int res = weightFieldResolution;
+	const float fx = jlimit(0.0f, res - 1.0f, (mp.x - weightFieldBounds.getX()) / weightFieldBounds.getWidth() * (res - 1));
+	const float fy = jlimit(0.0f, res - 1.0f, (mp.y - weightFieldBounds.getY()) / weightFieldBounds.getHeight() * (res - 1));
+	const int x0 = jmin((int)fx, res - 2);
+	const int y0 = jmin((int)fy, res - 2);
+	const float tx = fx - x0;
+	const float ty = fy - y0;
+
+	float* w = siteWeights.getRawDataPointer();
+	FloatVectorOperations::addWithMultiply(w, weightField + (y0 * res + x0) * numSites, (1 - tx) * (1 - ty), numSites);
+	FloatVectorOperations::addWithMultiply(w, weightField + (y0 * res + x0 + 1) * numSites, tx * (1 - ty), numSites);
+	FloatVectorOperations::addWithMultiply(w, weightField + ((y0 + 1) * res + x0) * numSites, (1 - tx) * ty, numSites);
+	FloatVectorOperations::addWithMultiply(w, weightField + ((y0 + 1) * res + x0 + 1) * numSites, tx * ty, numSites);
+
+	return true;
+}
 
-	case GRADIENT_BAND:
-		//Not implemented yet
-		break;
+void Morpher::publishWeights()
+{
+	presetWeights.clearQuick();
+	presetWeights.insertMultiple(0, 0, presetManager->items.size());
 
-	default:
-		break;
+	for (int i = 0; i < siteData.size(); i++)
+	{
+		const SiteData& sd = siteData.getReference(i);
+		if (presetManager->items[sd.presetIndex] == sd.preset) presetWeights.set(sd.presetIndex, siteWeights[i]);
 	}
 
-	voronoiLock.exit();
-	morpherListeners.call(&MorpherListener::weightsUpdated);
+	//Each weight is set once, unchanged weights don't notify
+	for (int i = 0; i < presetWeights.size(); i++) presetManager->items[i]->weight->setValue(presetWeights.getUnchecked(i));
 }
 
 bool Morpher::checkSitesAreNeighbours(jcv_site* s1, jcv_site* s2)
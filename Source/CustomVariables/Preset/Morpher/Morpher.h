@@ -57,12 +57,50 @@ public:
 
 	SpinLock voronoiLock;
 
+	//Sites of the enabled targets, in the order given to the diagram, cached by computeZones so computeWeights doesn't walk the diagram
+	struct SiteData
+	{
+		Point<float> position;
+		CVPreset* preset;
+		int presetIndex; //in presetManager->items
+		int firstEdge; //in edgeData
+		int numEdges;
+	};
+
+	struct EdgeData
+	{
+		Line<float> line;
+		int neighbour; //in siteData
+	};
+
+	Array<SiteData> siteData;
+	Array<EdgeData> edgeData;
+
+	//Gradient band, normalized weights of all sites for each cell of a grid around the sites
+	static const int weightFieldResolution = 64;
+	Rectangle<float> weightFieldBounds;
+	HeapBlock<float> weightField;
+
+	//Scratch buffers, only used with voronoiLock held
+	Array<float> edgeDists;
+	Array<float> edgeNeighbourDists;
+	Array<float> siteWeights;
+	Array<float> presetWeights;
+
 	//Voronoi
 	void computeZones();
 	int getSiteIndexForPoint(Point<float> p);
 
 	void computeWeights();
 
+	void cacheSites();
+	void computeWeightField();
+	float getGradientBandWeight(int siteIndex, Point<float> p) const;
+	int getNearestSite(Point<float> p) const;
+	bool computeVoronoiWeights(Point<float> mp);
+	bool computeGradientBandWeights(Point<float> mp);
+	void publishWeights(); //sets all preset weights once, from siteWeights
+
 	bool checkSitesAreNeighbours(jcv_site * s1, jcv_site * s2);
 
 	void onContainerParameterChanged(Parameter* p) override;
@@ -116,6 +116,10 @@ public:
 
 	virtual RouteParams * createRouteParamsForSourceValue(Module * /*sourceModule*/, Controllable * /*c*/, int /*index*/) { jassert(false); return nullptr; }
 	virtual void handleRoutedModuleValue(Controllable * /*c*/, RouteParams * /*params*/) {} //used for routing, child classes that support routing must override
+	virtual void handleRoutedModuleValues(const Array<Controllable*>& values, const Array<RouteParams*>& params) //batched routing, override to send all the values at once
+	{
+		for (int i = 0; i < values.size(); i++) handleRoutedModuleValue(values[i], params[i]);
+	}
 
 	virtual ModuleRouterController* createModuleRouterController(ModuleRouter* router) { return nullptr; }
 
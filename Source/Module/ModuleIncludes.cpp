@@ -51,8 +51,10 @@
 #include "modules/audio/AudioModule.cpp"
 #include "modules/audio/analysis/FFTAnalyzer.cpp"
 #include "modules/audio/analysis/FFTAnalyzerManager.cpp"
+#include "modules/audio/analysis/PitchAnalysisThread.cpp"
 #include "modules/audio/analysis/ui/FFTAnalyzerEditor.cpp"
 #include "modules/audio/analysis/ui/FFTAnalyzerManagerEditor.cpp"
+#include "modules/audio/ltc/LTCGenerator.cpp"
 #include "modules/audio/commands/PlayAudioFileCommand.cpp"
 #include "modules/audio/ui/AudioModuleHardwareEditor.cpp"
 
@@ -32,11 +32,14 @@
 
 
 #include "modules/audio/libs/pitch/PitchDetector.h"
+#include "modules/audio/libs/pitch/FFTCorrelation.h"
 #include "modules/audio/libs/pitch/PitchMPM.h"
 #include "modules/audio/libs/pitch/PitchYIN.h"
 
 #include "modules/audio/analysis/FFTAnalyzer.h"
 #include "modules/audio/analysis/FFTAnalyzerManager.h"
+#include "modules/audio/analysis/PitchAnalysisThread.h"
+#include "modules/audio/ltc/LTCGenerator.h"
 
 #include "modules/audio/AudioModule.h"
 
@@ -100,6 +103,7 @@
 #include "modules/customvariables/CustomVariablesModule.h"
 #include "modules/customvariables/commands/CustomVariablesModuleCommands.h"
 
+#include "modules/dmx/DMXUniverseBuffer.h"
 #include "modules/dmx/DMXModule.h"
 #include "modules/dmx/commands/DMXCommand.h"
 #include "modules/dmx/ui/DMXModuleUI.h"
@@ -129,8 +133,10 @@
 #include "modules/multiplex/MultiplexModule.h"
 #include "modules/multiplex/commands/MultiplexCommands.h"
 
+#include "modules/osc/OSCReceivePipeline.h"
 #include "modules/osc/OSCModule.h"
 
+#include "modules/osc/custom/OSCAddressIndex.h"
 #include "modules/osc/custom/CustomOSCModule.h"
 #include "modules/osc/dlight/DLightModule.h"
 
@@ -12,6 +12,7 @@
 #include "MainIncludes.h"
 
 #include "modules/dmx/DMXModule.cpp"
+#include "modules/dmx/DMXUniverseBuffer.cpp"
 #include "modules/dmx/commands/DMXCommand.cpp"
 #include "modules/dmx/ui/DMXModuleUI.cpp"
 #include "modules/generators/metronome/MetronomeModule.cpp"
@@ -36,7 +37,9 @@
 #include "modules/midi/commands/MIDICommands.cpp"
 #include "modules/multiplex/MultiplexModule.cpp"
 #include "modules/multiplex/commands/MultiplexCommands.cpp"
+#include "modules/osc/OSCReceivePipeline.cpp"
 #include "modules/osc/OSCModule.cpp"
+#include "modules/osc/custom/OSCAddressIndex.cpp"
 #include "modules/osc/custom/CustomOSCModule.cpp"
 #include "modules/osc/dlight/DLightModule.cpp"
 #include "modules/osc/heavym/HeavyMModule.cpp"
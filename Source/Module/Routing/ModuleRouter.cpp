@@ -15,18 +15,29 @@ ModuleRouter::ModuleRouter() :
 	sourceModule(nullptr),
 	destModule(nullptr),
 	sourceValues("Source Values"),
-	routerController(nullptr)
+	routerController(nullptr),
+	firstDirtyTime(0)
 {
 	sourceValues.userCanAddItemsManually = false;
 	selectAllValues = addTrigger("Select All", "Select all values for routing");
 	deselectAllValues = addTrigger("Deselect All", "Deselect all values");
 	routeAllValues = addTrigger("Route All", "Immediately trigger all enabled routes");
 
+	batchRoutes = addBoolParameter("Batch Routes", "If checked, changed values are not sent right away but collected and sent together at the batch rate, as OSC bundles, grouped DMX writes or MIDI blocks depending on the destination. Triggers are always sent right away.", false);
+	batchRate = addIntParameter("Batch Rate", "Number of batches sent per second", 50, 1, 1000, false);
+	batchSize = addIntParameter("Batch Size", "Number of values sent in the last batch", 0, 0, INT32_MAX, false);
+	batchSize->setControllableFeedbackOnly(true);
+	batchSize->isSavable = false;
+	batchLatency = addFloatParameter("Batch Latency", "Time in ms between the first change of the last batch and its sending", 0, 0);
+	batchLatency->setControllableFeedbackOnly(true);
+	batchLatency->isSavable = false;
+
 	addChildControllableContainer(&sourceValues);
 }
 
 ModuleRouter::~ModuleRouter()
 {
+	stopTimer();
 	setSourceModule(nullptr);
 	setDestModule(nullptr);
 }
@@ -59,13 +70,7 @@ void ModuleRouter::setSourceModule(Module * m)
 
 		Array<WeakReference<Controllable>> values = sourceModule->valuesCC.getAllControllables(true);
 		int index = 0;
-		for (auto &c : values)
-		{
-			ModuleRouterValue * mrv = new ModuleRouterValue(c, index++);
-			sourceValues.addItem(mrv, var(), false);
-			mrv->forceDisabled = !enabled->boolValue();
-			mrv->setSourceAndOutModule(sourceModule, destModule);
-		}
+		for (auto &c : values) createRouterValue(c, index++);
 	}
 
 	routerListeners.call(&RouterListener::sourceModuleChanged, this);
@@ -116,10 +121,7 @@ void ModuleRouter::reloadSourceValues(bool keepData)
 	for (auto& c : values)
 	{
 		if (c == nullptr || c.wasObjectDeleted()) continue;
-		ModuleRouterValue* mrv = new ModuleRouterValue(c, index++);
-		sourceValues.addItem(mrv, var(), false);
-		mrv->forceDisabled = !enabled->boolValue();
-		mrv->setSourceAndOutModule(sourceModule, destModule);
+		createRouterValue(c, index++);
 	}
 
 	if (keepData) sourceValues.loadItemsData(prevData);
@@ -173,12 +175,92 @@ ModuleRouterValue * ModuleRouter::getRouterValueForControllable(Controllable * c
 	return nullptr;
 }
 
+ModuleRouterValue * ModuleRouter::createRouterValue(Controllable * c, int index)
+{
+	ModuleRouterValue * mrv = new ModuleRouterValue(c, index);
+	mrv->router = this;
+	sourceValues.addItem(mrv, var(), false);
+	mrv->forceDisabled = !enabled->boolValue();
+	mrv->setSourceAndOutModule(sourceModule, destModule);
+	return mrv;
+}
+
+void ModuleRouter::valueChanged(ModuleRouterValue * v)
+{
+	const SpinLock::ScopedLockType sl(dirtyLock);
+	if (v->isQueued) return; //already in this batch, the latest value will be sent
+
+	if (dirtyValues.isEmpty()) firstDirtyTime = Time::getMillisecondCounterHiRes();
+	v->isQueued = true;
+	dirtyValues.add(v);
+}
+
+void ModuleRouter::valueRemoved(ModuleRouterValue * v)
+{
+	const SpinLock::ScopedLockType sl(dirtyLock);
+	dirtyValues.removeFirstMatchingValue(v);
+}
+
+void ModuleRouter::updateBatchTimer()
+{
+	if (batchRoutes->boolValue() && enabled->boolValue()) startTimer(jmax(1, 1000 / batchRate->intValue()));
+	else
+	{
+		stopTimer();
+		flushBatch(); //don't leave pending values behind
+	}
+}
+
+void ModuleRouter::flushBatch()
+{
+	double batchStartTime = 0;
+	{
+		const SpinLock::ScopedLockType sl(dirtyLock);
+		if (dirtyValues.isEmpty()) return;
+
+		valuesToFlush.swapWith(dirtyValues);
+		for (auto& v : valuesToFlush) v->isQueued = false;
+		batchStartTime = firstDirtyTime;
+	}
+
+	sendBatch(valuesToFlush);
+	valuesToFlush.clearQuick();
+
+	batchLatency->setValue(Time::getMillisecondCounterHiRes() - batchStartTime);
+}
+
+void ModuleRouter::sendBatch(const Array<ModuleRouterValue*>& values)
+{
+	if (destModule == nullptr || destModuleRef.wasObjectDeleted()) return;
+
+	batchValues.clearQuick();
+	batchParams.clearQuick();
+	for (auto& v : values)
+	{
+		if (!v->enabled->boolValue() || v->forceDisabled || v->outModule == nullptr) continue;
+		if (v->sourceValue == nullptr || v->sourceValue.wasObjectDeleted()) continue;
+
+		batchValues.add(v->sourceValue);
+		batchParams.add(v->routeParams.get());
+	}
+
+	if (!batchValues.isEmpty()) destModule->handleRoutedModuleValues(batchValues, batchParams);
+	batchSize->setValue(batchValues.size());
+}
+
+void ModuleRouter::timerCallback()
+{
+	flushBatch();
+}
+
 void ModuleRouter::onContainerParameterChangedInternal(Parameter * p)
 {
 	if (p == enabled)
 	{
 		for (auto &mrv : sourceValues.items) mrv->forceDisabled = !enabled->boolValue();
 	}
+
+	if (p == enabled || p == batchRoutes || p == batchRate) updateBatchTimer();
 }
 
 void ModuleRouter::onContainerTriggerTriggered(Trigger * t)
@@ -192,6 +274,14 @@ void ModuleRouter::onContainerTriggerTriggered(Trigger * t)
 	}
 	else if (t == routeAllValues)
 	{
+		if (isBatching())
+		{
+			Array<ModuleRouterValue*> allValues;
+			allValues.addArray(sourceValues.items);
+			sendBatch(allValues);
+			return;
+		}
+
 		for (auto& v : sourceValues.items)
 		{
 			if (v->enabled->value && v->outModule != nullptr)
@@ -15,7 +15,8 @@ class ModuleRouterController;
 class ModuleRouter :
 	public BaseItem,
 	public Inspectable::InspectableListener,
-	public ContainerAsyncListener
+	public ContainerAsyncListener,
+	public Timer
 {
 public:
 	ModuleRouter();
@@ -34,6 +35,21 @@ public:
 	Trigger * deselectAllValues;
 	Trigger * routeAllValues;
 
+	//Batching : changed values are collected and sent together to the dest module at the batch rate
+	BoolParameter* batchRoutes;
+	IntParameter* batchRate;
+	IntParameter* batchSize;
+	FloatParameter* batchLatency; //ms between the first change of a batch and its sending
+
+	SpinLock dirtyLock; //values can change from any thread
+	Array<ModuleRouterValue*> dirtyValues;
+	double firstDirtyTime;
+
+	//Reused on each flush
+	Array<ModuleRouterValue*> valuesToFlush;
+	Array<Controllable*> batchValues;
+	Array<Module::RouteParams*> batchParams;
+
 	void setSourceModule(Module * m);
 	void setDestModule(Module * m);
 
@@ -45,6 +61,16 @@ public:
 	void newMessage(const ContainerAsyncEvent &e) override;
 
 	ModuleRouterValue * getRouterValueForControllable(Controllable * c);
+	ModuleRouterValue * createRouterValue(Controllable * c, int index);
+
+	bool isBatching() const { return batchRoutes->boolValue(); }
+	void valueChanged(ModuleRouterValue * v);
+	void valueRemoved(ModuleRouterValue * v);
+	void updateBatchTimer();
+	void flushBatch();
+	void sendBatch(const Array<ModuleRouterValue*>& values);
+
+	void timerCallback() override;
 
 	void onContainerParameterChangedInternal(Parameter * p) override;
 	void onContainerTriggerTriggered(Trigger * t) override;
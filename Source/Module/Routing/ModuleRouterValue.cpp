@@ -13,7 +13,9 @@ ModuleRouterValue::ModuleRouterValue(Controllable * _sourceValue, int _index) :
 	valueIndex(_index),
 	sourceValue(_sourceValue),
 	outModule(nullptr),
-	forceDisabled(false)
+	forceDisabled(false),
+	router(nullptr),
+	isQueued(false)
 {
 	jassert(sourceValue != nullptr);
 
@@ -35,6 +37,8 @@ ModuleRouterValue::ModuleRouterValue(Controllable * _sourceValue, int _index) :
 
 ModuleRouterValue::~ModuleRouterValue()
 {
+	if (router != nullptr) router->valueRemoved(this);
+
 	if (sourceValue == nullptr || sourceValue.wasObjectDeleted()) return;
 
 	if (sourceValue->type == Controllable::TRIGGER) ((Trigger *)sourceValue.get())->removeTriggerListener(this);
@@ -120,7 +124,10 @@ void ModuleRouterValue::onExternalParameterValueChanged(Parameter * p)
 {
 	if (outModule == nullptr) return;
 	if (!enabled->boolValue() || forceDisabled) return;
-	if(p == sourceValue) outModule->handleRoutedModuleValue(sourceValue, routeParams.get());
+	if (p != sourceValue) return;
+
+	if (router != nullptr && router->isBatching()) router->valueChanged(this);
+	else outModule->handleRoutedModuleValue(sourceValue, routeParams.get());
 }
 
 void ModuleRouterValue::onExternalTriggerTriggered(Trigger * t)
@@ -10,6 +10,8 @@
 
 #pragma once
 
+class ModuleRouter;
+
 class ModuleRouterValue :
 	public BaseItem
 {
@@ -26,6 +28,9 @@ public:
 
 	bool forceDisabled; //for router enable
 
+	ModuleRouter* router;
+	bool isQueued; //waiting in the router batch, guarded by the router's lock
+
 	std::unique_ptr<Module::RouteParams> routeParams;
 
 	void setSourceAndOutModule(Module * sourceModule, Module * outModule);
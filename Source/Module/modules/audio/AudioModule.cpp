@@ -9,6 +9,7 @@
 */
 
 #include "Module/ModuleIncludes.h"
+#include "TimeMachine/ChataigneSequenceManager.h"
 
 AudioModule::AudioModule(const String& name) :
 	Module(name),
@@ -23,8 +24,10 @@ AudioModule::AudioModule(const String& name) :
 	fftCC("FFT Enveloppes"),
 	ltcParamsCC("LTC"),
 	ltcCC("LTC"),
-	ltcFrameDropCount(0),
-	pitchDetector(nullptr)
+	ltcOutCC("LTC Output"),
+	activeLTCFeed(-1),
+	ltcOutSequence(nullptr),
+	pitchAnalysis(this)
 {
 	setupIOConfiguration(true, true);
 
@@ -33,8 +36,13 @@ AudioModule::AudioModule(const String& name) :
 	keepLastDetectedValues = moduleParams.addBoolParameter("Keep Values", "Keep last detected values when no activity detected.", false);
 
 	outVolume = moduleParams.addFloatParameter("Out Volume", "Global volume multiplier for all sound that is played through this module", 1, 0, 10);
+	analysisRate = moduleParams.addIntParameter("Analysis Rate", "Rate (in Hz) at which analysis results are updated. Values detected in between are merged, only the last one is kept", 50, 1, 500);
 	pitchDetectionMethod = moduleParams.addEnumParameter("Pitch Detection Method", "Choose how to detect the pitch.\nNone will disable the detection (for performance),\nMPM is better suited for monophonic sounds,\nYIN is better suited for high-pitched voices and music");
 	pitchDetectionMethod->addOption("None", NONE)->addOption("MPM", MPM)->addOption("YIN", YIN);
+	pitchWindowSize = moduleParams.addEnumParameter("Pitch Window Size", "Number of samples analyzed for each pitch detection.\nBigger windows detect lower pitches but react slower");
+	pitchWindowSize->addOption("512", 512)->addOption("1024", 1024)->addOption("2048", 2048)->addOption("4096", 4096);
+	pitchWindowSize->setDefaultValue(1024);
+	pitchOverlap = moduleParams.addFloatParameter("Pitch Overlap", "How much consecutive analysis windows overlap. The detection runs every window size * (1 - overlap) samples", .5f, 0, .9f);
 
 
 
@@ -61,10 +69,19 @@ AudioModule::AudioModule(const String& name) :
 	curLTCFPS = ltcFPS->getValueData();
 
 	ltcChannel = ltcParamsCC.addIntParameter("LTC Channel", "Enable and select the channel you want to use to decode LTC", 1, 1, 64);
+	for (int i = 1; i < maxLTCFeeds; i++)
+	{
+		IntParameter* p = ltcParamsCC.addIntParameter("Backup Channel " + String(i), "If enabled, LTC is also decoded from this channel and used when the previous channels stop sending", 1 + i, 1, 64);
+		p->canBeDisabledByUser = true;
+		p->enabled = false;
+		ltcBackupChannels.add(p);
+	}
 	ltcUseDate = ltcParamsCC.addBoolParameter("Use LTC Date", "Does the sending device use the date in the LTC user bits? (Almost always false)", false);
 
 	//Values
 	detectedVolume = valuesCC.addFloatParameter("Volume", "Volume of the audio input", 0, 0, 1);
+	droppedBlocks = valuesCC.addIntParameter("Dropped Blocks", "Number of audio blocks the pitch analysis could not keep up with", 0, 0);
+	callbackOverruns = valuesCC.addIntParameter("Callback Overruns", "Number of audio callbacks that took longer than the duration of their buffer", 0, 0);
 
 	//Pitch Detection
 	frequency = noteCC.addFloatParameter("Freq", "Freq", 0, 0, 2000);
@@ -86,6 +103,21 @@ AudioModule::AudioModule(const String& name) :
 	ltcPlaying = ltcCC.addBoolParameter("Is LTC Playing", "Is LTC currently detected in audio input ?", false);
 	ltcTime = ltcCC.addFloatParameter("LTC Time", "Decoded LTC Time from the selected channel in parameters", 0, 0);
 	ltcTime->defaultUI = FloatParameter::TIME;
+	ltcActiveFeed = ltcCC.addIntParameter("Active Feed", "The LTC feed currently decoded, 1 being the main channel and the next ones the backup channels. 0 if none", 0, 0, maxLTCFeeds);
+	ltcActiveFeed->setControllableFeedbackOnly(true);
+
+	//LTC Output
+	ltcOutCC.enabled->setValue(false);
+	moduleParams.addChildControllableContainer(&ltcOutCC);
+	ltcOutSequenceTarget = ltcOutCC.addTargetParameter("Sequence", "The sequence to generate LTC from", ChataigneSequenceManager::getInstance(), false);
+	ltcOutSequenceTarget->targetType = TargetParameter::CONTAINER;
+	ltcOutSequenceTarget->maxDefaultSearchLevel = 0;
+	ltcOutSequenceTarget->defaultContainerTypeCheckFunc = [](ControllableContainer* cc) { return dynamic_cast<Sequence*>(cc) != nullptr; };
+	ltcOutChannel = ltcOutCC.addIntParameter("Output Channel", "The output channel to send the generated LTC to", 1, 1, 64);
+	ltcOutFPS = ltcOutCC.addEnumParameter("FPS", "The framerate of the generated LTC");
+	ltcOutFPS->addOption("24", 24)->addOption("25", 25)->addOption("30", 30);
+	ltcOutFPS->setDefaultValue(30);
+	ltcOutVolume = ltcOutCC.addFloatParameter("Volume", "Level of the generated LTC, in dBFS", -18, -60, 0);
 
 
 	addChildControllableContainer(&hs);
@@ -95,13 +127,19 @@ AudioModule::AudioModule(const String& name) :
 
 	defManager->add(CommandDefinition::createDef(this, "", "Play audio file", &PlayAudioFileCommand::create));
 
-	ltcDecoder.reset(ltc_decoder_create(1920, 32));
+	for (int i = 0; i < maxLTCFeeds; i++) ltcFeeds.add(new LTCFeed());
 
 	initSetup();
+
+	startTimer(1000 / analysisRate->intValue());
 }
 
 AudioModule::~AudioModule()
 {
+	stopTimer();
+	pitchAnalysis.stopThread(1000);
+	setLTCOutSequence(nullptr);
+
 	graph.clear();
 
 	am.removeAudioCallback(&player);
@@ -203,6 +241,8 @@ void AudioModule::updateAudioSetup()
 	int numInputChannels = graph.getMainBusNumInputChannels();
 	int numOutputChannels = graph.getMainBusNumOutputChannels();
 
+	analyzerManager.setNumChannels(numInputChannels);
+
 	graph.disconnectNode(AUDIO_INPUTMIXER_GRAPH_ID);
 	inputMixer->setPlayConfigDetails(graph.getMainBusNumInputChannels(), graph.getMainBusNumInputChannels(), currentSampleRate, currentBufferSize);
 
@@ -238,6 +278,9 @@ void AudioModule::updateAudioSetup()
 	if (setup.outputDeviceName.isEmpty()) setWarningMessage("Module is not connected to an audio output");
 	else clearWarning();
 
+	updatePitchDetection();
+	updateLTCGenerator();
+
 	am.addAudioCallback(&player);
 	am.addAudioCallback(this);
 
@@ -258,6 +301,41 @@ void AudioModule::updateSelectedMonitorChannels()
 	numActiveMonitorOutputs = selectedMonitorOutChannels.size();
 }
 
+void AudioModule::updatePitchDetection()
+{
+	pitchAnalysis.setup(pitchDetectionMethod->getValueDataAsEnum<PitchDetectionMethod>(), currentSampleRate, (int)pitchWindowSize->getValueData(), pitchOverlap->floatValue());
+}
+
+void AudioModule::pitchDetected(float freq)
+{
+	//Called from the pitch thread, published with the other analysis values
+	if (freq <= 0 && keepLastDetectedValues->boolValue()) return;
+
+	analysisSlots.pitchFrequency = jmax(freq, 0.f);
+	analysisSlots.pitchChanged = true;
+}
+
+void AudioModule::publishPitch()
+{
+	if (!analysisSlots.pitchChanged.exchange(false)) return;
+
+	const float freq = analysisSlots.pitchFrequency.load();
+	if (freq <= 0)
+	{
+		frequency->setValue(0);
+		pitch->setValue(0);
+		note->setValueWithKey("-");
+		return;
+	}
+
+	frequency->setValue(freq);
+	int pitchNote = getNoteForFrequency(freq);
+	pitch->setValue(pitchNote);
+
+	note->setValueWithKey(MIDIManager::getNoteName(pitchNote, false));
+	octave->setValue(floor(pitchNote / 12.0));
+}
+
 void AudioModule::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
 {
 	Module::onControllableFeedbackUpdateInternal(cc, c);
@@ -266,21 +344,9 @@ void AudioModule::onControllableFeedbackUpdateInternal(ControllableContainer* cc
 	{
 		updateSelectedMonitorChannels();
 	}
-	else if (c == pitchDetectionMethod)
+	else if (c == pitchDetectionMethod || c == pitchWindowSize || c == pitchOverlap)
 	{
-		PitchDetectionMethod pdm = pitchDetectionMethod->getValueDataAsEnum<PitchDetectionMethod>();
-
-		AudioDeviceManager::AudioDeviceSetup s;
-		am.getAudioDeviceSetup(s);
-
-
-		switch (pdm)
-		{
-		case NONE: pitchDetector.reset(nullptr); break;
-		case MPM: pitchDetector.reset(new PitchMPM((int)s.sampleRate, s.bufferSize));  break;
-		case YIN: pitchDetector.reset(new PitchYIN((int)s.sampleRate, s.bufferSize)); break;
-		}
-
+		updatePitchDetection();
 	}
 	else if (c == ltcFPS)
 	{
@@ -288,7 +354,28 @@ void AudioModule::onControllableFeedbackUpdateInternal(ControllableContainer* cc
 	}
 	else if (c == ltcParamsCC.enabled)
 	{
-		if (!ltcParamsCC.enabled->boolValue()) ltcPlaying->setValue(false);
+		if (!ltcParamsCC.enabled->boolValue())
+		{
+			analysisSlots.ltcPlaying = false;
+			analysisSlots.ltcActiveFeed = 0;
+			ltcPlaying->setValue(false);
+		}
+	}
+	else if (c == ltcOutSequenceTarget)
+	{
+		setLTCOutSequence(dynamic_cast<Sequence*>(ltcOutSequenceTarget->targetContainer.get()));
+	}
+	else if (c == ltcOutFPS || c == ltcOutVolume)
+	{
+		updateLTCGenerator();
+	}
+	else if (c == ltcOutCC.enabled)
+	{
+		updateLTCGeneratorState();
+	}
+	else if (c == analysisRate)
+	{
+		startTimer(1000 / analysisRate->intValue());
 	}
 }
 
@@ -358,6 +445,8 @@ void AudioModule::audioDeviceIOCallbackWithContext(const float* const* inputChan
 
 	if (!enabled->boolValue()) return;
 
+	const double callbackStartTime = Time::getMillisecondCounterHiRes();
+
 	for (int i = 0; i < numInputChannels; ++i)
 	{
 		float channelVolume = i < inputVolumes.size() && inputVolumes[i] != nullptr ? inputVolumes[i]->floatValue() : 1;
@@ -366,37 +455,12 @@ void AudioModule::audioDeviceIOCallbackWithContext(const float* const* inputChan
 		{
 			if (buffer.getNumSamples() != numSamples) buffer.setSize(1, numSamples);
 			buffer.copyFromWithRamp(0, 0, inputChannelData[0], numSamples, 1, inputGain->floatValue() * channelVolume);
-			detectedVolume->setValue(buffer.getRMSLevel(0, 0, numSamples));
+			float volume = buffer.getRMSLevel(0, 0, numSamples);
+			analysisSlots.volume = volume;
 
-			if (detectedVolume->floatValue() > activityThreshold->floatValue())
-			{
-				inActivityTrigger->trigger();
-
-				if (pitchDetector != nullptr)
-				{
-					if ((int)pitchDetector->getBufferSize() != numSamples) pitchDetector->setBufferSize(numSamples);
-
-					if (inputChannelData[0][0] >= 0)
-					{
-						float freq = pitchDetector->getPitch(inputChannelData[0]);
-						frequency->setValue(freq);
-						int pitchNote = getNoteForFrequency(freq);
-						pitch->setValue(pitchNote);
-
-						note->setValueWithKey(MIDIManager::getNoteName(pitchNote, false));
-						octave->setValue(floor(pitchNote / 12.0));
-					}
-				}
-			}
-			else
-			{
-				if (!keepLastDetectedValues->boolValue())
-				{
-					frequency->setValue(0);
-					pitch->setValue(0);
-					note->setValueWithKey("-");
-				}
-			}
+			if (volume > activityThreshold->floatValue()) analysisSlots.numActiveBlocks++;
+
+			pitchAnalysis.pushSamples(buffer.getReadPointer(0), numSamples); //detection runs on the pitch analysis thread
 		}
 
 
@@ -416,43 +480,152 @@ void AudioModule::audioDeviceIOCallbackWithContext(const float* const* inputChan
 	//Analysis
 	if (numInputChannels > 0)
 	{
-		analyzerManager.process(inputChannelData[0], numSamples);
+		analyzerManager.process(inputChannelData, numInputChannels, numSamples);
+
+		if (ltcParamsCC.enabled->boolValue()) processLTCInput(inputChannelData, numInputChannels, numSamples);
+	}
+
+	if (ltcOutCC.enabled->boolValue())
+	{
+		int channel = ltcOutChannel->intValue() - 1;
+		if (channel >= 0 && channel < numOutputChannels) ltcGenerator.render(outputChannelData[channel], numSamples);
+	}
+
+	if (currentSampleRate > 0 && Time::getMillisecondCounterHiRes() - callbackStartTime > numSamples * 1000.0 / currentSampleRate) analysisSlots.callbackOverruns++;
+}
+
+void AudioModule::hiResTimerCallback()
+{
+	//Only the last value written since the previous update is published
+	detectedVolume->setValue(analysisSlots.volume.load());
+	if (analysisSlots.numActiveBlocks.exchange(0) > 0) inActivityTrigger->trigger();
 
-		if (ltcParamsCC.enabled->boolValue())
+	if (analysisSlots.ltcTimeChanged.exchange(false)) ltcTime->setValue(analysisSlots.ltcTime.load());
+	if (ltcPlaying->boolValue() != analysisSlots.ltcPlaying.load()) ltcPlaying->setValue(analysisSlots.ltcPlaying.load());
+	ltcActiveFeed->setValue(analysisSlots.ltcActiveFeed.load());
+
+	publishPitch();
+	analyzerManager.publishValues();
+
+	droppedBlocks->setValue(pitchAnalysis.droppedBlocks.load());
+	callbackOverruns->setValue(analysisSlots.callbackOverruns.load());
+}
+
+void AudioModule::processLTCInput(const float* const* inputChannelData, int numInputChannels, int numSamples)
+{
+	for (int i = 0; i < maxLTCFeeds; i++)
+	{
+		LTCFeed* feed = ltcFeeds.getUnchecked(i);
+		IntParameter* channelParam = i == 0 ? ltcChannel : ltcBackupChannels[i - 1];
+		int channel = channelParam->intValue() - 1;
+		if (!channelParam->enabled || channel < 0 || channel >= numInputChannels)
 		{
-			int channel = ltcChannel->intValue() - 1;
-			if (channel >= 0 && channel < numInputChannels)
-			{
-				ltc_decoder_write_float(ltcDecoder.get(), (float*)inputChannelData[channel], numSamples, 0);
-
-				bool hasLTC = false;
-				LTCFrameExt frame;
-				while (ltc_decoder_read(ltcDecoder.get(), &frame))
-				{
-					SMPTETimecode stime;
-					ltc_frame_to_time(&stime, &frame.ltc, (ltcUseDate->boolValue() ? 1 : 0));
-
-					float time = stime.days * 3600 * 24 + stime.hours * 3600 + stime.mins * 60 + stime.secs + stime.frame * 1.0f / curLTCFPS;
-					ltcTime->setValue(time);
-					hasLTC = true;
-				}
-
-				if (!hasLTC)
-				{
-					if (ltcPlaying->boolValue())
-					{
-						ltcFrameDropCount++;
-						if (ltcFrameDropCount >= 10) ltcPlaying->setValue(hasLTC);
-					}
-				}
-				else
-				{
-					ltcFrameDropCount = 0;
-					ltcPlaying->setValue(true);
-				}
-			}
+			feed->reset();
+			continue;
+		}
+
+		ltc_decoder_write_float(feed->decoder, (float*)inputChannelData[channel], numSamples, 0);
+
+		//Only the last frame of the block is converted, the previous ones would be overwritten anyway
+		bool hasFrame = false;
+		LTCFrameExt frame;
+		while (ltc_decoder_read(feed->decoder, &frame)) hasFrame = true;
+
+		if (hasFrame)
+		{
+			SMPTETimecode stime;
+			ltc_frame_to_time(&stime, &frame.ltc, (ltcUseDate->boolValue() ? 1 : 0));
+
+			feed->lastTime = stime.days * 3600 * 24 + stime.hours * 3600 + stime.mins * 60 + stime.secs + stime.frame * 1.0f / curLTCFPS;
+			feed->hasNewTime = true;
+			feed->frameDropCount = 0;
+			if (feed->numGoodFrames < 1000) feed->numGoodFrames++;
+		}
+		else if (feed->numGoodFrames > 0)
+		{
+			feed->frameDropCount++;
+			if (feed->frameDropCount >= 10) feed->numGoodFrames = 0;
+		}
+	}
+
+	//Failover : the active feed is kept while it's alive, a higher priority feed takes back once it has decoded a few frames in a row
+	int newActiveFeed = -1;
+	for (int i = 0; i < maxLTCFeeds; i++)
+	{
+		LTCFeed* feed = ltcFeeds.getUnchecked(i);
+		if (!feed->isAlive()) continue;
+		if (i == activeLTCFeed || activeLTCFeed < 0 || i > activeLTCFeed || feed->numGoodFrames >= 3)
+		{
+			newActiveFeed = i;
+			break;
+		}
+	}
+
+	activeLTCFeed = newActiveFeed;
+
+	if (activeLTCFeed >= 0)
+	{
+		LTCFeed* feed = ltcFeeds.getUnchecked(activeLTCFeed);
+		if (feed->hasNewTime)
+		{
+			analysisSlots.ltcTime = feed->lastTime;
+			analysisSlots.ltcTimeChanged = true;
 		}
 	}
+
+	for (auto& f : ltcFeeds) f->hasNewTime = false;
+
+	analysisSlots.ltcPlaying = activeLTCFeed >= 0;
+	analysisSlots.ltcActiveFeed = activeLTCFeed + 1;
+}
+
+void AudioModule::setLTCOutSequence(Sequence* s)
+{
+	if (ltcOutSequence == s) return;
+
+	if (ltcOutSequence != nullptr && !ltcOutSequenceRef.wasObjectDeleted())
+	{
+		ltcOutSequence->currentTime->removeParameterListener(this);
+		ltcOutSequence->isPlaying->removeParameterListener(this);
+		ltcOutSequence->playSpeed->removeParameterListener(this);
+	}
+
+	ltcOutSequence = s;
+	ltcOutSequenceRef = s;
+
+	if (ltcOutSequence != nullptr)
+	{
+		ltcOutSequence->currentTime->addParameterListener(this);
+		ltcOutSequence->isPlaying->addParameterListener(this);
+		ltcOutSequence->playSpeed->addParameterListener(this);
+	}
+
+	updateLTCGeneratorState();
+}
+
+void AudioModule::updateLTCGenerator()
+{
+	ltcGenerator.setup(currentSampleRate, (int)ltcOutFPS->getValueData(), ltcOutVolume->floatValue());
+}
+
+void AudioModule::updateLTCGeneratorState()
+{
+	bool isPlaying = ltcOutCC.enabled->boolValue() && ltcOutSequence != nullptr && !ltcOutSequenceRef.wasObjectDeleted() && ltcOutSequence->isPlaying->boolValue();
+	if (!isPlaying)
+	{
+		ltcGenerator.setSequenceState(false, 0, 1);
+		return;
+	}
+
+	ltcGenerator.setSequenceState(true, ltcOutSequence->currentTime->floatValue(), ltcOutSequence->playSpeed->floatValue());
+}
+
+void AudioModule::onExternalParameterValueChanged(Parameter* p)
+{
+	if (ltcOutSequence != nullptr && (p == ltcOutSequence->currentTime || p == ltcOutSequence->isPlaying || p == ltcOutSequence->playSpeed))
+	{
+		updateLTCGeneratorState();
+	}
 }
 
 void AudioModule::audioDeviceAboutToStart(AudioIODevice*)
@@ -511,6 +684,29 @@ InspectableEditor* AudioModuleHardwareSettings::getEditorInternal(bool isRoot, A
 // MIXER
 
 
+AudioModule::LTCFeed::LTCFeed() :
+	decoder(ltc_decoder_create(1920, 32)),
+	frameDropCount(0),
+	numGoodFrames(0),
+	lastTime(0),
+	hasNewTime(false)
+{
+}
+
+AudioModule::LTCFeed::~LTCFeed()
+{
+	ltc_decoder_free(decoder);
+}
+
+void AudioModule::LTCFeed::reset()
+{
+	frameDropCount = 0;
+	numGoodFrames = 0;
+	hasNewTime = false;
+}
+
+
+
 MixerProcessor::MixerProcessor(AudioModule* m, bool isInput) :
 	AudioProcessor(),
 	audioModule(m),
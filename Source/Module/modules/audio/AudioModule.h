@@ -62,6 +62,7 @@ class AudioModule :
 	public Module,
 	public AudioIODeviceCallback,
 	public ChangeListener,
+	public HighResolutionTimer,
 	public FFTAnalyzerManager::ManagerListener
 {
 public:
@@ -91,6 +92,7 @@ public:
 	FloatParameter* inputGain;
 	FloatParameter* activityThreshold;
 	FloatParameter* outVolume;
+	IntParameter* analysisRate;
 
 	ControllableContainer inputVolumesCC;
 	Array<FloatParameter*> inputVolumes;
@@ -105,9 +107,13 @@ public:
 
 	enum PitchDetectionMethod { NONE, MPM, YIN };
 	EnumParameter* pitchDetectionMethod;
+	EnumParameter* pitchWindowSize;
+	FloatParameter* pitchOverlap;
 
 	//Values
 	FloatParameter* detectedVolume;
+	IntParameter* droppedBlocks;
+	IntParameter* callbackOverruns;
 
 	ControllableContainer noteCC;
 	FloatParameter* frequency;
@@ -121,25 +127,81 @@ public:
 	EnumParameter* ltcFPS;
 	int curLTCFPS; //avoid accessing enum in audio thread
 	IntParameter* ltcChannel;
+	Array<IntParameter*> ltcBackupChannels;
 	BoolParameter* ltcUseDate;
 
 	ControllableContainer ltcCC;
 	BoolParameter* ltcPlaying;
 	FloatParameter* ltcTime;
-	int ltcFrameDropCount;
+	IntParameter* ltcActiveFeed;
+
+	EnablingControllableContainer ltcOutCC;
+	TargetParameter* ltcOutSequenceTarget;
+	IntParameter* ltcOutChannel;
+	EnumParameter* ltcOutFPS;
+	FloatParameter* ltcOutVolume;
 
 	FFTAnalyzerManager analyzerManager;
 
-	std::unique_ptr<PitchDetector> pitchDetector;
-	std::unique_ptr<LTCDecoder> ltcDecoder;
+	//One decoder per LTC channel, the first feed that decodes is used and the others take over when it drops
+	static const int maxLTCFeeds = 4;
+	struct LTCFeed
+	{
+		LTCFeed();
+		~LTCFeed();
+
+		LTCDecoder* decoder;
+		int frameDropCount;
+		int numGoodFrames;
+		float lastTime;
+		bool hasNewTime;
+
+		bool isAlive() const { return numGoodFrames > 0 && frameDropCount < 10; }
+		void reset();
+	};
+	OwnedArray<LTCFeed> ltcFeeds;
+	int activeLTCFeed; //audio thread
+
+	Sequence* ltcOutSequence;
+	WeakReference<Inspectable> ltcOutSequenceRef;
+	LTCGenerator ltcGenerator;
+
+	PitchAnalysisThread pitchAnalysis;
+
+	//Written on the audio thread, pushed to the parameters at the analysis rate so listeners never run in the callback
+	struct AnalysisSlots
+	{
+		std::atomic<float> volume{ 0 };
+		std::atomic<int> numActiveBlocks{ 0 };
+		std::atomic<float> ltcTime{ 0 };
+		std::atomic<bool> ltcTimeChanged{ false };
+		std::atomic<bool> ltcPlaying{ false };
+		std::atomic<int> ltcActiveFeed{ 0 };
+		std::atomic<int> callbackOverruns{ 0 };
+		std::atomic<float> pitchFrequency{ 0 }; //written by the pitch thread, 0 when no pitch is detected
+		std::atomic<bool> pitchChanged{ false };
+	};
+	AnalysisSlots analysisSlots;
 
 	void initSetup();
 
 	virtual void updateAudioSetup();
 	void updateSelectedMonitorChannels();
+	void updatePitchDetection();
+
+	void pitchDetected(float freq); //called from the pitch analysis thread, freq <= 0 if nothing was detected
+	void publishPitch();
+
+	void processLTCInput(const float* const* inputChannelData, int numInputChannels, int numSamples);
+	void setLTCOutSequence(Sequence* s);
+	void updateLTCGenerator();
+	void updateLTCGeneratorState();
+
+	void hiResTimerCallback() override;
 
 	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 	void onContainerParameterChangedInternal(Parameter* p) override;
+	void onExternalParameterValueChanged(Parameter* p) override;
 
 
 	var getJSONData() override;
@@ -9,8 +9,14 @@
 */
 
 FFTAnalyzer::FFTAnalyzer() :
-	BaseItem("Analyzer 1")
+	BaseItem("Analyzer 1"),
+	pendingValue(0),
+	hasPendingValue(false),
+	weightsDirty(true),
+	weightsNumSamples(0),
+	startBin(0)
 {
+	channel = addIntParameter("Channel", "The input channel to analyze", 1, 1, 64);
 	position = addFloatParameter("Position", "", .5f, 0, 1);
 	size = addFloatParameter("Size", "", .1f, 0, 1);
 
@@ -20,6 +26,8 @@ FFTAnalyzer::FFTAnalyzer() :
 	Random r;
 	setHasCustomColor(true);
 	itemColor->setDefaultValue(Colour::fromHSV(r.nextFloat(), 1, 1, 1));
+
+	weights.ensureStorageAllocated(256); //scope size, so rebuilding on the audio thread doesn't allocate
 }
 
 FFTAnalyzer::~FFTAnalyzer()
@@ -28,34 +36,73 @@ FFTAnalyzer::~FFTAnalyzer()
 }
 
 
-void FFTAnalyzer::process(float* fftSamples, int numSamples)
+void FFTAnalyzer::process(const float* fftSamples, int numSamples)
 {
 	if (!enabled->boolValue()) return;
 
-	float result = 0;
+	if (weightsDirty.exchange(false) || numSamples != weightsNumSamples) updateWeights(numSamples);
+
+	const int numBins = weights.size();
+	if (numBins == 0) return;
+
+	//Dot product over the covered bins only, split in 4 accumulators so it vectorizes
+	const float* samples = fftSamples + startBin;
+	const float* w = weights.getRawDataPointer();
+	float r0 = 0, r1 = 0, r2 = 0, r3 = 0;
+	int i = 0;
+	for (; i + 4 <= numBins; i += 4)
+	{
+		r0 += samples[i] * w[i];
+		r1 += samples[i + 1] * w[i + 1];
+		r2 += samples[i + 2] * w[i + 2];
+		r3 += samples[i + 3] * w[i + 3];
+	}
+	for (; i < numBins; i++) r0 += samples[i] * w[i];
+
+	pendingValue = r0 + r1 + r2 + r3;
+	hasPendingValue = true;
+}
+
+void FFTAnalyzer::publishValue()
+{
+	if (hasPendingValue.exchange(false)) value->setValue(pendingValue.load());
+}
+
+void FFTAnalyzer::updateWeights(int numSamples)
+{
+	weights.clearQuick();
+	weightsNumSamples = numSamples;
+	startBin = 0;
+
 	float targetPos = position->floatValue();
 	float maxDist = size->floatValue() / 2;
+	if (maxDist <= 0) return;
 
-	int numGoodSamples = 0;
 	float totalCoef = 0;
 	for (int i = 0; i < numSamples; ++i)
 	{
 		float pos = i * 1.0f / numSamples;
-		float dist = jmin<float>(fabsf(targetPos - pos) / maxDist, 1);
-		if (dist >= 1) continue;
-
-		numGoodSamples++;
+		float dist = fabsf(targetPos - pos) / maxDist;
+		if (dist >= 1)
+		{
+			if (weights.isEmpty()) continue;
+			break; //covered bins are contiguous
+		}
+
+		if (weights.isEmpty()) startBin = i;
 		float factor = cosf(dist * MathConstants<float>::pi / 2); //smooth
-
-		result += fftSamples[i] * factor;
+		weights.add(factor);
 		totalCoef += factor;
 	}
 
-	if (totalCoef > 0)
-	{
-		result /= totalCoef;
-		value->setValue(result);
-	}
+	if (totalCoef > 0) FloatVectorOperations::multiply(weights.getRawDataPointer(), 1 / totalCoef, weights.size());
+	else weights.clearQuick();
+}
+
+void FFTAnalyzer::onContainerParameterChangedInternal(Parameter* p)
+{
+	BaseItem::onContainerParameterChangedInternal(p);
+	if (p == position || p == size) weightsDirty = true;
 }
 
 void FFTAnalyzer::onContainerNiceNameChanged()
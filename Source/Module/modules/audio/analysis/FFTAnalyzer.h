@@ -18,13 +18,28 @@ public:
 	~FFTAnalyzer();
 	
 	
+	IntParameter* channel;
 	FloatParameter* position;
 	FloatParameter* size;
 	FloatParameter * value;
 
-	void process(float * fftSamples, int numSamples);
+	void process(const float * fftSamples, int numSamples); //audio thread, only stores the result
+	void publishValue();
 
+	void onContainerParameterChangedInternal(Parameter* p) override;
 	void onContainerNiceNameChanged() override;
 
 	InspectableEditor* getEditorInternal(bool isRoot, Array<Inspectable*> inspectables = Array<Inspectable*>()) override;
+
+private:
+	std::atomic<float> pendingValue;
+	std::atomic<bool> hasPendingValue;
+
+	//Normalized weights of the bins covered by position and size, rebuilt only when they change
+	std::atomic<bool> weightsDirty;
+	int weightsNumSamples;
+	int startBin;
+	Array<float> weights;
+
+	void updateWeights(int numSamples);
 };
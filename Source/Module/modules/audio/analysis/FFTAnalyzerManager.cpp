@@ -13,6 +13,8 @@ FFTAnalyzerManager::FFTAnalyzerManager() :
 	forwardFFT(fftOrder),
 	window(fftSize, dsp::WindowingFunction<float>::hann)
 {
+	setNumChannels(1);
+
 	setCanBeDisabled(true);
 	enabled->setValue(false);
 	editorIsCollapsed = true;
@@ -31,65 +33,113 @@ FFTAnalyzerManager::~FFTAnalyzerManager()
 {
 }
 
+FFTAnalyzerManager::ChannelAnalysis::ChannelAnalysis() :
+	fifoIndex(0)
+{
+	zeromem(fifo, sizeof(fifo));
+	zeromem(fftData, sizeof(fftData));
+	zeromem(scopeData, sizeof(scopeData));
+}
 
 
-void FFTAnalyzerManager::process(const float* samples, int numSamples)
+
+void FFTAnalyzerManager::setNumChannels(int numChannels)
 {
-	if (!enabled->boolValue()) return;
+	const ScopedLock lock(scopeDataMutex);
+	numChannels = jmax(1, numChannels);
+	while (channels.size() > numChannels) channels.removeLast();
+	while (channels.size() < numChannels) channels.add(new ChannelAnalysis());
+}
 
-	for (auto i = 0; i < numSamples; ++i) pushNextSampleIntoFifo(samples[i]);
-	window.multiplyWithWindowingTable(fftData, fftSize);      // [1]
+void FFTAnalyzerManager::process(const float* const* channelData, int numChannels, int numSamples)
+{
+	if (!enabled->boolValue()) return;
 
+	for (int c = 0; c < numChannels && c < channels.size(); c++)
+	{
+		if (!isChannelUsed(c)) continue;
+		pushSamplesIntoFifo(c, channelData[c], numSamples);
+	}
+}
 
-	if (nextFFTBlockReady)
+bool FFTAnalyzerManager::isChannelUsed(int channel) const
+{
+	if (channel == 0) return true; //first channel feeds the scope and getFFTData
+	for (auto& i : items)
 	{
-		forwardFFT.performFrequencyOnlyForwardTransform(fftData);
+		if (i->enabled->boolValue() && i->channel->intValue() - 1 == channel) return true;
+	}
+	return false;
+}
 
-		auto mindB = minDB->floatValue();
-		auto maxdB = jmax<float>(maxDB->floatValue(), mindB);
+void FFTAnalyzerManager::pushSamplesIntoFifo(int channel, const float* samples, int numSamples)
+{
+	ChannelAnalysis* ca = channels.getUnchecked(channel);
 
-		float tmpScopeData[scopeSize];
-		for (int i = 0; i < scopeSize; ++i)                        // [3]
-		{
-			auto skewedProportionX = 1.0f - std::exp(std::log(1.0f - i / (float)scopeSize) * 0.2f);
-			auto fftDataIndex = jlimit(0, fftSize / 2, (int)(skewedProportionX * fftSize / 2));
-			auto level = jmap(jlimit(mindB, maxdB, Decibels::gainToDecibels(fftData[fftDataIndex]) - Decibels::gainToDecibels((float)fftSize)), mindB, maxdB, 0.0f, 1.0f);
-			tmpScopeData[i] = level;                                  // [4]
-		}
+	while (numSamples > 0)
+	{
+		int numToCopy = jmin(numSamples, (int)fftSize - ca->fifoIndex);
+		memcpy(ca->fifo + ca->fifoIndex, samples, sizeof(float) * numToCopy);
+		ca->fifoIndex += numToCopy;
+		samples += numToCopy;
+		numSamples -= numToCopy;
 
-		for (auto& i : items)
+		if (ca->fifoIndex == fftSize)
 		{
-			i->process(tmpScopeData, scopeSize);
+			processFFTBlock(channel);
+			ca->fifoIndex = 0;
 		}
+	}
+}
 
-		{
-			const ScopedLock lock(scopeDataMutex);
-			memcpy(scopeData, tmpScopeData, sizeof(scopeData));
-		}
+void FFTAnalyzerManager::processFFTBlock(int channel)
+{
+	ChannelAnalysis* ca = channels.getUnchecked(channel);
+
+	zeromem(ca->fftData, sizeof(ca->fftData));
+	memcpy(ca->fftData, ca->fifo, sizeof(ca->fifo));
+	window.multiplyWithWindowingTable(ca->fftData, fftSize);      // [1]
+	forwardFFT.performFrequencyOnlyForwardTransform(ca->fftData);
+
+	auto mindB = minDB->floatValue();
+	auto maxdB = jmax<float>(maxDB->floatValue(), mindB);
+
+	float tmpScopeData[scopeSize];
+	for (int i = 0; i < scopeSize; ++i)                        // [3]
+	{
+		auto skewedProportionX = 1.0f - std::exp(std::log(1.0f - i / (float)scopeSize) * 0.2f);
+		auto fftDataIndex = jlimit(0, fftSize / 2, (int)(skewedProportionX * fftSize / 2));
+		auto level = jmap(jlimit(mindB, maxdB, Decibels::gainToDecibels(ca->fftData[fftDataIndex]) - Decibels::gainToDecibels((float)fftSize)), mindB, maxdB, 0.0f, 1.0f);
+		tmpScopeData[i] = level;                                  // [4]
+	}
 
-		nextFFTBlockReady = false;
+	for (auto& i : items)
+	{
+		if (i->channel->intValue() - 1 != channel) continue;
+		i->process(tmpScopeData, scopeSize);
+	}
+
+	{
+		const ScopedLock lock(scopeDataMutex);
+		memcpy(ca->scopeData, tmpScopeData, sizeof(ca->scopeData));
 	}
 }
 
-void FFTAnalyzerManager::copyScopeData(float* scopeData, int maxSize) const
+void FFTAnalyzerManager::publishValues()
 {
-	const ScopedLock lock(scopeDataMutex);
-	memcpy(scopeData, this->scopeData, std::min(maxSize * sizeof(*scopeData), sizeof(this->scopeData)));
+	for (auto& i : items) i->publishValue();
 }
 
-void FFTAnalyzerManager::pushNextSampleIntoFifo(float sample)
+void FFTAnalyzerManager::copyScopeData(float* scopeData, int maxSize, int channel) const
 {
-	if (fifoIndex == fftSize)    // [11]
+	const ScopedLock lock(scopeDataMutex);
+	if (!isPositiveAndBelow(channel, channels.size()))
 	{
-		if (!nextFFTBlockReady) // [12]
-		{
-			zeromem(fftData, sizeof(fftData));
-			memcpy(fftData, fifo, sizeof(fifo));
-			nextFFTBlockReady = true;
-		}
-		fifoIndex = 0;
+		zeromem(scopeData, jmin<int>(maxSize, scopeSize) * sizeof(*scopeData));
+		return;
 	}
-	fifo[fifoIndex++] = sample;  // [12]
+
+	memcpy(scopeData, channels.getUnchecked(channel)->scopeData, std::min(maxSize * sizeof(*scopeData), sizeof(ChannelAnalysis::scopeData)));
 }
 
 InspectableEditor* FFTAnalyzerManager::getEditorInternal(bool isRoot, Array<Inspectable*> inspectables)
@@ -113,8 +163,10 @@ var FFTAnalyzerManager::getFFTDataFromScript(const var::NativeFunctionArgs& a)
 	Array<var>& resultArray = *result.getArray();
 	resultArray.clearQuick();
 
+	int channel = a.numArguments > 1 ? (int)a.arguments[1] - 1 : 0;
+
 	float tmpScopeData[scopeSize];
-	manager->copyScopeData(tmpScopeData);
+	manager->copyScopeData(tmpScopeData, scopeSize, channel);
 	resultArray.addArray((float*)tmpScopeData, scopeSize);
 	return result;
 }
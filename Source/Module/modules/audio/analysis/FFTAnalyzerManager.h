@@ -30,20 +30,29 @@ public:
 		scopeSize = 256            // [3]
 	};
 
-	void process(const float* samples, int numSamples);
-	void copyScopeData(float* scopeData, int maxSize = scopeSize) const;
+	void setNumChannels(int numChannels); //not while processing, the audio module calls it with its callback removed
+	void process(const float* const* channelData, int numChannels, int numSamples);
+	void publishValues();
+	void copyScopeData(float* scopeData, int maxSize = scopeSize, int channel = 0) const;
 
 private:
+	struct ChannelAnalysis
+	{
+		ChannelAnalysis();
+		float fifo[fftSize];
+		float fftData[2 * fftSize];
+		int fifoIndex;
+		float scopeData[scopeSize];
+	};
+
 	dsp::FFT forwardFFT;                  // [4]
 	dsp::WindowingFunction<float> window; // [5]
-	float fifo[fftSize];                 // [6]
-	float fftData[2 * fftSize];          // [7]
-	int fifoIndex = 0;                    // [8]
-	bool nextFFTBlockReady = false;       // [9]
-	float scopeData[scopeSize];          // [10]
+	OwnedArray<ChannelAnalysis> channels;
 	CriticalSection scopeDataMutex;
 
-	void pushNextSampleIntoFifo(float sample);
+	bool isChannelUsed(int channel) const;
+	void pushSamplesIntoFifo(int channel, const float* samples, int numSamples);
+	void processFFTBlock(int channel);
 
 	InspectableEditor* getEditorInternal(bool isRoot, Array<Inspectable*> inspectables = Array<Inspectable*>()) override;
 
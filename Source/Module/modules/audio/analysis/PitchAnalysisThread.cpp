@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    PitchAnalysisThread.cpp
+    Created: 18 Oct 2026 7:20:18pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+PitchAnalysisThread::PitchAnalysisThread(AudioModule* audioModule) :
+	Thread("Pitch Analysis"),
+	audioModule(audioModule),
+	droppedBlocks(0),
+	fifo(fifoSize),
+	isActive(false),
+	windowSize(0),
+	hopSize(0),
+	numNewSamples(0),
+	sampleRate(44100)
+{
+	fifoData.allocate(fifoSize, true);
+	startThread();
+}
+
+PitchAnalysisThread::~PitchAnalysisThread()
+{
+	stopThread(1000);
+}
+
+void PitchAnalysisThread::setup(int method, double _sampleRate, int _windowSize, float overlap)
+{
+	GenericScopedLock lock(detectorLock);
+
+	sampleRate = _sampleRate > 0 ? _sampleRate : 44100;
+	windowSize = _windowSize;
+	hopSize = jmax(1, (int)(windowSize * (1 - jlimit(0.0f, .95f, overlap))));
+	numNewSamples = 0;
+
+	window.allocate(windowSize, true);
+
+	switch (method)
+	{
+	case AudioModule::MPM: detector.reset(new PitchMPM((int)sampleRate, windowSize)); break;
+	case AudioModule::YIN: detector.reset(new PitchYIN((int)sampleRate, windowSize)); break;
+	default: detector.reset(); break;
+	}
+
+	isActive = detector != nullptr;
+}
+
+void PitchAnalysisThread::pushSamples(const float* samples, int numSamples)
+{
+	if (!isActive) return;
+
+	if (fifo.getFreeSpace() < numSamples)
+	{
+		droppedBlocks++;
+		return;
+	}
+
+	int start1, size1, start2, size2;
+	fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+	if (size1 > 0) FloatVectorOperations::copy(fifoData + start1, samples, size1);
+	if (size2 > 0) FloatVectorOperations::copy(fifoData + start2, samples + size1, size2);
+	fifo.finishedWrite(size1 + size2);
+}
+
+void PitchAnalysisThread::run()
+{
+	while (!threadShouldExit())
+	{
+		int msToWait = 10;
+
+		{
+			GenericScopedLock lock(detectorLock);
+
+			if (detector == nullptr)
+			{
+				fifo.finishedRead(fifo.getNumReady());
+			}
+			else
+			{
+				while (!threadShouldExit() && fifo.getNumReady() > 0)
+				{
+					readSamples(jmin(fifo.getNumReady(), hopSize - numNewSamples));
+					if (numNewSamples < hopSize) continue;
+
+					analyzeWindow();
+					numNewSamples = 0;
+				}
+
+				msToWait = jmax(1, (int)(hopSize * 500 / sampleRate)); //half a hop
+			}
+		}
+
+		wait(msToWait);
+	}
+}
+
+void PitchAnalysisThread::readSamples(int numSamples)
+{
+	if (numSamples <= 0) return;
+
+	//Slide the window and append the new samples at its end
+	numSamples = jmin(numSamples, windowSize);
+	memmove(window.get(), window.get() + numSamples, sizeof(float) * (windowSize - numSamples));
+
+	float* dest = window.get() + windowSize - numSamples;
+	int start1, size1, start2, size2;
+	fifo.prepareToRead(numSamples, start1, size1, start2, size2);
+	if (size1 > 0) FloatVectorOperations::copy(dest, fifoData + start1, size1);
+	if (size2 > 0) FloatVectorOperations::copy(dest + size1, fifoData + start2, size2);
+	fifo.finishedRead(size1 + size2);
+
+	numNewSamples += size1 + size2;
+}
+
+void PitchAnalysisThread::analyzeWindow()
+{
+	float sum = 0;
+	for (int i = 0; i < windowSize; i++) sum += window[i] * window[i];
+	float rms = std::sqrt(sum / windowSize);
+
+	if (rms <= audioModule->activityThreshold->floatValue())
+	{
+		audioModule->pitchDetected(0);
+		return;
+	}
+
+	audioModule->pitchDetected(detector->getPitch(window.get()));
+}
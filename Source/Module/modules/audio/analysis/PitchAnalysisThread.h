@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    PitchAnalysisThread.h
+    Created: 18 Oct 2026 7:20:18pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class AudioModule;
+
+/*
+	Runs pitch detection away from the audio callback.
+	The audio thread only copies the analysis channel into a lock-free ring buffer,
+	this thread slides a window over it and runs the detector every hop (window size * (1 - overlap)).
+*/
+class PitchAnalysisThread :
+	public Thread
+{
+public:
+	PitchAnalysisThread(AudioModule* audioModule);
+	~PitchAnalysisThread();
+
+	static const int fifoSize = 1 << 15;
+
+	AudioModule* audioModule;
+	std::atomic<int> droppedBlocks;
+
+	void setup(int method, double sampleRate, int windowSize, float overlap); //message thread
+	void pushSamples(const float* samples, int numSamples); //audio thread, never blocks, drops the block if the analysis is late
+
+	void run() override;
+
+private:
+	AbstractFifo fifo;
+	HeapBlock<float> fifoData;
+	std::atomic<bool> isActive;
+
+	CriticalSection detectorLock; //between setup and the analysis, never taken on the audio thread
+	std::unique_ptr<PitchDetector> detector;
+	HeapBlock<float> window;
+	int windowSize;
+	int hopSize;
+	int numNewSamples;
+	double sampleRate;
+
+	void readSamples(int numSamples);
+	void analyzeWindow();
+
+	JUCE_DECLARE_NON_COPYABLE(PitchAnalysisThread)
+};
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    FFTCorrelation.h
+    Created: 18 Oct 2026 7:02:41pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Computes sum(a[i] * b[i + tau]) for every lag at once in O(N log N), used by the pitch detectors
+	instead of their nested time-domain loops. Inputs are zero-padded so the circular FFT correlation equals the linear one.
+*/
+class FFTCorrelation
+{
+public:
+	FFTCorrelation() : order(-1), size(0) {}
+
+	void correlate(const float* a, int numA, const float* b, int numB, float* result, int numLags)
+	{
+		jassert(numLags <= numB);
+		prepare(numA + numB);
+
+		FloatVectorOperations::clear(aData.get(), size * 2);
+		FloatVectorOperations::copy(aData.get(), a, numA);
+		FloatVectorOperations::clear(bData.get(), size * 2);
+		FloatVectorOperations::copy(bData.get(), b, numB);
+
+		fft->performRealOnlyForwardTransform(aData.get());
+		fft->performRealOnlyForwardTransform(bData.get());
+
+		//conj(A) * B
+		for (int i = 0; i < size; i++)
+		{
+			const float ar = aData[i * 2], ai = aData[i * 2 + 1];
+			const float br = bData[i * 2], bi = bData[i * 2 + 1];
+			bData[i * 2] = ar * br + ai * bi;
+			bData[i * 2 + 1] = ar * bi - ai * br;
+		}
+
+		fft->performRealOnlyInverseTransform(bData.get());
+		FloatVectorOperations::copy(result, bData.get(), numLags);
+	}
+
+	void autocorrelate(const float* x, int numSamples, float* result, int numLags)
+	{
+		jassert(numLags <= numSamples);
+		prepare(numSamples * 2);
+
+		FloatVectorOperations::clear(bData.get(), size * 2);
+		FloatVectorOperations::copy(bData.get(), x, numSamples);
+
+		fft->performRealOnlyForwardTransform(bData.get());
+
+		//|X|^2
+		for (int i = 0; i < size; i++)
+		{
+			const float re = bData[i * 2], im = bData[i * 2 + 1];
+			bData[i * 2] = re * re + im * im;
+			bData[i * 2 + 1] = 0;
+		}
+
+		fft->performRealOnlyInverseTransform(bData.get());
+		FloatVectorOperations::copy(result, bData.get(), numLags);
+	}
+
+private:
+	int order;
+	int size;
+	std::unique_ptr<dsp::FFT> fft;
+	HeapBlock<float> aData;
+	HeapBlock<float> bData;
+
+	void prepare(int minSize)
+	{
+		int newOrder = 1;
+		while ((1 << newOrder) < minSize) newOrder++;
+		if (newOrder == order) return;
+
+		order = newOrder;
+		size = 1 << order;
+		fft.reset(new dsp::FFT(order));
+		aData.allocate(size * 2, true);
+		bData.allocate(size * 2, true);
+	}
+};
@@ -112,6 +112,7 @@ public:
 	void setBufferSize(int value) override
 	{
 		bufferSize = value;
+		nsdf.resize(bufferSize);
 	}
 
 private:
@@ -124,6 +125,8 @@ private:
     Array<int> maxPositions;
     Array<float> periodEstimates;
     Array<float> ampEstimates;
+
+    FFTCorrelation correlation;
     
     void parabolicInterpolation(int tau)
     {
@@ -191,15 +194,16 @@ private:
     
     void nsdfTimeDomain(const float *audioBuffer)
     {
-        int tau;
-        for (tau = 0; tau < bufferSize; tau++) {
-            float acf = 0;
-            float divisorM = 0;
-            for (int i = 0; i < bufferSize - tau; ++i) {
-                acf += audioBuffer[i] * audioBuffer[i + tau];
-                divisorM += audioBuffer[i] * audioBuffer[i] + audioBuffer[i + tau] * audioBuffer[i + tau];
-            }
-            nsdf.setUnchecked(tau, 2 * acf / divisorM);
+        //autocorrelation through the FFT, the normalization term m(tau) is updated incrementally
+        float* nsdfPtr = nsdf.getRawDataPointer();
+        correlation.autocorrelate(audioBuffer, bufferSize, nsdfPtr, bufferSize);
+
+        float divisorM = 0;
+        for (int i = 0; i < bufferSize; ++i) divisorM += 2 * audioBuffer[i] * audioBuffer[i];
+
+        for (int tau = 0; tau < bufferSize; tau++) {
+            nsdfPtr[tau] = divisorM > 0 ? 2 * nsdfPtr[tau] / divisorM : 0;
+            divisorM -= audioBuffer[tau] * audioBuffer[tau] + audioBuffer[bufferSize - 1 - tau] * audioBuffer[bufferSize - 1 - tau];
         }
     }
 
@@ -1,20 +1,19 @@
-
 class PitchYIN :
 	public PitchDetector
 {
 
 public:
 
-    PitchYIN (int sampleRate, unsigned int bufferSize) : yin (1, bufferSize), bufferSize (bufferSize), tolerence (0.15), sampleRate(sampleRate),
-    deltaWasNegative (false)
+    PitchYIN (int sampleRate, unsigned int bufferSize) : bufferSize (bufferSize), tolerence (0.15f), sampleRate(sampleRate)
     {
+        allocate();
     }
-    
-    PitchYIN (unsigned int bufferSize) : yin (1, bufferSize), bufferSize (bufferSize), tolerence (0.15), sampleRate(44100),
-    deltaWasNegative (false)
+
+    PitchYIN (unsigned int bufferSize) : bufferSize (bufferSize), tolerence (0.15f), sampleRate(44100)
     {
+        allocate();
     }
-    
+
     void setSampleRate(unsigned int newSampleRate)
     {
         sampleRate = newSampleRate;
@@ -33,202 +32,152 @@ public:
 	void setBufferSize(int value) override
 	{
 		bufferSize = value;
+		allocate();
 	}
 
 
-    /** Output the difference function */
-    void difference(AudioSampleBuffer& input) 
-    {
-        float tmp;
-        float *yinData = yin.getWritePointer(0);
-        const float *inputData = input.getReadPointer(0);
-
-        FloatVectorOperations::fill(yinData, 0.0, yin.getNumSamples());
-
-        for (int tau = 1; tau < yin.getNumSamples(); tau++) 
-        {
-            for (int j = 0; j < yin.getNumSamples(); j++) 
-            {
-                tmp = inputData[j] - inputData[j + tau];
-                yinData[tau] += (tmp * tmp);
-            }
-        }
-    }
-
-    /** cumulative mean normalized difference function */
-    void cumulativeMean ()
-    {
-        float *yinData = yin.getWritePointer(0);
-        float tmp = 0.;
-        yinData[0] = 1.;
-        //AUBIO_DBG("%f\t",yinData[0]);
-        for (int tau = 1; tau < yin.getNumSamples(); tau++)
-        {
-            tmp += yinData[tau];
-            yinData[tau] *= tau / tmp;
-            //AUBIO_DBG("%f\t",yinData[tau]);
-        }
-        //AUBIO_DBG("\n");
-    }
-
-    int getPitch ()
-    {
-        int tau = 0;
-        float *yinData = yin.getWritePointer(0);
-        do {
-            if (yinData[tau] < 0.1) 
-            {
-                while (yinData[tau + 1] < yinData[tau]) 
-                {
-                    tau++;
-                }
-                return tau;
-            }
-            tau++;
-        } while (tau < yin.getNumSamples());
-        //AUBIO_DBG("No pitch found");
-        return 0;
-        
-    }
-    
-    
-    /** Full YIN algorithm */
+    /** Full YIN algorithm, returns the pitch in Hz or -1 if none was found */
 
 	float getPitch(const float* inputData) override
 	{
-		return calculatePitch(inputData);
+		return getPitchInHz(inputData);
 	}
 
+    /** Period in samples. The difference function uses half of the buffer as integration window.
+        From minFFTBufferSize, its correlation term comes from the FFT instead of a loop over every lag,
+        below that the time-domain loop is cheaper */
     float calculatePitch (const float* inputData) noexcept
     {
-        int period;
-        float delta = 0.0, runningSum = 0.0;
+        const int windowSize = bufferSize / 2;
+        if (windowSize < 4) return 0;
+
         float *yinData = yin.getWritePointer(0);
-        //deltaWasNegative = false;
 
-        //DBG ("calculatePitch");
+        if (useFFT) differenceFFT(inputData, windowSize, yinData);
+        else differenceTimeDomain(inputData, windowSize, yinData);
 
+        //cumulative mean normalized difference
+        float runningSum = 0.0;
         yinData[0] = 1.0;
-        for (int tau = 1; tau < yin.getNumSamples(); tau++)
+        for (int tau = 1; tau < windowSize; tau++)
         {
-            yinData[tau] = 0.0;
-            for (int j = 0; j < yin.getNumSamples(); j++)
-            {
-                delta = inputData[j] - inputData[j + tau];
-                yinData[tau] += (delta * delta);
-                //if (delta < 0) deltaWasNegative = true;
-            }
             runningSum += yinData[tau];
-            if (runningSum != 0)
-            {
-                yinData[tau] *= tau / runningSum;
-            }
-            else
-            {
-                yinData[tau] = 1.0;
-            }
-            period = tau - 3;
-            if (tau > 4 && (yinData[period] < tolerence) &&
-                    (yinData[period] < yinData[period + 1]))
+            yinData[tau] = runningSum != 0 ? yinData[tau] * tau / runningSum : 1.0f;
+        }
+
+        for (int tau = 2; tau < windowSize; tau++)
+        {
+            if (yinData[tau] < tolerence)
             {
-                DBG ("return early");
-                return quadraticPeakPosition (yin.getReadPointer(0), period);
+                while (tau + 1 < windowSize && yinData[tau + 1] < yinData[tau]) tau++;
+                return quadraticPeakPosition (yinData, tau, windowSize);
             }
         }
-        return quadraticPeakPosition (yin.getReadPointer(0), minElement (yin.getReadPointer(0)));
+
+        return quadraticPeakPosition (yinData, minElement (yinData, windowSize), windowSize);
     }
 
     float getPitchInHz (const float* inputData) noexcept
     {
-        float pitch = 0.0;
-        //slideBlock (input);
-        pitch = calculatePitch (inputData);
-       // log->writeToLog("pitch: " + String(pitch));
-        
-        if (pitch > 0)
-        {
-            pitch = sampleRate / (pitch + 0.0);
-            //log->writeToLog ("pitchInHz: " + String(pitch));
-        }
-        else
-        {
-            pitch = 0.0;
-        }
+        float pitch = calculatePitch (inputData);
+
+        if (pitch > 0) pitch = sampleRate / pitch;
+        else pitch = -1;
+
         currentPitch = pitch;
-        //if (deltaWasNegative) DBG("delta negative");
-        
         return pitch;
     }
-    
+
     void setTolerence(float newTolerence)
     {
         tolerence = newTolerence;
     }
 
+    static const unsigned int minFFTBufferSize = 2048; //measured crossover, the FFT is slower on smaller buffers
+
 private:
-    AudioSampleBuffer yin; //, buf;
-    //float* yinData;
+    AudioSampleBuffer yin;
+    AudioSampleBuffer energy;
+    FFTCorrelation correlation;
     unsigned int bufferSize;
-    unsigned int tolerence; //, confidence;
+    float tolerence;
     unsigned int sampleRate;
-    bool deltaWasNegative;
-    float currentPitch;
-    Logger *log;
-
-//    /** adapter to stack ibuf new samples at the end of buf, and trim `buf` to `bufsize` */
-//    void slideBlock (AudioSampleBuffer& ibuf)
-//    {
-//        float *bufData = buf.getWritePointer(0);
-//        const float *ibufData = ibuf.getReadPointer(0);
-//
-//        unsigned int j = 0, overlapSize = 0;
-//        overlapSize = buf.getNumSamples() - ibuf.getNumSamples();
-//        for (j = 0; j < overlapSize; j++) 
-//        {
-//            bufData[j] = bufData[j + ibuf.getNumSamples()];
-//        }
-//        for (j = 0; j < ibuf.getNumSamples(); j++) 
-//        {
-//            bufData[j + overlapSize] = ibufData[j];
-//        }
-//    }
+    float currentPitch = 0;
+    bool useFFT = false;
+
+    void allocate()
+    {
+        useFFT = bufferSize >= minFFTBufferSize;
+        yin.setSize(1, jmax<int>(1, bufferSize / 2));
+        energy.setSize(1, useFFT ? bufferSize + 1 : 1);
+    }
+
+    //d(tau) = sum((x[j] - x[j + tau])^2) over the window
+    void differenceTimeDomain(const float* inputData, int windowSize, float* d) noexcept
+    {
+        d[0] = 0;
+        for (int tau = 1; tau < windowSize; tau++)
+        {
+            float sum = 0;
+            for (int j = 0; j < windowSize; j++)
+            {
+                const float tmp = inputData[j] - inputData[j + tau];
+                sum += tmp * tmp;
+            }
+            d[tau] = sum;
+        }
+    }
+
+    //same, as d(tau) = e(0) + e(tau) - 2r(tau) with the correlation r from the FFT
+    void differenceFFT(const float* inputData, int windowSize, float* d) noexcept
+    {
+        float *energyData = energy.getWritePointer(0);
+
+        correlation.correlate(inputData, windowSize, inputData, bufferSize, d, windowSize);
+
+        //energyData[i] = sum of squares of the first i samples
+        energyData[0] = 0;
+        for (unsigned int i = 0; i < bufferSize; i++) energyData[i + 1] = energyData[i] + inputData[i] * inputData[i];
+
+        const float e0 = energyData[windowSize];
+        d[0] = 0;
+        for (int tau = 1; tau < windowSize; tau++) d[tau] = jmax(0.0f, e0 + energyData[tau + windowSize] - energyData[tau] - 2 * d[tau]);
+    }
 
     // Below functions should go in a seperate utilities class
 
-    float quadraticPeakPosition (const float *data, unsigned int pos) noexcept
+    float quadraticPeakPosition (const float *data, unsigned int pos, unsigned int numValues) noexcept
     {
         float s0, s1, s2;
         unsigned int x0, x2;
-        if (pos == 0 || pos == bufferSize - 1) return pos;
+        if (pos == 0 || pos == numValues - 1) return pos;
         x0 = (pos < 1) ? pos : pos - 1;
-        x2 = (pos + 1 < bufferSize) ? pos + 1 : pos;
+        x2 = (pos + 1 < numValues) ? pos + 1 : pos;
         if (x0 == pos) return (data[pos] <= data[x2]) ? pos : x2;
         if (x2 == pos) return (data[pos] <= data[x0]) ? pos : x0;
         s0 = data[x0];
         s1 = data[pos];
         s2 = data[x2];
-        return pos + 0.5 * (s0 - s2 ) / (s0 - 2.* s1 + s2);
+        float bottom = s0 - 2.f * s1 + s2;
+        if (bottom == 0) return pos;
+        return pos + 0.5f * (s0 - s2) / bottom;
     }
 
-    unsigned int minElement (const float *data) noexcept
+    unsigned int minElement (const float *data, unsigned int numValues) noexcept
     {
     #ifndef JUCE_USE_VDSP_FRAMEWORK
         unsigned int j, pos = 0;
         float tmp = data[0];
-        for (j = 0; j < bufferSize; j++)
+        for (j = 0; j < numValues; j++)
         {
             pos = (tmp < data[j]) ? pos : j;
             tmp = (tmp < data[j]) ? tmp : data[j];
         }
     #else
         float tmp = 0.0;
-        unsigned int pos = 0;
-        #if !DOUBLE_SAMPLES
-        vDSP_minvi(data, 1, &tmp, (vDSP_Length *)&pos, bufferSize);
-        #else
-        vDSP_minviD(data, 1, &tmp, (vDSP_Length *)&pos, bufferSize);
-        #endif
+        vDSP_Length pos = 0;
+        vDSP_minvi(data, 1, &tmp, &pos, numValues);
     #endif
-        return pos;
-    }    
+        return (unsigned int)pos;
+    }
 };
@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    LTCGenerator.cpp
+    Created: 18 Oct 2026 8:04:51pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+LTCGenerator::LTCGenerator() :
+	encoder(nullptr),
+	sampleRate(0),
+	fps(30),
+	isRunning(false),
+	clockTime(0),
+	frameLength(0),
+	framePos(0),
+	lastFrame(-1)
+{
+}
+
+LTCGenerator::~LTCGenerator()
+{
+	ltc_encoder_free(encoder);
+}
+
+void LTCGenerator::setup(double _sampleRate, int _fps, float volumeDB)
+{
+	if (_sampleRate <= 0 || _fps <= 0) return;
+
+	LTC_TV_STANDARD standard = _fps == 25 ? LTC_TV_625_50 : (_fps == 24 ? LTC_TV_FILM_24 : LTC_TV_525_60);
+	LTCEncoder* newEncoder = ltc_encoder_create(_sampleRate, _fps, standard, 0);
+
+	HeapBlock<float> newFrameSamples;
+	if (newEncoder != nullptr)
+	{
+		ltc_encoder_set_volume(newEncoder, volumeDB);
+		newFrameSamples.allocate(ltc_encoder_get_buffersize(newEncoder), true);
+	}
+
+	LTCEncoder* oldEncoder = nullptr;
+	{
+		GenericScopedLock<SpinLock> lock(encoderLock);
+		oldEncoder = encoder;
+		encoder = newEncoder;
+		sampleRate = _sampleRate;
+		fps = _fps;
+		frameSamples.swapWith(newFrameSamples);
+		frameLength = 0;
+		framePos = 0;
+		isRunning = false;
+	}
+
+	ltc_encoder_free(oldEncoder);
+}
+
+void LTCGenerator::setSequenceState(bool isPlaying, double time, double speed)
+{
+	GenericScopedLock<SpinLock> lock(stateLock);
+	state.isPlaying = isPlaying;
+	state.time = time;
+	state.speed = speed;
+	state.timestamp = Time::getMillisecondCounterHiRes();
+}
+
+void LTCGenerator::render(float* output, int numSamples)
+{
+	{
+		GenericScopedTryLock<SpinLock> stateTryLock(stateLock);
+		if (stateTryLock.isLocked()) audioState = state;
+	}
+
+	GenericScopedTryLock<SpinLock> lock(encoderLock);
+	if (!lock.isLocked() || encoder == nullptr) return;
+
+	if (!audioState.isPlaying)
+	{
+		isRunning = false;
+		return;
+	}
+
+	const double expectedTime = audioState.time + (Time::getMillisecondCounterHiRes() - audioState.timestamp) / 1000.0 * audioState.speed;
+	if (!isRunning || std::abs(clockTime - expectedTime) > 1.0 / fps)
+	{
+		//Start or jump : position inside the frame so the timecode lands on the right sample
+		clockTime = jmax(0.0, expectedTime);
+		const double framePosition = clockTime * fps;
+		encodeFrame((int64)std::floor(framePosition));
+		framePos = jlimit(0, frameLength, (int)((framePosition - std::floor(framePosition)) * frameLength));
+		isRunning = true;
+	}
+
+	const double timePerSample = audioState.speed / sampleRate;
+	for (int i = 0; i < numSamples; i++)
+	{
+		if (framePos >= frameLength)
+		{
+			encodeFrame(audioState.speed == 1 ? lastFrame + 1 : (int64)std::floor(clockTime * fps + .5));
+			if (frameLength == 0) break;
+		}
+
+		output[i] += frameSamples[framePos++];
+		clockTime += timePerSample;
+	}
+}
+
+void LTCGenerator::encodeFrame(int64 frameNumber)
+{
+	frameNumber = jmax<int64>(0, frameNumber);
+
+	SMPTETimecode st;
+	zerostruct(st);
+	strcpy(st.timezone, "+0000");
+
+	const int64 totalSeconds = frameNumber / fps;
+	st.frame = (unsigned char)(frameNumber % fps);
+	st.secs = (unsigned char)(totalSeconds % 60);
+	st.mins = (unsigned char)((totalSeconds / 60) % 60);
+	st.hours = (unsigned char)((totalSeconds / 3600) % 24);
+
+	ltc_encoder_set_timecode(encoder, &st);
+	ltc_encoder_encode_frame(encoder);
+
+	int size = 0;
+	ltcsnd_sample_t* buf = ltc_encoder_get_bufptr(encoder, &size, 1);
+	size = jmin(size, (int)ltc_encoder_get_buffersize(encoder));
+
+	for (int i = 0; i < size; i++) frameSamples[i] = (buf[i] - 128) / 128.0f;
+
+	frameLength = size;
+	framePos = 0;
+	lastFrame = frameNumber;
+}
@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    LTCGenerator.h
+    Created: 18 Oct 2026 8:04:51pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Renders LTC into an audio output channel, clocked from a sequence.
+	The sequence state is handed over from the message thread, the audio thread runs its own sample clock
+	and only re-anchors it when the sequence jumps by more than a frame, so frames start on their exact sample.
+*/
+class LTCGenerator
+{
+public:
+	LTCGenerator();
+	~LTCGenerator();
+
+	void setup(double sampleRate, int fps, float volumeDB);
+	void setSequenceState(bool isPlaying, double time, double speed); //time is the sequence time right now
+
+	void render(float* output, int numSamples); //audio thread, adds to the output
+
+private:
+	SpinLock encoderLock; //the audio thread only try-locks, a block is skipped while the encoder is being set up
+	LTCEncoder* encoder;
+	double sampleRate;
+	int fps;
+
+	struct SequenceState
+	{
+		bool isPlaying = false;
+		double time = 0;
+		double speed = 1;
+		double timestamp = 0; //Time::getMillisecondCounterHiRes() when time was read
+	};
+
+	SpinLock stateLock;
+	SequenceState state;
+	SequenceState audioState; //last state the audio thread could read
+
+	//Audio thread only
+	bool isRunning;
+	double clockTime; //sequence time of the next sample to output
+	HeapBlock<float> frameSamples;
+	int frameLength;
+	int framePos;
+	int64 lastFrame;
+
+	void encodeFrame(int64 frameNumber);
+
+	JUCE_DECLARE_NON_COPYABLE(LTCGenerator)
+};
@@ -81,7 +81,7 @@ void CustomOSCCommand::triggerInternal(int multiplexIndex)
 
 			}
 		}
-		oscModule->sendOSC(m);
+		sendMessage(std::move(m));
 	}
 	catch (const OSCFormatError&)
 	{
@@ -13,7 +13,8 @@
 OSCCommand::OSCCommand(IOSCSenderModule* _module, CommandContext context, var params, Multiplex* multiplex) :
 	BaseCommand(dynamic_cast<Module*>(_module), context, params, multiplex),
 	oscModule(_module),
-	argumentsContainer("Arguments", multiplex)
+	argumentsContainer("Arguments", multiplex),
+	batchMessages(nullptr)
 {
 	address = addStringParameter("Address", "Adress of the OSC Message (e.g. /example)", params.getProperty("address", "/example"));
 	address->setControllableFeedbackOnly(true);
@@ -169,10 +170,29 @@ void OSCCommand::triggerInternal(int multiplexIndex)
 			OSCHelpers::addArgumentsForParameter(m, p, oscModule->getBoolMode(), oscModule->getColorMode(), val);
 		}
 
-		oscModule->sendOSC(m);
+		sendMessage(std::move(m));
 	}
 	catch (OSCFormatError& e)
 	{
 		LOGERROR("Can't send to address " << addrString << " : " << e.description);
 	}
 }
+
+void OSCCommand::setValues(const Array<var>& values, const Array<int>& multiplexIndices)
+{
+	if (oscModule == nullptr) return;
+
+	Array<OSCMessage> messages;
+	batchMessages = &messages;
+	BaseCommand::setValues(values, multiplexIndices);
+	batchMessages = nullptr;
+
+	if (messages.size() == 1) oscModule->sendOSC(std::move(messages.getReference(0)));
+	else if (messages.size() > 1) oscModule->sendOSCBundle(std::move(messages));
+}
+
+void OSCCommand::sendMessage(OSCMessage&& m)
+{
+	if (batchMessages != nullptr) batchMessages->add(std::move(m));
+	else oscModule->sendOSC(std::move(m));
+}
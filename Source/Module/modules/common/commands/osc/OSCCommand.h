@@ -44,6 +44,11 @@ public:
 
 	void triggerInternal(int multiplexIndex) override;
 
+	//Mapping batches : the messages of all the indices are collected and sent as one bundle
+	Array<OSCMessage>* batchMessages; //only set during setValues, on the mapping's processing thread
+	void setValues(const Array<var>& values, const Array<int>& multiplexIndices) override;
+	void sendMessage(OSCMessage&& m);
+
 	static BaseCommand * create(ControllableContainer * cc, CommandContext context, var params, Multiplex * multiplex) { return new OSCCommand(dynamic_cast<IOSCSenderModule*>(cc), context, params, multiplex); }
 
 
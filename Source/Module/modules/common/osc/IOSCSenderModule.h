@@ -17,6 +17,8 @@ public:
 
 
 	virtual void sendOSC(const OSCMessage& m) = 0;
+	virtual void sendOSC(OSCMessage&& m) { sendOSC(static_cast<const OSCMessage&>(m)); } //modules that queue messages take it instead of copying it
+	virtual void sendOSCBundle(Array<OSCMessage>&& messages) { for (auto& m : messages) sendOSC(std::move(m)); }
 	virtual OSCHelpers::ColorMode getColorMode() { return OSCHelpers::ColorMode::ColorRGBA; }
 	virtual OSCHelpers::BoolMode getBoolMode() { return OSCHelpers::BoolMode::Int; }
 };
\ No newline at end of file
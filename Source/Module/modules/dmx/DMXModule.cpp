@@ -16,7 +16,8 @@ DMXModule::DMXModule() :
 	Thread("DMX Send"),
 	dmxDevice(nullptr),
 	inputUniverseManager(true),
-	outputUniverseManager(false)
+	outputUniverseManager(false),
+	inputFramesAreStale(false)
 {
 	outputUniverseManager.setNiceName("Output Universes");
 	setupIOConfiguration(false, true);
@@ -81,6 +82,9 @@ DMXModule::DMXModule() :
 
 	inputUniverseManager.addBaseManagerListener(this);
 	outputUniverseManager.addBaseManagerListener(this);
+
+	updateUniverseIndex();
+	updateOutputBuffers();
 }
 
 DMXModule::~DMXModule()
@@ -89,21 +93,29 @@ DMXModule::~DMXModule()
 
 void DMXModule::itemAdded(DMXUniverseItem* i)
 {
+	updateUniverseIndex();
+	updateOutputBuffers();
 	updateDeviceMulticast();
 }
 
 void DMXModule::itemsAdded(Array<DMXUniverseItem*> items)
 {
+	updateUniverseIndex();
+	updateOutputBuffers();
 	updateDeviceMulticast();
 }
 
 void DMXModule::itemRemoved(DMXUniverseItem* i)
 {
+	updateUniverseIndex();
+	updateOutputBuffers();
 	updateDeviceMulticast();
 }
 
 void DMXModule::itemsRemoved(Array<DMXUniverseItem*> items)
 {
+	updateUniverseIndex();
+	updateOutputBuffers();
 	updateDeviceMulticast();
 }
 
@@ -166,10 +178,44 @@ void DMXModule::updateDeviceMulticast()
 	dmxDevice->setupMulticast(inUniv, outUniv);
 }
 
+void DMXModule::updateOutputBuffers()
+{
+	ScopedWriteLock lock(outputBufferLock);
+
+	//keep the buffers of universes that are still there, with their current values
+	OwnedArray<DMXUniverseBuffer> oldBuffers;
+	oldBuffers.swapWith(outputBuffers);
+	outputBufferMap.clear();
+
+	for (auto& u : outputUniverseManager.items)
+	{
+		DMXUniverseBuffer* b = nullptr;
+		for (int i = 0; i < oldBuffers.size(); i++)
+		{
+			if (oldBuffers[i]->universe == u)
+			{
+				b = oldBuffers.removeAndReturn(i);
+				break;
+			}
+		}
+
+		if (b == nullptr) b = new DMXUniverseBuffer(u);
+		outputBuffers.add(b);
+		outputBufferMap.set(u, b);
+	}
+}
+
+void DMXModule::writeDMXValue(DMXUniverse* u, DMXUniverseBuffer* b, int channel, uint8 value)
+{
+	//the universe item is updated right away, so it reads back what was sent even before the next publish.
+	//Senders don't need a device : values wait in the buffer, and run() sends complete frames once a device is set
+	u->updateValue(channel, value);
+	if (b != nullptr) b->setValue(channel, value);
+}
+
 void DMXModule::sendDMXValue(DMXUniverse* u, int channel, uint8 value)
 {
 	if (!enabled->boolValue()) return;
-	if (dmxDevice == nullptr) return;
 	if (u == nullptr) return;
 
 	if (channel <= 0 || channel > DMX_NUM_CHANNELS) return;
@@ -179,13 +225,13 @@ void DMXModule::sendDMXValue(DMXUniverse* u, int channel, uint8 value)
 
 	channel--; //rebase at 0
 
-	u->updateValue(channel, value);
+	ScopedReadLock lock(outputBufferLock);
+	writeDMXValue(u, outputBufferMap[u], channel, value);
 }
 
 void DMXModule::sendDMXRange(DMXUniverse* u, int startChannel, Array<uint8> values)
 {
 	if (!enabled->boolValue()) return;
-	if (dmxDevice == nullptr) return;
 	if (u == nullptr) return;
 
 	if (startChannel <= 0) return;
@@ -196,17 +242,19 @@ void DMXModule::sendDMXRange(DMXUniverse* u, int startChannel, Array<uint8> valu
 
 	startChannel--; //rebase at 0
 
+	ScopedReadLock lock(outputBufferLock);
+	DMXUniverseBuffer* b = outputBufferMap[u];
+	DMXUniverseBuffer::ScopedWrite write(b);
 
 	for (int i = startChannel; i < startChannel + values.size() && i < DMX_NUM_CHANNELS; i++)
 	{
-		u->updateValue(i, values[i - startChannel]);
+		writeDMXValue(u, b, i, values[i - startChannel]);
 	}
 }
 
 void DMXModule::send16BitDMXValue(DMXUniverse* u, int channel, int value, DMXByteOrder byteOrder)
 {
 	if (!enabled->boolValue()) return;
-	if (dmxDevice == nullptr) return;
 	if (u == nullptr) return;
 
 	if (channel <= 0 || channel >= DMX_NUM_CHANNELS) return;
@@ -216,14 +264,17 @@ void DMXModule::send16BitDMXValue(DMXUniverse* u, int channel, int value, DMXByt
 
 	channel--; //rebase at 0
 
-	u->updateValue(channel, byteOrder == MSB ? (value >> 8) & 0xFF : value & 0xFF);
-	u->updateValue(channel + 1, byteOrder == MSB ? value & 0xFF : (value >> 8) & 0xFF);
+	ScopedReadLock lock(outputBufferLock);
+	DMXUniverseBuffer* b = outputBufferMap[u];
+	DMXUniverseBuffer::ScopedWrite write(b);
+
+	writeDMXValue(u, b, channel, byteOrder == MSB ? (value >> 8) & 0xFF : value & 0xFF);
+	writeDMXValue(u, b, channel + 1, byteOrder == MSB ? value & 0xFF : (value >> 8) & 0xFF);
 }
 
 void DMXModule::send16BitDMXRange(DMXUniverse* u, int startChannel, Array<int> values, DMXByteOrder byteOrder)
 {
 	if (!enabled->boolValue()) return;
-	if (dmxDevice == nullptr) return;
 	if (u == nullptr) return;
 
 	if (startChannel <= 0) return;
@@ -233,6 +284,10 @@ void DMXModule::send16BitDMXRange(DMXUniverse* u, int startChannel, Array<int> v
 
 	startChannel--; //rebase at 0
 
+	ScopedReadLock lock(outputBufferLock);
+	DMXUniverseBuffer* b = outputBufferMap[u];
+	DMXUniverseBuffer::ScopedWrite write(b);
+
 	for (int i = 0; i < values.size(); ++i)
 	{
 		int index = startChannel + i * 2;
@@ -240,8 +295,8 @@ void DMXModule::send16BitDMXRange(DMXUniverse* u, int startChannel, Array<int> v
 
 		int value = values[i];
 
-		u->updateValue(index, byteOrder == MSB ? (value >> 8) & 0xFF : value & 0xFF);
-		u->updateValue(index + 1, byteOrder == MSB ? value & 0xFF : (value >> 8) & 0xFF);
+		writeDMXValue(u, b, index, byteOrder == MSB ? (value >> 8) & 0xFF : value & 0xFF);
+		writeDMXValue(u, b, index + 1, byteOrder == MSB ? value & 0xFF : (value >> 8) & 0xFF);
 	}
 }
 
@@ -364,6 +419,8 @@ void DMXModule::loadJSONDataInternal(var data)
 void DMXModule::afterLoadJSONDataInternal()
 {
 	Module::afterLoadJSONDataInternal();
+	updateUniverseIndex();
+	updateOutputBuffers();
 	updateDeviceMulticast();
 	if (dmxDevice != nullptr) startThread();
 }
@@ -389,6 +446,16 @@ void DMXModule::onContainerParameterChanged(Parameter* p)
 void DMXModule::controllableFeedbackUpdate(ControllableContainer* cc, Controllable* c)
 {
 	Module::controllableFeedbackUpdate(cc, c);
+
+	for (ControllableContainer* pc = c->parentContainer.get(); pc != nullptr && pc != this; pc = pc->parentContainer.get())
+	{
+		if (DMXUniverseItem* u = dynamic_cast<DMXUniverseItem*>(pc))
+		{
+			if (c == u->netParam || c == u->subnetParam || c == u->universeParam) updateUniverseIndex();
+			return;
+		}
+	}
+
 	if (c == dmxType) setCurrentDMXDevice(DMXDevice::create((DMXDevice::Type)(int)dmxType->getValueData()));
 	else if (dmxDevice != nullptr)
 	{
@@ -410,6 +477,11 @@ void DMXModule::dmxDeviceSetupChanged(DMXDevice*)
 
 }
 void DMXModule::dmxDataInChanged(DMXDevice*, int net, int subnet, int universe, int priority, Array<uint8> values, const String& sourceName)
+{
+	processDMXIn(net, subnet, universe, priority, values.getRawDataPointer(), values.size(), sourceName);
+}
+
+void DMXModule::processDMXIn(int net, int subnet, int universe, int priority, const uint8* data, int numValues, const String& sourceName)
 {
 	if (isClearing || !enabled->boolValue()) return;
 	if (logIncomingData->boolValue())
@@ -433,7 +505,7 @@ void DMXModule::dmxDataInChanged(DMXDevice*, int net, int subnet, int universe,
 				{
 					if (m->dmxDevice != nullptr)
 					{
-						m->dmxDevice->sendDMXValues(net, subnet, universe, priority, values.getRawDataPointer());
+						m->dmxDevice->sendDMXValues(net, subnet, universe, priority, (uint8*)data);
 					}
 				}
 			}
@@ -443,24 +515,69 @@ void DMXModule::dmxDataInChanged(DMXDevice*, int net, int subnet, int universe,
 	DMXUniverse* u = getUniverse(true, net, subnet, universe, autoAdd->boolValue());
 	if (u == nullptr) return;
 
-	u->updateValues(values);
+	updateInputUniverse(u, data, numValues);
 
-	if (scriptManager->items.size() > 0)
+	if (scriptsHandleFunction(dmxEventId))
 	{
 		Array<var> args;
 		args.add(net);
 		args.add(subnet);
 		args.add(universe);
-		var data;
-		for (auto& v : values) data.append(v);
-		args.add(data);
+		Array<var> scriptValues;
+		scriptValues.ensureStorageAllocated(numValues);
+		for (int i = 0; i < numValues; i++) scriptValues.add(data[i]);
+		args.add(var(scriptValues));
 		scriptManager->callFunctionOnAllItems(dmxEventId, args);
 	}
 }
 
+//Diffs against the last received frame so only the channels that changed are updated
+void DMXModule::updateInputUniverse(DMXUniverse* u, const uint8* data, int numValues)
+{
+	numValues = jmin(numValues, DMX_NUM_CHANNELS);
+
+	if (inputFramesAreStale.exchange(false))
+	{
+		inputFrameMap.clear();
+		inputFrames.clear();
+	}
+
+	MemoryBlock* frame = inputFrameMap[u];
+	if (frame == nullptr)
+	{
+		frame = inputFrames.add(new MemoryBlock(DMX_NUM_CHANNELS, true));
+		inputFrameMap.set(u, frame);
+
+		frame->copyFrom(data, 0, numValues);
+		u->updateValues(Array<uint8>(data, numValues));
+		return;
+	}
+
+	uint8* previous = (uint8*)frame->getData();
+	if (memcmp(previous, data, numValues) == 0) return;
+
+	for (int i = 0; i < numValues; i++)
+	{
+		if (previous[i] == data[i]) continue;
+		previous[i] = data[i];
+		u->updateValue(i, data[i]);
+	}
+}
+
 DMXUniverse* DMXModule::getUniverse(bool isInput, int net, int subnet, int universe, int priority, bool createIfNotThere)
 {
 	DMXUniverseManager* m = isInput ? &inputUniverseManager : &outputUniverseManager;
+
+	{
+		GenericScopedLock lock(universeIndexLock);
+		HashMap<int, DMXUniverse*>& index = isInput ? inputUniverseIndex : outputUniverseIndex;
+		if (DMXUniverse* u = index[getUniverseKey(net, subnet, universe)])
+		{
+			if (u->checkSignature(net, subnet, universe)) return u;
+		}
+	}
+
+	//Missed or stale index entry (not updated yet after an add or a change) : never create a duplicate without checking the items
 	for (auto& u : m->items) if (u->checkSignature(net, subnet, universe)) return u;
 
 	if (!createIfNotThere) return nullptr;
@@ -474,8 +591,49 @@ DMXUniverse* DMXModule::getUniverse(bool isInput, int net, int subnet, int unive
 	return m->addItem(u);
 }
 
+void DMXModule::updateUniverseIndex()
+{
+	inputFramesAreStale = true;
+
+	GenericScopedLock lock(universeIndexLock);
+
+	inputUniverseIndex.clear();
+	outputUniverseIndex.clear();
+
+	//first universe wins on duplicates, as with the previous linear search
+	for (int i = inputUniverseManager.items.size() - 1; i >= 0; i--)
+	{
+		DMXUniverseItem* u = inputUniverseManager.items[i];
+		inputUniverseIndex.set(getUniverseKey(u->netParam->intValue(), u->subnetParam->intValue(), u->universeParam->intValue()), u);
+	}
+
+	for (int i = outputUniverseManager.items.size() - 1; i >= 0; i--)
+	{
+		DMXUniverseItem* u = outputUniverseManager.items[i];
+		outputUniverseIndex.set(getUniverseKey(u->netParam->intValue(), u->subnetParam->intValue(), u->universeParam->intValue()), u);
+	}
+}
+
+//Avoids building the event arguments when no loaded script declares the callback
+bool DMXModule::scriptsHandleFunction(const Identifier& functionName)
+{
+	for (auto& s : scriptManager->items)
+	{
+		if (s->state != Script::ScriptState::SCRIPT_LOADED || s->scriptEngine == nullptr) continue;
+		if (s->scriptEngine->getRootObjectProperties().contains(functionName)) return true;
+	}
+
+	return false;
+}
+
 void DMXModule::run()
 {
+	{
+		//the device may have changed, start with complete frames
+		ScopedReadLock lock(outputBufferLock);
+		for (auto& b : outputBuffers) b->markAllDirty();
+	}
+
 	while (!threadShouldExit())
 	{
 		double t1 = Time::getMillisecondCounterHiRes();
@@ -484,10 +642,16 @@ void DMXModule::run()
 			if (dmxDevice == nullptr) return;
 
 			bool sendOnChange = sendOnChangeOnly->boolValue();
-			for (auto& u : outputUniverseManager.items)
+
+			ScopedReadLock bufferLock(outputBufferLock);
+			for (auto& b : outputBuffers)
 			{
-				if (sendOnChange && !u->isDirty) continue;
-				dmxDevice->sendDMXValues(u);
+				bool changed = b->publish();
+				if (sendOnChange && !changed) continue;
+				if (b->universeRef.wasObjectDeleted()) continue;
+
+				DMXUniverseItem* u = b->universe;
+				dmxDevice->sendDMXValues(u->netParam->intValue(), u->subnetParam->intValue(), u->universeParam->intValue(), u->priorityParam->intValue(), b->frame);
 				u->isDirty = false;
 			}
 		}
@@ -543,70 +707,76 @@ DMXModule::DMXRouteParams::DMXRouteParams(Module* sourceModule, Controllable* c,
 void DMXModule::handleRoutedModuleValue(Controllable* c, RouteParams* p)
 {
 	if (p == nullptr || c == nullptr) return;
+	handleRoutedModuleValues({ c }, { p }); //same conversion and write path as batches
+}
 
-	if (DMXRouteParams* rp = dynamic_cast<DMXRouteParams*>(p))
-	{
-		DMXUniverse* u = dynamic_cast<DMXUniverse*>(rp->dmxUniverse->targetContainer.get());
+void DMXModule::handleRoutedModuleValues(const Array<Controllable*>& values, const Array<RouteParams*>& params)
+{
+	if (!enabled->boolValue()) return;
 
-		Parameter* sp = c->type == Controllable::TRIGGER ? nullptr : dynamic_cast<Parameter*>(c);
+	struct RoutedDMXValue
+	{
+		DMXUniverse* universe;
+		int channel; //0-based
+		int value;
+		DMXByteOrder byteOrder;
+	};
+
+	Array<RoutedDMXValue> routedValues;
+	for (int i = 0; i < values.size(); i++)
+	{
+		DMXRouteParams* rp = dynamic_cast<DMXRouteParams*>(params[i]);
+		Parameter* sp = values[i] == nullptr || values[i]->type == Controllable::TRIGGER ? nullptr : dynamic_cast<Parameter*>(values[i]);
+		if (rp == nullptr || sp == nullptr) continue;
+		if (sp->type != Parameter::BOOL && sp->type != Parameter::INT && sp->type != Parameter::FLOAT) continue;
 
+		DMXUniverse* u = dynamic_cast<DMXUniverse*>(rp->dmxUniverse->targetContainer.get());
 		bool fullRange = rp->fullRange != nullptr ? rp->fullRange->boolValue() : false;
-
 		DMXByteOrder byteOrder = rp->mode16bit != nullptr ? rp->mode16bit->getValueDataAsEnum<DMXByteOrder>() : DMXByteOrder::BIT8;
 
-		if (sp == nullptr) return;
+		int channel = rp->channel->intValue();
+		if (u == nullptr || channel <= 0 || channel > (byteOrder == BIT8 ? DMX_NUM_CHANNELS : DMX_NUM_CHANNELS - 1)) continue;
 
-		switch (c->type)
-		{
-		case Parameter::BOOL:
-		case Parameter::INT:
-		case Parameter::FLOAT:
-		{
-			int value = (sp->hasRange() ? (float)sp->getNormalizedValue() : sp->floatValue()) * (fullRange ? (byteOrder == BIT8 ? 255 : 65535) : 1);
-
-			if (byteOrder == BIT8) sendDMXValue(u, rp->channel->intValue(), value);
-			else send16BitDMXValue(u, rp->channel->intValue(), value, byteOrder);
-		}
-		break;
-
-		/*case Parameter::POINT2D:
-		{
-			Point<float> pp = ((Point2DParameter*)sp)->getPoint();
-			if (fullRange) pp *= byteOrder != BIT8 ? 65535 : 255;
-
-			Array<int> values;
-			values.add((int)pp.x, (int)pp.y);
+		int value = (sp->hasRange() ? (float)sp->getNormalizedValue() : sp->floatValue()) * (fullRange ? (byteOrder == BIT8 ? 255 : 65535) : 1);
+		routedValues.add({ u, channel - 1, value, byteOrder });
+	}
 
-			if (byteOrder == BIT8) sendDMXValues(u, rp->channel->intValue(), values);
-			else send16BitDMXValues(u, rp->channel->intValue(), values, byteOrder);
-		}
-		break;
+	if (routedValues.isEmpty()) return;
 
-		case Parameter::POINT3D:
+	//grouped by universe and sorted by channel, so each universe buffer is written in one go, in contiguous runs.
+	//Stable, so a channel routed twice keeps the last value
+	std::stable_sort(routedValues.begin(), routedValues.end(), [](const RoutedDMXValue& a, const RoutedDMXValue& b)
 		{
-			Vector3D<float> pp = ((Point3DParameter*)sp)->getVector();
-			if (fullRange) pp *= byteOrder != BIT8 ? 65535 : 255;
+			return a.universe != b.universe ? a.universe < b.universe : a.channel < b.channel;
+		});
 
-			Array<int> values;
-			values.add((int)pp.x, (int)pp.y, (int)pp.z);
+	if (logOutgoingData->boolValue())
+	{
+		const RoutedDMXValue& rv = routedValues.getReference(0);
+		if (routedValues.size() == 1) NLOG(niceName, "Send DMX Channel " << rv.channel + 1 << ", Value " << rv.value << " to " << rv.universe->toString());
+		else NLOG(niceName, "Send DMX batch of " << routedValues.size() << " values");
+	}
+	outActivityTrigger->trigger();
 
-			if (byteOrder == BIT8) sendDMXValues(u, rp->channel->intValue(), values);
-			else send16BitDMXValues(u, rp->channel->intValue(), values, byteOrder);
-		}
-		break;
+	ScopedReadLock lock(outputBufferLock);
+	for (int i = 0; i < routedValues.size();)
+	{
+		DMXUniverse* u = routedValues.getReference(i).universe;
+		DMXUniverseBuffer* b = outputBufferMap[u];
+		DMXUniverseBuffer::ScopedWrite write(b);
 
-		case Parameter::COLOR:
+		for (; i < routedValues.size() && routedValues.getReference(i).universe == u; i++)
 		{
-			Colour col = ((ColorParameter*)sp)->getColor();
-			Array<int> values;
-			values.add(col.getRed(), col.getGreen(), col.getBlue());
-			sendDMXValues(u, rp->channel->intValue(), values);
-		}
-
-		break;*/
-
-		default:
-			break;
+			const RoutedDMXValue& rv = routedValues.getReference(i);
+			if (rv.byteOrder == BIT8)
+			{
+				writeDMXValue(u, b, rv.channel, (uint8)rv.value);
+			}
+			else
+			{
+				writeDMXValue(u, b, rv.channel, rv.byteOrder == MSB ? (rv.value >> 8) & 0xFF : rv.value & 0xFF);
+				writeDMXValue(u, b, rv.channel + 1, rv.byteOrder == MSB ? rv.value & 0xFF : (rv.value >> 8) & 0xFF);
+			}
 		}
 	}
 }
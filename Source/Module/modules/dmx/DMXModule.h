@@ -43,6 +43,28 @@ public:
 	DMXUniverseManager inputUniverseManager;
 	DMXUniverseManager outputUniverseManager;
 
+	//Output frames, one per output universe. The lock only guards the list, channel writes don't lock
+	ReadWriteLock outputBufferLock;
+	OwnedArray<DMXUniverseBuffer> outputBuffers;
+	HashMap<DMXUniverse*, DMXUniverseBuffer*> outputBufferMap;
+
+	void updateOutputBuffers();
+	void writeDMXValue(DMXUniverse* u, DMXUniverseBuffer* b, int channel, uint8 value);
+
+	//net / subnet / universe -> universe, rebuilt when universes are added, removed or edited
+	SpinLock universeIndexLock;
+	HashMap<int, DMXUniverse*> inputUniverseIndex;
+	HashMap<int, DMXUniverse*> outputUniverseIndex;
+
+	static int getUniverseKey(int net, int subnet, int universe) { return (net << 24) | (subnet << 16) | (universe & 0xFFFF); }
+	void updateUniverseIndex();
+
+	//Last frame received for each input universe, only touched by the receiving thread
+	OwnedArray<MemoryBlock> inputFrames;
+	HashMap<DMXUniverse*, MemoryBlock*> inputFrameMap;
+	std::atomic<bool> inputFramesAreStale; //set when universes change, the receiving thread drops the frames on next packet
+	void updateInputUniverse(DMXUniverse* u, const uint8* data, int numValues);
+	bool scriptsHandleFunction(const Identifier& functionName);
 
 	void itemAdded(DMXUniverseItem* i) override;
 	void itemsAdded(Array<DMXUniverseItem*> items) override;
@@ -76,6 +98,7 @@ public:
 	void dmxDeviceSetupChanged(DMXDevice*) override;
 
 	void dmxDataInChanged(DMXDevice*, int net, int subnet, int universe,int priority, Array<uint8> values, const String& sourceName = "") override;
+	void processDMXIn(int net, int subnet, int universe, int priority, const uint8* data, int numValues, const String& sourceName = "");
 
 	DMXUniverse* getUniverse(bool isInput, int net, int subnet, int universe, int priority, bool createIfNotThere = true);
 
@@ -101,6 +124,7 @@ public:
         return new DMXRouteParams(sourceModule, c, outputUniverseManager);
     }
 	virtual void handleRoutedModuleValue(Controllable* c, RouteParams* p) override;
+	virtual void handleRoutedModuleValues(const Array<Controllable*>& values, const Array<RouteParams*>& params) override;
 
 
 	class DMXModuleRouterController :
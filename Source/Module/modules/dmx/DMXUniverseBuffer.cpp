@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+	DMXUniverseBuffer.cpp
+	Created: 18 Oct 2026 4:05:12pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Module/ModuleIncludes.h"
+
+DMXUniverseBuffer::DMXUniverseBuffer(DMXUniverseItem* universe) :
+	universe(universe),
+	universeRef(universe),
+	activeWrites(0),
+	writeGeneration(0)
+{
+	for (auto& v : values) v = 0;
+	zeromem(frame, sizeof(frame));
+	zeromem(staging, sizeof(staging));
+	markAllDirty(); //first publish sends the full frame
+}
+
+void DMXUniverseBuffer::setValue(int channel, uint8 value)
+{
+	if (channel < 0 || channel >= DMX_NUM_CHANNELS) return;
+	if (values[channel].exchange(value, std::memory_order_relaxed) == value) return;
+
+	dirtyBits[channel >> 6].fetch_or((uint64)1 << (channel & 63), std::memory_order_release);
+}
+
+void DMXUniverseBuffer::markAllDirty()
+{
+	for (int i = 0; i < numDirtyWords; i++)
+	{
+		int bitsInWord = jmin(64, DMX_NUM_CHANNELS - i * 64);
+		dirtyBits[i] = bitsInWord == 64 ? ~(uint64)0 : (((uint64)1 << bitsInWord) - 1);
+	}
+}
+
+bool DMXUniverseBuffer::publish()
+{
+	//Writers are never blocked : a copy that overlapped a range write is dropped and retried, the frame keeps its previous values until a clean copy
+	for (int attempt = 0; attempt < 100; attempt++)
+	{
+		if (attempt > 0) Thread::yield();
+		if (activeWrites > 0) continue;
+
+		const uint32 generation = writeGeneration.load();
+
+		bool changed = false;
+		memcpy(staging, frame, sizeof(frame));
+		for (int w = 0; w < numDirtyWords; w++)
+		{
+			uint64 bits = dirtyBits[w].exchange(0, std::memory_order_acquire);
+			takenBits[w] = bits;
+			if (bits == 0) continue;
+
+			changed = true;
+			for (int channel = w * 64; bits != 0; channel++, bits >>= 1)
+			{
+				if (bits & 1) staging[channel] = values[channel].load(std::memory_order_relaxed);
+			}
+		}
+
+		if (!changed) return false;
+
+		std::atomic_thread_fence(std::memory_order_acquire); //values read above can't move after the check
+		if (activeWrites == 0 && writeGeneration.load() == generation)
+		{
+			memcpy(frame, staging, sizeof(frame));
+			return true;
+		}
+
+		//a range was written during the copy, the taken channels are flagged again
+		for (int w = 0; w < numDirtyWords; w++)
+		{
+			if (takenBits[w] != 0) dirtyBits[w].fetch_or(takenBits[w], std::memory_order_release);
+		}
+	}
+
+	return false;
+}
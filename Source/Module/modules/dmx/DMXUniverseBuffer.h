@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+	DMXUniverseBuffer.h
+	Created: 18 Oct 2026 4:05:12pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Double-buffered output frame for one universe, the only path from the senders to the device.
+	Writers store channel values and flag them in a dirty bitset without taking any lock,
+	the send thread copies the flagged channels into a staging frame and publishes it only if no multi-channel write
+	overlapped the copy (seqlock : writeGeneration moves at the end of each ScopedWrite), otherwise the channels stay dirty for the next publish.
+*/
+class DMXUniverseBuffer
+{
+public:
+	DMXUniverseBuffer(DMXUniverseItem* universe);
+	~DMXUniverseBuffer() {}
+
+	static const int numDirtyWords = (DMX_NUM_CHANNELS + 63) / 64;
+
+	DMXUniverseItem* universe;
+	WeakReference<Inspectable> universeRef;
+
+	std::atomic<uint8> values[DMX_NUM_CHANNELS];
+	std::atomic<uint64> dirtyBits[numDirtyWords];
+	std::atomic<int> activeWrites;
+	std::atomic<uint32> writeGeneration;
+
+	uint8 frame[DMX_NUM_CHANNELS]; //published frame, only touched by the send thread
+	uint8 staging[DMX_NUM_CHANNELS];
+	uint64 takenBits[numDirtyWords];
+
+	void setValue(int channel, uint8 value);
+	void markAllDirty();
+	bool publish(); //returns true if at least one channel changed since the last publish, false if nothing changed or a write kept overlapping
+
+	//Keeps a multi-channel write (range, 16-bit value) in a single frame
+	class ScopedWrite
+	{
+	public:
+		ScopedWrite(DMXUniverseBuffer* b) : buffer(b) { if (buffer != nullptr) buffer->activeWrites++; }
+		~ScopedWrite() { if (buffer != nullptr) { buffer->writeGeneration++; buffer->activeWrites--; } }
+		DMXUniverseBuffer* buffer;
+	};
+
+	JUCE_DECLARE_NON_COPYABLE(DMXUniverseBuffer)
+};
@@ -20,21 +20,26 @@
 
 MIDIClockSender::MIDIClockSender() :
 	Thread("Clock Sender"),
-	device(nullptr),
 	bpm(0),
-	waitInterval(0)
+	device(nullptr),
+	syncBeatPhase(0),
+	syncTime(0),
+	hasNewSync(false),
+	anchorTime(0),
+	anchorTick(0),
+	anchorBPM(0),
+	tick(0)
 {
 }
 
 MIDIClockSender::~MIDIClockSender()
 {
+	stopThread(1000);
 }
 
 void MIDIClockSender::setBPM(double newBPM)
 {
-	bpm = newBPM;
-	const int ticksPerBeat = 24;
-	waitInterval = 60000 / (bpm * ticksPerBeat);
+	bpm = jmax(0.0, newBPM);
 }
 
 void MIDIClockSender::setOutDevice(MidiOutput* outDevice)
@@ -46,6 +51,14 @@ void MIDIClockSender::setOutDevice(MidiOutput* outDevice)
 	if (isRunning) start();
 }
 
+void MIDIClockSender::syncPhase(double beatPhase)
+{
+	GenericScopedLock<SpinLock> lock(syncLock);
+	syncBeatPhase = beatPhase - std::floor(beatPhase);
+	syncTime = Time::getMillisecondCounterHiRes();
+	hasNewSync = true;
+}
+
 void MIDIClockSender::start()
 {
 	startThread();
@@ -60,20 +73,170 @@ void MIDIClockSender::run()
 {
 	if (device == nullptr) return;
 
+	{
+		GenericScopedLock<SpinLock> lock(syncLock);
+		hasNewSync = false;
+	}
+
+	tick = 0;
+	anchorTick = 0;
+	anchorBPM = 0;
+
 	device->sendMessageNow(MidiMessage::midiStart());
 	while (!threadShouldExit())
 	{
-		if (bpm == 0)
+		const double currentBPM = bpm.load();
+		if (currentBPM <= 0)
 		{
+			anchorBPM = 0;
 			wait(10);
 			continue;
 		}
 
+		if (currentBPM != anchorBPM)
+		{
+			//New tempo starts from the last sent tick, so the tick interval changes without a phase jump
+			if (anchorBPM > 0 && tick > 0)
+			{
+				anchorTime = getTickTime(tick - 1);
+				anchorTick = tick - 1;
+			}
+			else
+			{
+				anchorTime = Time::getMillisecondCounterHiRes();
+				anchorTick = tick;
+			}
+
+			anchorBPM = currentBPM;
+		}
+
+		applyPhaseSync();
+
+		const double tickTime = getTickTime(tick);
+		const double now = Time::getMillisecondCounterHiRes();
+		const double remaining = tickTime - now;
+
+		if (remaining > spinTimeMS)
+		{
+			//Short sleeps, so tempo and phase changes are taken into account before the next tick
+			wait(jlimit(1, 10, (int)(remaining - spinTimeMS)));
+			continue;
+		}
+
+		if (remaining > 0)
+		{
+			Thread::yield();
+			continue;
+		}
+
+		if (-remaining > getTickPeriod() * maxLateTicks)
+		{
+			//Stalled, restart the timeline from now instead of sending all the late ticks at once
+			anchorTime = now;
+			anchorTick = tick;
+		}
+
 		device->sendMessageNow(MidiMessage::midiClock());
-		wait(waitInterval);
+		tick++;
 	}
 
 	if (Engine::mainEngine->isClearing || device == nullptr)  return;
 	
 	device->sendMessageNow(MidiMessage::midiStop());
 }
+
+void MIDIClockSender::applyPhaseSync()
+{
+	double phase = 0;
+	double time = 0;
+
+	{
+		GenericScopedLock<SpinLock> lock(syncLock);
+		if (!hasNewSync) return;
+		phase = syncBeatPhase;
+		time = syncTime;
+		hasNewSync = false;
+	}
+
+	//Beat position the synced clock will have when our next tick is sent, compared to the position of that tick
+	const double beatMS = getTickPeriod() * ticksPerBeat;
+	const double tickTime = getTickTime(tick);
+	const double targetPhase = phase + (tickTime - time) / beatMS;
+	const double tickPhase = (double)(tick % ticksPerBeat) / ticksPerBeat;
+
+	double error = targetPhase - tickPhase;
+	error -= std::floor(error + .5); //shortest way, -.5 to .5 beat
+
+	//Ahead of the sync (error < 0) delays the ticks, behind brings them earlier, at most a quarter tick each time
+	const double shift = jlimit(-getTickPeriod() * .25, getTickPeriod() * .25, error * beatMS * .2);
+	anchorTime -= shift;
+}
+
+
+MIDIClockFollower::MIDIClockFollower()
+{
+	reset();
+}
+
+void MIDIClockFollower::reset()
+{
+	tickCount = -1;
+	locked = false;
+	acquireStartTick = 0;
+	acquireStartTime = 0;
+	period = 0;
+	tickTime = 0;
+}
+
+void MIDIClockFollower::processTick(double time)
+{
+	tickCount++;
+
+	if (locked)
+	{
+		const double predictedTime = tickTime + period;
+		const double error = time - predictedTime;
+
+		if (std::abs(error) <= period * maxErrorTicks)
+		{
+			tickTime = predictedTime + phaseGain * error;
+			period = jmax(.1, period + periodGain * error);
+			return;
+		}
+
+		//Lost, measure the period again from this tick
+		locked = false;
+		acquireStartTick = tickCount;
+		acquireStartTime = time;
+		return;
+	}
+
+	if (tickCount == 0 || time <= acquireStartTime)
+	{
+		acquireStartTick = tickCount;
+		acquireStartTime = time;
+		return;
+	}
+
+	if (tickCount - acquireStartTick < ticksPerBeat) return;
+
+	period = (time - acquireStartTime) / (tickCount - acquireStartTick);
+	tickTime = time;
+	locked = true;
+}
+
+double MIDIClockFollower::getBPM() const
+{
+	if (!locked || period <= 0) return 0;
+	return 60000.0 / (period * ticksPerBeat);
+}
+
+double MIDIClockFollower::getBeatPhase(double time) const
+{
+	if (!locked || period <= 0) return 0;
+
+	//Don't run past the next tick, so the phase never goes back when it arrives
+	const double ticksSinceLast = jlimit(0.0, .999, (time - tickTime) / period);
+	const double beatTicks = (double)(tickCount % ticksPerBeat) + ticksSinceLast;
+	return beatTicks / ticksPerBeat;
+}
@@ -18,8 +18,12 @@
 
 #pragma once
 
-
-
+/*
+	Sends MIDI Clock from its own thread.
+	Ticks are scheduled on an absolute timeline (anchor time + tick * period, in high resolution ms), so waking up late
+	never accumulates : the next tick is still computed from the anchor. The anchor only moves on tempo change,
+	after a stall, or when the clock is synced to an external beat phase.
+*/
 class MIDIClockSender :
 	public Thread
 {
@@ -27,16 +31,70 @@ public:
 	MIDIClockSender();
 	~MIDIClockSender();
 
-	double bpm;
-	MidiOutput* device;
+	static const int ticksPerBeat = 24;
+	static constexpr double spinTimeMS = 1.5; //last part of the wait is spent yielding instead of sleeping
+	static const int maxLateTicks = 4; //further than that, the timeline restarts from now instead of bursting ticks
 
-	int waitInterval;
+	std::atomic<double> bpm;
+	MidiOutput* device;
 
 	void setBPM(double newBPM);
 	void setOutDevice(MidiOutput* outDevice);
+	void syncPhase(double beatPhase); //position in the beat (0-1) right now, ticks are nudged toward it
 
 	void start();
 	void stop();
 
-	void run();
+	void run() override;
+
+private:
+	SpinLock syncLock;
+	double syncBeatPhase;
+	double syncTime;
+	bool hasNewSync;
+
+	//Clock thread only
+	double anchorTime;
+	int64 anchorTick;
+	double anchorBPM;
+	int64 tick;
+
+	double getTickPeriod() const { return 60000.0 / (anchorBPM * ticksPerBeat); }
+	double getTickTime(int64 t) const { return anchorTime + (t - anchorTick) * getTickPeriod(); }
+	void applyPhaseSync();
+};
+
+/*
+	Follows an incoming MIDI Clock with a phase-locked loop.
+	The first beat of ticks gives the starting period, then each tick corrects the predicted tick time (phase)
+	and the period (tempo) with an alpha-beta filter, so the jitter of the incoming ticks is averaged out.
+	An error of more than a few ticks (tempo jump, clock paused) restarts the acquisition.
+*/
+class MIDIClockFollower
+{
+public:
+	MIDIClockFollower();
+
+	static const int ticksPerBeat = 24;
+	static constexpr double phaseGain = .1; //alpha
+	static constexpr double periodGain = phaseGain * phaseGain / (2 - phaseGain); //beta, critically damped
+	static const int maxErrorTicks = 2;
+
+	void reset(); //on MIDI Start, the next tick is the first tick of a beat
+	void processTick(double time); //ms, Time::getMillisecondCounterHiRes()
+
+	bool isLocked() const { return locked; }
+	bool isBeatStart() const { return tickCount % ticksPerBeat == 0; } //last processed tick starts a beat
+	double getBPM() const;
+	double getBeatPhase(double time) const; //0-1, extrapolated from the loop
+
+private:
+	int64 tickCount; //last processed tick, -1 before the first one
+	bool locked;
+
+	int64 acquireStartTick;
+	double acquireStartTime;
+
+	double period; //ms per tick
+	double tickTime; //filtered time of the last tick
 };
@@ -18,8 +18,7 @@ MIDIModule::MIDIModule(const String& name, bool _useGenericControls) :
 	inputDevice(nullptr),
 	outputDevice(nullptr),
 	tempoCC("Tempo"),
-	lastClockReceiveTime(0),
-	lastClockReceiveTimeIndex(0),
+	clockSyncCC("Clock Sync"),
 	mtcCC("MTC"),
 	infoCC("Infos"),
 	useGenericControls(_useGenericControls)
@@ -31,6 +30,9 @@ MIDIModule::MIDIModule(const String& name, bool _useGenericControls) :
 
 	if (useGenericControls)
 	{
+		valueTable.insertMultiple(0, WeakReference<Parameter>(), valueTableSize);
+		unmappedValues.insertMultiple(0, false, valueTableSize);
+
 		autoAdd = moduleParams.addBoolParameter("Auto Add", "Auto Add MIDI values that are received but not in the list", true);
 		defManager->add(CommandDefinition::createDef(this, "", "Note On", &MIDINoteAndCCCommand::create)->addParam("type", (int)MIDINoteAndCCCommand::NOTE_ON));
 		defManager->add(CommandDefinition::createDef(this, "", "Note Off", &MIDINoteAndCCCommand::create)->addParam("type", (int)MIDINoteAndCCCommand::NOTE_OFF));
@@ -88,12 +90,12 @@ MIDIModule::MIDIModule(const String& name, bool _useGenericControls) :
 	valuesCC.addChildControllableContainer(&infoCC);
 
 	bpm = tempoCC.addFloatParameter("BPM", "BPM detected by the incoming MIDI Clock", 0, 0, 999);
+	beatPhase = tempoCC.addFloatParameter("Beat Phase", "Position in the current beat of the incoming MIDI Clock", 0, 0, 1);
 	sendClock = tempoCC.addBoolParameter("Send Clock", "If checked, send MIDI Clock to the output. If not, receiving incoming MIDI Clock", false);
 	midiStartTrigger = tempoCC.addTrigger("Start", "Clock Start signal");
 	midiStopTrigger = tempoCC.addTrigger("Stop", "Clock Stop signal");
 	midiContinueTrigger = tempoCC.addTrigger("Continue", "Clock Continue signal");
 
-	for (int i = 0; i < 24; i++) clockDeltaTimes[i] = 0;
 	valuesCC.addChildControllableContainer(&tempoCC);
 
 	mtcTime = mtcCC.addFloatParameter("MTC Time", "Time sent by the MTC.", 0, 0);
@@ -106,11 +108,21 @@ MIDIModule::MIDIModule(const String& name, bool _useGenericControls) :
 	thruManager->customUserCreateControllableFunc = &MIDIModule::createThruControllable;
 	moduleParams.addChildControllableContainer(thruManager.get());
 
+	clockSyncTempo = clockSyncCC.addTargetParameter("Tempo Source", "When sending clock, the BPM follows this value, for example the BPM of an Ableton Link module");
+	clockSyncTempo->typesFilter.add(FloatParameter::getTypeStringStatic());
+	clockSyncTempo->typesFilter.add(IntParameter::getTypeStringStatic());
+	clockSyncPhase = clockSyncCC.addTargetParameter("Phase Source", "When sending clock, the ticks are aligned to this progression (0-1), for example the Beat progression of an Ableton Link module");
+	clockSyncPhase->typesFilter.add(FloatParameter::getTypeStringStatic());
+	clockSyncPhaseBeats = clockSyncCC.addIntParameter("Phase Length", "Number of beats the Phase Source goes through from 0 to 1. For Ableton Link, this is the Quantum", 1, 1, 64);
+	moduleParams.addChildControllableContainer(&clockSyncCC);
+
 	setupIOConfiguration(inputDevice != nullptr, outputDevice != nullptr);
 }
 
 MIDIModule::~MIDIModule()
 {
+	if (syncTempoParam != nullptr) syncTempoParam->removeParameterListener(this);
+	if (syncPhaseParam != nullptr) syncPhaseParam->removeParameterListener(this);
 	if (inputDevice != nullptr) inputDevice->removeMIDIInputListener(this);
 	if (outputDevice != nullptr) outputDevice->close();
 }
@@ -246,6 +258,13 @@ void MIDIModule::onControllableFeedbackUpdateInternal(ControllableContainer* cc,
 		updateMIDIDevices();
 	}
 
+	if (useGenericControls)
+	{
+		//values are looked up by a different name now
+		if (c == useHierarchy || c == usePitchForNoteNames || c == octaveShift) clearValueTable();
+		else if (c == autoAdd) clearValueTable(true);
+	}
+
 
 	if (autoFeedback->boolValue())
 	{
@@ -273,9 +292,18 @@ void MIDIModule::onControllableFeedbackUpdateInternal(ControllableContainer* cc,
 		if (sendClock->boolValue())
 		{
 			if (outputDevice != nullptr) outClock.setOutDevice(outputDevice->device.get());
+			if (syncTempoParam != nullptr) bpm->setValue(syncTempoParam->floatValue());
 			outClock.setBPM(bpm->floatValue());
 			outClock.start();
 		}
+		else
+		{
+			inClock.reset();
+		}
+	}
+	else if (c == clockSyncTempo || c == clockSyncPhase)
+	{
+		updateClockSync();
 	}
 
 	if (sendClock->boolValue())
@@ -305,6 +333,44 @@ void MIDIModule::onContainerParameterChangedInternal(Parameter* p)
 	}
 }
 
+void MIDIModule::onExternalParameterValueChanged(Parameter* p)
+{
+	Module::onExternalParameterValueChanged(p);
+
+	if (!sendClock->boolValue()) return;
+
+	if (p == syncTempoParam) bpm->setValue(p->floatValue());
+	else if (p == syncPhaseParam)
+	{
+		//The phase source may span several beats, only the position in the current beat matters for the ticks
+		outClock.syncPhase(p->floatValue() * clockSyncPhaseBeats->intValue());
+	}
+}
+
+void MIDIModule::updateClockSync()
+{
+	Parameter* newTempo = dynamic_cast<Parameter*>(clockSyncTempo->target.get());
+	Parameter* newPhase = dynamic_cast<Parameter*>(clockSyncPhase->target.get());
+
+	if (newTempo != syncTempoParam)
+	{
+		if (syncTempoParam != nullptr) syncTempoParam->removeParameterListener(this);
+		syncTempoParam = newTempo;
+		if (syncTempoParam != nullptr)
+		{
+			syncTempoParam->addParameterListener(this);
+			if (sendClock->boolValue()) bpm->setValue(syncTempoParam->floatValue());
+		}
+	}
+
+	if (newPhase != syncPhaseParam)
+	{
+		if (syncPhaseParam != nullptr) syncPhaseParam->removeParameterListener(this);
+		syncPhaseParam = newPhase;
+		if (syncPhaseParam != nullptr) syncPhaseParam->addParameterListener(this);
+	}
+}
+
 void MIDIModule::updateMIDIDevices()
 {
 	MIDIInputDevice* newInput = nullptr;
@@ -355,14 +421,12 @@ void MIDIModule::noteOnReceived(const int& channel, const int& pitch, const int&
 	if (!enabled->boolValue() && !manualAddMode) return;
 	inActivityTrigger->trigger();
 
-	String noteName = usePitchForNoteNames->boolValue() ? "Pitch " + String(pitch) : MIDIManager::getNoteName(pitch, true, octaveShift->intValue());
-
-	if (logIncomingData->boolValue())  NLOG(niceName, "Note On : " << channel << ", " << noteName << " ( pitch : " + String(pitch) + " ), " << velocity);
+	if (logIncomingData->boolValue())  NLOG(niceName, "Note On : " << channel << ", " << getNoteNameForPitch(pitch) << " ( pitch : " + String(pitch) + " ), " << velocity);
 
 	
 	noteOns.addIfNotAlreadyThere(channel * 128 + pitch);
 
-	if (useGenericControls) updateValue(channel, noteName, velocity, MIDIValueParameter::NOTE_ON, pitch);
+	if (useGenericControls && !updateValueFromTable(channel, MIDIValueParameter::NOTE_ON, pitch, velocity)) updateValue(channel, getNoteNameForPitch(pitch), velocity, MIDIValueParameter::NOTE_ON, pitch);
 
 	//moved after updateValue so "learn" will work on actual notes and CC, not on "last*" parameters.
 	lastChannel->setValue(channel);
@@ -382,11 +446,9 @@ void MIDIModule::noteOffReceived(const int& channel, const int& pitch, const int
 	noteOns.removeAllInstancesOf(channel * 128 + pitch);
 	if (noteOns.isEmpty()) oneNoteOn->setValue(false);
 
-	String noteName = usePitchForNoteNames->boolValue() ? "Pitch " + String(pitch) : MIDIManager::getNoteName(pitch, true, octaveShift->intValue());
-
-	if (logIncomingData->boolValue()) NLOG(niceName, "Note Off : " << channel << ", " << noteName << " ( pitch : " + String(pitch) + " ), " << velocity);
+	if (logIncomingData->boolValue()) NLOG(niceName, "Note Off : " << channel << ", " << getNoteNameForPitch(pitch) << " ( pitch : " + String(pitch) + " ), " << velocity);
 
-	if (useGenericControls) updateValue(channel, noteName, velocity, MIDIValueParameter::NOTE_OFF, pitch);
+	if (useGenericControls && !updateValueFromTable(channel, MIDIValueParameter::NOTE_OFF, pitch, velocity)) updateValue(channel, getNoteNameForPitch(pitch), velocity, MIDIValueParameter::NOTE_OFF, pitch);
 
 	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(noteOffEventId, Array<var>(channel, pitch, velocity));
 
@@ -398,7 +460,7 @@ void MIDIModule::controlChangeReceived(const int& channel, const int& number, co
 	inActivityTrigger->trigger();
 	if (logIncomingData->boolValue()) NLOG(niceName, "Control Change : " << channel << ", " << number << ", " << value);
 
-	if (useGenericControls) updateValue(channel, "CC" + String(number), value, MIDIValueParameter::CONTROL_CHANGE, number);
+	if (useGenericControls && !updateValueFromTable(channel, MIDIValueParameter::CONTROL_CHANGE, number, value)) updateValue(channel, "CC" + String(number), value, MIDIValueParameter::CONTROL_CHANGE, number);
 
 	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(ccEventId, Array<var>(channel, number, value));
 
@@ -410,7 +472,7 @@ void MIDIModule::programChangeReceived(const int& channel, const int& value)
 	inActivityTrigger->trigger();
 	if (logIncomingData->boolValue()) NLOG(niceName, "Program Change : " << channel << ", " << value);
 
-	if (useGenericControls) updateValue(channel, "ProgramChange", value, MIDIValueParameter::PROGRAM_CHANGE, 0);
+	if (useGenericControls && !updateValueFromTable(channel, MIDIValueParameter::PROGRAM_CHANGE, 0, value)) updateValue(channel, "ProgramChange", value, MIDIValueParameter::PROGRAM_CHANGE, 0);
 
 	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(programChangeId, Array<var>(channel, value));
 }
@@ -464,7 +526,7 @@ void MIDIModule::pitchWheelReceived(const int& channel, const int& value)
 	inActivityTrigger->trigger();
 	if (logIncomingData->boolValue()) NLOG(niceName, "Pitch wheel, channel : " << channel << ", value : " << value);
 
-	if (useGenericControls) updateValue(channel, "PitchWheel", value, MIDIValueParameter::PITCH_WHEEL, 0);
+	if (useGenericControls && !updateValueFromTable(channel, MIDIValueParameter::PITCH_WHEEL, 0, value)) updateValue(channel, "PitchWheel", value, MIDIValueParameter::PITCH_WHEEL, 0);
 
 	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(pitchWheelEventId, Array<var>(channel, value));
 }
@@ -475,7 +537,7 @@ void MIDIModule::channelPressureReceived(const int& channel, const int& value)
 	inActivityTrigger->trigger();
 	if (logIncomingData->boolValue()) NLOG(niceName, "Channel Pressure, channel : " << channel << ", value : " << value);
 
-	if (useGenericControls) updateValue(channel, "ChannelPressure", value, MIDIValueParameter::CHANNEL_PRESSURE, 0);
+	if (useGenericControls && !updateValueFromTable(channel, MIDIValueParameter::CHANNEL_PRESSURE, 0, value)) updateValue(channel, "ChannelPressure", value, MIDIValueParameter::CHANNEL_PRESSURE, 0);
 
 	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(channelPressureId, Array<var>(channel, value));
 }
@@ -486,7 +548,7 @@ void MIDIModule::afterTouchReceived(const int& channel, const int& note, const i
 	inActivityTrigger->trigger();
 	if (logIncomingData->boolValue()) NLOG(niceName, "After Touch, channel : " << channel << ", note : " << note << ", value : " << value);
 
-	if (useGenericControls) updateValue(channel, "AfterTouch " + (usePitchForNoteNames->boolValue() ? "Pitch " + String(note) : MIDIManager::getNoteName(note)), value, MIDIValueParameter::AFTER_TOUCH, note);
+	if (useGenericControls && !updateValueFromTable(channel, MIDIValueParameter::AFTER_TOUCH, note, value)) updateValue(channel, "AfterTouch " + (usePitchForNoteNames->boolValue() ? "Pitch " + String(note) : MIDIManager::getNoteName(note)), value, MIDIValueParameter::AFTER_TOUCH, note);
 
 	if (scriptManager->items.size() > 0) scriptManager->callFunctionOnAllItems(afterTouchId, Array<var>(channel, note, value));
 }
@@ -519,42 +581,15 @@ void MIDIModule::midiClockReceived()
 	if (!enabled->boolValue()) return;
 	inActivityTrigger->trigger();
 
-	//if (logIncomingData->boolValue())
-	//{
-	//	NLOG(niceName, "MIDI Clock received");
-	//}
-
+	if (sendClock->boolValue()) return;
 
+	const double t = Time::getMillisecondCounterHiRes();
+	inClock.processTick(t);
+	if (!inClock.isLocked()) return;
 
-	//for (int i = 0; i < 24; i++)
-	//{
-	//	int prev = i == 0 ? 23 : i - 1;
-	//	double diff = lastClockReceiveTimes[i] - lastClockReceiveTimes[prev];
-	//	targetBPM += diff;
-	//	DBG("Target BPM Here (" << i << ") : " << targetBPM);
-	//}
-
-	//DBG("Target BPM end of loop : " << targetBPM);
-	//targetBPM /= 24.0;
-
-	double t = Time::getMillisecondCounterHiRes() / 1000.0;
-	double diff = jmax<double>(0, t - lastClockReceiveTime);
-	clockDeltaTimes[lastClockReceiveTimeIndex] = diff;
-
-	if (lastClockReceiveTimeIndex == 0)
-	{
-		double quarterNoteDiff = 0;
-		for (int i = 0; i < 24; i++) quarterNoteDiff += clockDeltaTimes[i];
-		if (quarterNoteDiff > 0)
-		{
-			double targetBPM = 60.0 / quarterNoteDiff;
-			bpm->setValue(targetBPM);
-		}
-	}
-
-	lastClockReceiveTimeIndex = (lastClockReceiveTimeIndex + 1) % 24;
-	lastClockReceiveTime = t;
-
+	//BPM is only updated once per beat, the loop already smooths it tick after tick
+	if (inClock.isBeatStart()) bpm->setValue(inClock.getBPM());
+	beatPhase->setValue(inClock.getBeatPhase(t));
 }
 
 void MIDIModule::midiStartReceived()
@@ -565,6 +600,7 @@ void MIDIModule::midiStartReceived()
 	{
 		NLOG(niceName, "MIDI Start received");
 	}
+	inClock.reset();
 	midiStartTrigger->trigger();
 }
 
@@ -766,6 +802,7 @@ var MIDIModule::sendMidiMachineControlGotoFromScript(const var::NativeFunctionAr
 void MIDIModule::updateValue(const int& channel, const String& n, const int& val, const MIDIValueParameter::Type& type, const int& pitchOrNumber)
 {
 	ControllableContainer* cParentContainer = &valuesCC;
+	const int tableIndex = getValueTableIndex(channel, type, pitchOrNumber);
 
 	String pName = n;
 
@@ -774,7 +811,11 @@ void MIDIModule::updateValue(const int& channel, const String& n, const int& val
 		ControllableContainer* channelContainer = valuesCC.getControllableContainerByName("Channel " + String(channel), true);
 		if (channelContainer == nullptr)
 		{
-			if (!autoAdd->boolValue()) return;
+			if (!autoAdd->boolValue())
+			{
+				if (!manualAddMode) setValueTableEntry(tableIndex, nullptr);
+				return;
+			}
 
 			channelContainer = new ControllableContainer("Channel " + String(channel));
 			channelContainer->saveAndLoadRecursiveData = true;
@@ -806,7 +847,11 @@ void MIDIModule::updateValue(const int& channel, const String& n, const int& val
 		ControllableContainer* typeContainer = channelContainer->getControllableContainerByName(typeName, true);
 		if (typeContainer == nullptr)
 		{
-			if (!autoAdd->boolValue()) return;
+			if (!autoAdd->boolValue())
+			{
+				if (!manualAddMode) setValueTableEntry(tableIndex, nullptr);
+				return;
+			}
 
 			typeContainer = new ControllableContainer(typeName);
 			typeContainer->saveAndLoadRecursiveData = true;
@@ -841,6 +886,64 @@ void MIDIModule::updateValue(const int& channel, const String& n, const int& val
 		p->setValue(val);
 	}
 
+	if (p != nullptr || !manualAddMode) setValueTableEntry(tableIndex, p);
+}
+
+int MIDIModule::getValueTableIndex(int channel, MIDIValueParameter::Type type, int pitchOrNumber) const
+{
+	if (valueTable.isEmpty() || channel < 1 || channel > 16 || !isPositiveAndBelow(pitchOrNumber, 128)) return -1;
+	if (type == MIDIValueParameter::NOTE_OFF) type = MIDIValueParameter::NOTE_ON; //same value for both
+	return ((channel - 1) * MIDIValueParameter::TYPE_MAX + type) * 128 + pitchOrNumber;
+}
+
+bool MIDIModule::updateValueFromTable(int channel, MIDIValueParameter::Type type, int pitchOrNumber, int val)
+{
+	if (manualAddMode) return false;
+
+	const int index = getValueTableIndex(channel, type, pitchOrNumber);
+	if (index == -1) return false;
+
+	Parameter* p = nullptr;
+	{
+		const SpinLock::ScopedLockType sl(valueTableLock);
+		if (unmappedValues.getUnchecked(index)) return true;
+		p = valueTable.getReference(index).get();
+	}
+
+	if (p == nullptr) return false; //never looked up, or removed since
+	p->setValue(val);
+	return true;
+}
+
+void MIDIModule::setValueTableEntry(int index, Parameter* p)
+{
+	if (index == -1) return;
+
+	const SpinLock::ScopedLockType sl(valueTableLock);
+	valueTable.getReference(index) = p;
+	unmappedValues.set(index, p == nullptr);
+}
+
+void MIDIModule::clearValueTable(bool unmappedOnly)
+{
+	if (valueTable.isEmpty()) return;
+
+	const SpinLock::ScopedLockType sl(valueTableLock);
+	unmappedValues.fill(false);
+	if (!unmappedOnly) valueTable.fill(WeakReference<Parameter>());
+}
+
+String MIDIModule::getNoteNameForPitch(int pitch)
+{
+	return usePitchForNoteNames->boolValue() ? "Pitch " + String(pitch) : MIDIManager::getNoteName(pitch, true, octaveShift->intValue());
+}
+
+void MIDIModule::childStructureChanged(ControllableContainer* cc)
+{
+	Module::childStructureChanged(cc);
+
+	//a value may have been added where an unmapped one was searched, removed values are handled by the weak references
+	clearValueTable(true);
 }
 
 void MIDIModule::showMenuAndCreateValue(ControllableContainer* container)
@@ -1006,44 +1109,80 @@ void MIDIModule::MIDIRouteParams::onContainerParameterChanged(Parameter* p)
 void MIDIModule::handleRoutedModuleValue(Controllable* c, RouteParams* p)
 {
 	if (c == nullptr || p == nullptr) return;
+	handleRoutedModuleValues({ c }, { p }); //same conversion and send path as batches
+}
 
-	if (MIDIRouteParams* mp = dynamic_cast<MIDIRouteParams*>(p))
+void MIDIModule::handleRoutedModuleValues(const Array<Controllable*>& values, const Array<RouteParams*>& params)
+{
+	if (!enabled->boolValue()) return;
+	if (outputDevice == nullptr) return;
+
+	Array<MidiMessage> messages;
+	for (int i = 0; i < values.size(); i++)
 	{
-		if (mp->type == nullptr) return;
+		MidiMessage m;
+		if (MIDIRouteParams* mp = dynamic_cast<MIDIRouteParams*>(params[i]))
+		{
+			if (getRoutedMessage(values[i], mp, m)) messages.add(m);
+		}
+	}
 
-		MIDIManager::MIDIEventType t = mp->type->getValueDataAsEnum<MIDIManager::MIDIEventType>();
+	if (messages.isEmpty()) return;
 
-		int value = 0;
+	//kept in routing order, a note off and a note on of the same note must not be swapped
+	MidiBuffer buffer;
+	for (auto& m : messages) buffer.addEvent(m, 0);
 
-		Parameter* sp = c->type == Controllable::TRIGGER ? nullptr : dynamic_cast<Parameter*>(c);
-		if (sp != nullptr)
-		{
-			if (sp->hasRange()) value = (float)sp->getNormalizedValue() * 127;
-			else value = jlimit(0, 127, sp->intValue());
-		}
+	if (logOutgoingData->boolValue())
+	{
+		if (messages.size() == 1) NLOG(niceName, "Send MIDI : " << messages[0].getDescription());
+		else NLOG(niceName, "Send MIDI batch of " << messages.size() << " messages");
+	}
+	outActivityTrigger->trigger();
 
-		switch (t)
-		{
-		case MIDIManager::NOTE_ON:
-			sendNoteOn(mp->channel->intValue(), mp->pitchOrNumber->intValue(), value);
-			break;
+	outputDevice->sendMessages(buffer);
+}
 
-		case MIDIManager::NOTE_OFF:
-			sendNoteOff(mp->channel->intValue(), mp->pitchOrNumber->intValue());
-			break;
+bool MIDIModule::getRoutedMessage(Controllable* c, MIDIRouteParams* mp, MidiMessage& message)
+{
+	if (c == nullptr || mp == nullptr || mp->type == nullptr) return false;
 
-		case MIDIManager::CONTROL_CHANGE:
-			sendControlChange(mp->channel->intValue(), mp->pitchOrNumber->intValue(), value);
-			break;
+	int value = 0;
+	Parameter* sp = c->type == Controllable::TRIGGER ? nullptr : dynamic_cast<Parameter*>(c);
+	if (sp != nullptr)
+	{
+		if (sp->hasRange()) value = (float)sp->getNormalizedValue() * 127;
+		else value = jlimit(0, 127, sp->intValue());
+	}
 
-		case MIDIManager::PITCH_WHEEL:
-			sendPitchWheel(mp->channel->intValue(), value);
-			break;
+	const int channel = mp->channel->intValue();
+	const int number = mp->pitchOrNumber->intValue();
 
-		default:
-			break;
-		}
+	switch (mp->type->getValueDataAsEnum<MIDIManager::MIDIEventType>())
+	{
+	case MIDIManager::NOTE_ON:
+		if (number < 0) return false;
+		message = MidiMessage::noteOn(channel, number, (uint8)value);
+		return true;
+
+	case MIDIManager::NOTE_OFF:
+		if (number < 0) return false;
+		message = MidiMessage::noteOff(channel, number);
+		return true;
+
+	case MIDIManager::CONTROL_CHANGE:
+		message = MidiMessage::controllerEvent(channel, number, value);
+		return true;
+
+	case MIDIManager::PITCH_WHEEL:
+		message = MidiMessage::pitchWheel(channel, value);
+		return true;
+
+	default:
+		break;
 	}
+
+	return false;
 }
 
 MIDIModule::MIDIModuleRouterController::MIDIModuleRouterController(ModuleRouter* router) :
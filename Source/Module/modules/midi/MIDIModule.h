@@ -86,11 +86,17 @@ public:
 	Trigger* midiContinueTrigger;
 
 	FloatParameter* bpm;
+	FloatParameter* beatPhase;
 	BoolParameter* sendClock;
 	MIDIClockSender outClock;
-	double lastClockReceiveTime;
-	double clockDeltaTimes[24];
-	int lastClockReceiveTimeIndex;
+	MIDIClockFollower inClock;
+
+	ControllableContainer clockSyncCC;
+	TargetParameter* clockSyncTempo;
+	TargetParameter* clockSyncPhase;
+	IntParameter* clockSyncPhaseBeats;
+	WeakReference<Parameter> syncTempoParam;
+	WeakReference<Parameter> syncPhaseParam;
 
 	ControllableContainer mtcCC;
 	FloatParameter* mtcTime;
@@ -152,7 +158,9 @@ public:
 
 	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 	virtual void onContainerParameterChangedInternal(Parameter* p) override;
+	void onExternalParameterValueChanged(Parameter* p) override;
 	void updateMIDIDevices();
+	void updateClockSync();
 
 	virtual void noteOnReceived(const int& channel, const int& pitch, const int& velocity) override;
 	virtual void noteOffReceived(const int& channel, const int& pitch, const int& velocity) override;
@@ -193,6 +201,21 @@ public:
 
 	void updateValue(const int& channel, const String& n, const int& val, const MIDIValueParameter::Type& type, const int& pitchOrNumber);
 
+	//Generic values lookup, [channel - 1][type][pitch or number], filled as values are found or created by name.
+	//Known and unmapped messages then skip all the name building and searching
+	static const int valueTableSize = 16 * MIDIValueParameter::TYPE_MAX * 128;
+	SpinLock valueTableLock;
+	Array<WeakReference<Parameter>> valueTable;
+	Array<bool> unmappedValues; //not found while auto add was off
+
+	int getValueTableIndex(int channel, MIDIValueParameter::Type type, int pitchOrNumber) const; //-1 if not in the table
+	bool updateValueFromTable(int channel, MIDIValueParameter::Type type, int pitchOrNumber, int val); //false if updateValue has to be called
+	void setValueTableEntry(int index, Parameter* p);
+	void clearValueTable(bool unmappedOnly = false);
+	String getNoteNameForPitch(int pitch);
+
+	void childStructureChanged(ControllableContainer* cc) override;
+
 	static void showMenuAndCreateValue(ControllableContainer* container);
 	static void createThruControllable(ControllableContainer* cc);
 
@@ -213,6 +236,8 @@ public:
 
 	virtual RouteParams* createRouteParamsForSourceValue(Module* sourceModule, Controllable* c, int /*index*/) override { return new MIDIRouteParams(sourceModule, c); }
 	virtual void handleRoutedModuleValue(Controllable* c, RouteParams* p) override;
+	virtual void handleRoutedModuleValues(const Array<Controllable*>& values, const Array<RouteParams*>& params) override;
+	bool getRoutedMessage(Controllable* c, MIDIRouteParams* mp, MidiMessage& message);
 
 	class MIDIModuleRouterController :
 		public ModuleRouterController
@@ -14,6 +14,9 @@ OSCModule::OSCModule(const String& name, int defaultLocalPort, int defaultRemote
 	Module(name),
 	Thread("OSCZeroconf"),
 	localPort(nullptr),
+	maxQueueSize(nullptr),
+	overflowPolicy(nullptr),
+	coalesceMessages(nullptr),
 	defaultRemotePort(defaultRemotePort),
 	servus("_osc._udp"),
 	receiveCC(nullptr)
@@ -33,6 +36,28 @@ OSCModule::OSCModule(const String& name, int defaultLocalPort, int defaultRemote
 		localPort = receiveCC->addIntParameter("Local Port", "Local Port to bind to receive OSC Messages", defaultLocalPort, 1, 65535);
 		localPort->warningResolveInspectable = this;
 
+		maxQueueSize = receiveCC->addIntParameter("Max Queue Size", "Maximum number of received messages waiting to be processed. When the queue is full, the overflow policy is applied.", 4096, 16, 100000);
+		overflowPolicy = receiveCC->addEnumParameter("Overflow Policy", "What to do when a message is received and the queue is full.\nDrop Newest will ignore the incoming message, Drop Oldest will discard the oldest waiting message.");
+		overflowPolicy->addOption("Drop Newest", OSCReceivePipeline::DROP_NEWEST)->addOption("Drop Oldest", OSCReceivePipeline::DROP_OLDEST);
+		coalesceMessages = receiveCC->addBoolParameter("Coalesce Messages", "If checked, a message received while another one with the same address is still waiting will replace it. Messages without arguments are never coalesced.", false);
+
+		receiveStatsCC.reset(new ControllableContainer("Receive Stats"));
+		queueDepth = receiveStatsCC->addIntParameter("Queue Depth", "Number of received messages waiting to be processed", 0, 0);
+		droppedMessages = receiveStatsCC->addIntParameter("Dropped Messages", "Number of messages dropped because the queue was full", 0, 0);
+		coalescedMessages = receiveStatsCC->addIntParameter("Coalesced Messages", "Number of messages replaced by a newer one with the same address", 0, 0);
+		queueLatency = receiveStatsCC->addFloatParameter("Queue Latency", "Average time in ms between reception and processing of a message", 0, 0);
+		maxQueueLatency = receiveStatsCC->addFloatParameter("Max Queue Latency", "Maximum time in ms between reception and processing of a message", 0, 0);
+		processTime = receiveStatsCC->addFloatParameter("Process Time", "Average time in ms spent processing a message (values, pass-through and scripts)", 0, 0);
+		for (auto& c : receiveStatsCC->controllables)
+		{
+			c->setControllableFeedbackOnly(true);
+			c->isSavable = false;
+		}
+		resetStats = receiveStatsCC->addTrigger("Reset Stats", "Reset dropped, coalesced and max latency counters");
+		receiveCC->addChildControllableContainer(receiveStatsCC.get());
+
+		receivePipeline.reset(new OSCReceivePipeline(this));
+
 		receiver.registerFormatErrorHandler(&OSCHelpers::logOSCFormatError);
 		receiver.addListener(this);
 
@@ -85,6 +110,7 @@ OSCModule::OSCModule(const String& name, int defaultLocalPort, int defaultRemote
 OSCModule::~OSCModule()
 {
 	receiver.disconnect();
+	if (receivePipeline != nullptr) receivePipeline->stopThread(1000);
 
 	if (isThreadRunning())
 	{
@@ -109,6 +135,7 @@ void OSCModule::setupReceiver()
 	if (result)
 	{
 		NLOG(niceName, "Now receiving on port : " + localPort->stringValue());
+		if (receivePipeline != nullptr && !receivePipeline->isThreadRunning()) receivePipeline->startThread();
 		if (!isThreadRunning() && !Engine::mainEngine->isLoadingFile) startThread();
 
 		Array<IPAddress> ad;
@@ -135,6 +162,13 @@ void OSCModule::setupReceiver()
 
 }
 
+void OSCModule::receiveMessage(const OSCMessage& msg)
+{
+	//called from the socket threads, hand over to the worker when it's running
+	if (receivePipeline != nullptr && receivePipeline->isThreadRunning()) receivePipeline->pushMessage(msg);
+	else processMessage(msg);
+}
+
 void OSCModule::processMessage(const OSCMessage& msg)
 {
 	if (logIncomingData->boolValue())
@@ -193,6 +227,18 @@ void OSCModule::processMessage(const OSCMessage& msg)
 
 }
 
+void OSCModule::updateReceiveStats()
+{
+	if (receivePipeline == nullptr || receiveStatsCC == nullptr) return;
+
+	queueDepth->setValue(receivePipeline->queueDepth.load());
+	droppedMessages->setValue(receivePipeline->numDropped.load());
+	coalescedMessages->setValue(receivePipeline->numCoalesced.load());
+	queueLatency->setValue(receivePipeline->queueLatency.load());
+	maxQueueLatency->setValue(receivePipeline->maxQueueLatency.load());
+	processTime->setValue(receivePipeline->processTime.load());
+}
+
 void OSCModule::setupModuleFromJSONData(var data)
 {
 	Module::setupModuleFromJSONData(data);
@@ -237,12 +283,26 @@ void OSCModule::sendOSC(const OSCMessage& msg)
 	sendOSC(msg, "");
 }
 
+void OSCModule::sendOSC(OSCMessage&& msg)
+{
+	if (!prepareOutgoingMessage(msg)) return;
+	sendToOutputs(std::move(msg));
+}
+
 void OSCModule::sendOSC(const OSCMessage& msg, String ip, int port)
 {
-	if (isClearing || outputManager == nullptr) return;
-	if (!enabled->boolValue()) return;
+	if (!prepareOutgoingMessage(msg)) return;
 
-	if (!outputManager->enabled->boolValue()) return;
+	if (ip.isNotEmpty() && port > 0) genericSender.sendToIPAddress(ip, port, msg);
+	else sendToOutputs(OSCMessage(msg)); //the caller keeps its message
+}
+
+bool OSCModule::prepareOutgoingMessage(const OSCMessage& msg)
+{
+	if (isClearing || outputManager == nullptr) return false;
+	if (!enabled->boolValue()) return false;
+
+	if (!outputManager->enabled->boolValue()) return false;
 
 	if (logOutgoingData->boolValue())
 	{
@@ -253,16 +313,33 @@ void OSCModule::sendOSC(const OSCMessage& msg, String ip, int port)
 		}
 	}
 
+	outActivityTrigger->trigger();
+	return true;
+}
+
+void OSCModule::sendToOutputs(OSCMessage&& msg)
+{
+	//each output but the last one gets a copy, the last one takes the message
+	const int numOutputs = outputManager->items.size();
+	for (int i = 0; i < numOutputs - 1; i++) outputManager->items[i]->sendOSC(OSCMessage(msg));
+	if (numOutputs > 0) outputManager->items[numOutputs - 1]->sendOSC(std::move(msg));
+}
+
+void OSCModule::sendOSCBundle(Array<OSCMessage>&& messages)
+{
+	if (messages.isEmpty()) return;
+	if (isClearing || outputManager == nullptr) return;
+	if (!enabled->boolValue()) return;
+
+	if (!outputManager->enabled->boolValue()) return;
+
+	if (logOutgoingData->boolValue()) NLOG(niceName, "Send OSC Bundle : " << messages.size() << " messages, first address " << messages.getReference(0).getAddressPattern().toString());
+
 	outActivityTrigger->trigger();
 
-	if (ip.isNotEmpty() && port > 0)
-	{
-		genericSender.sendToIPAddress(ip, port, msg);
-	}
-	else
-	{
-		for (auto& o : outputManager->items) o->sendOSC(msg);
-	}
+	const int numOutputs = outputManager->items.size();
+	for (int i = 0; i < numOutputs - 1; i++) outputManager->items[i]->sendOSCBundle(Array<OSCMessage>(messages));
+	if (numOutputs > 0) outputManager->items[numOutputs - 1]->sendOSCBundle(std::move(messages));
 }
 
 void OSCModule::setupZeroConf()
@@ -442,6 +519,13 @@ void OSCModule::createThruControllable(ControllableContainer* cc)
 }
 
 
+void OSCModule::clearItem()
+{
+	receiver.disconnect();
+	if (receivePipeline != nullptr) receivePipeline->stopThread(1000);
+	Module::clearItem();
+}
+
 void OSCModule::setupFromManualCreation()
 {
 	if (outputManager != nullptr && outputManager->items.isEmpty())
@@ -486,41 +570,56 @@ void OSCModule::afterLoadJSONDataInternal()
 void OSCModule::handleRoutedModuleValue(Controllable* c, RouteParams* p)
 {
 	if (c == nullptr || p == nullptr) return;
+	handleRoutedModuleValues({ c }, { p }); //same conversion and send path as batches
+}
+
+void OSCModule::handleRoutedModuleValues(const Array<Controllable*>& values, const Array<RouteParams*>& params)
+{
+	Array<OSCMessage> messages;
+	for (int i = 0; i < values.size(); i++)
+	{
+		if (values[i] == nullptr) continue;
+		if (OSCRouteParams* op = dynamic_cast<OSCRouteParams*>(params[i])) createRoutedMessage(values[i], op, messages);
+	}
 
+	if (messages.size() == 1) sendOSC(std::move(messages.getReference(0)));
+	else if (messages.size() > 1) sendOSCBundle(std::move(messages));
+}
 
-	if (OSCRouteParams* op = dynamic_cast<OSCRouteParams*>(p))
+bool OSCModule::createRoutedMessage(Controllable* c, OSCRouteParams* op, Array<OSCMessage>& messages)
+{
+	try
 	{
-		try
+		OSCMessage m(getAddressForRoutedValue(c, op));
+
+		if (c->type != Controllable::TRIGGER)
 		{
-			OSCMessage m(getAddressForRoutedValue(c, op));
+			var v = dynamic_cast<Parameter*>(c)->getValue();
 
-			if (c->type != Controllable::TRIGGER)
+			if (c->type == Parameter::COLOR)
 			{
-				var v = dynamic_cast<Parameter*>(c)->getValue();
-
-				if (c->type == Parameter::COLOR)
-				{
-					m.addArgument(OSCHelpers::getOSCColour(((ColorParameter*)c)->getColor()));
-				}
+				m.addArgument(OSCHelpers::getOSCColour(((ColorParameter*)c)->getColor()));
+			}
+			else
+			{
+				if (!v.isArray())  m.addArgument(OSCHelpers::varToArgument(v, getBoolMode()));
 				else
 				{
-					if (!v.isArray())  m.addArgument(OSCHelpers::varToArgument(v, getBoolMode()));
-					else
-					{
-						for (int i = 0; i < v.size(); ++i) m.addArgument(OSCHelpers::varToArgument(v[i], getBoolMode()));
-					}
+					for (int i = 0; i < v.size(); ++i) m.addArgument(OSCHelpers::varToArgument(v[i], getBoolMode()));
 				}
-
 			}
 
-			sendOSC(m);
-		}
-		catch (const OSCFormatError&)
-		{
-			NLOGERROR(niceName, "Address is invalid : " << op->address->stringValue() << "\nAddresses should always start with a forward slash");
 		}
+
+		messages.add(m);
+		return true;
+	}
+	catch (const OSCFormatError&)
+	{
+		NLOGERROR(niceName, "Address is invalid : " << op->address->stringValue() << "\nAddresses should always start with a forward slash");
 	}
 
+	return false;
 }
 
 String OSCModule::getAddressForRoutedValue(Controllable*, OSCRouteParams* op)
@@ -565,6 +664,23 @@ void OSCModule::onControllableFeedbackUpdateInternal(ControllableContainer* cc,
 	{
 		if (!isCurrentlyLoadingData) setupReceiver();
 	}
+	else if (receivePipeline != nullptr && c == maxQueueSize)
+	{
+		receivePipeline->setMaxQueueSize(maxQueueSize->intValue());
+	}
+	else if (receivePipeline != nullptr && c == overflowPolicy)
+	{
+		receivePipeline->overflowPolicy = overflowPolicy->getValueDataAsEnum<OSCReceivePipeline::OverflowPolicy>();
+	}
+	else if (receivePipeline != nullptr && c == coalesceMessages)
+	{
+		receivePipeline->coalesceByAddress = coalesceMessages->boolValue();
+	}
+	else if (receivePipeline != nullptr && c == resetStats)
+	{
+		receivePipeline->resetStats();
+		updateReceiveStats();
+	}
 	else if (OSCOutput* o = c->getParentAs<OSCOutput>())
 	{
 		if (c == o->listenToOutputFeedback)
@@ -584,7 +700,7 @@ void OSCModule::onControllableFeedbackUpdateInternal(ControllableContainer* cc,
 void OSCModule::oscMessageReceived(const OSCMessage& message)
 {
 	if (!enabled->boolValue()) return;
-	processMessage(message);
+	receiveMessage(message);
 }
 
 void OSCModule::oscBundleReceived(const OSCBundle& bundle)
@@ -592,7 +708,7 @@ void OSCModule::oscBundleReceived(const OSCBundle& bundle)
 	if (!enabled->boolValue()) return;
 	for (auto& m : bundle)
 	{
-		processMessage(m.getMessage());
+		receiveMessage(m.getMessage());
 	}
 }
 
@@ -642,16 +758,29 @@ OSCOutput::OSCOutput() :
 	BaseItem("OSC Output"),
 	Thread("OSC output"),
 	forceDisabled(false),
-	senderIsConnected(false)
+	senderIsConnected(false),
+	messageFifo(queueCapacity),
+	droppedMessages(0),
+	nextBundleId(0),
+	numQueuedBundles(0)
 {
 	isSelectable = false;
 
+	for (int i = 0; i < queueCapacity; i++) messageSlots.add(new OSCMessage("/"));
+	slotBundleIds.insertMultiple(0, 0, queueCapacity);
+
 	useLocal = addBoolParameter("Local", "Send to Local IP (127.0.0.1). Allow to quickly switch between local and remote IP.", true);
 	remoteHost = addStringParameter("Remote Host", "Remote Host to send to.", "127.0.0.1");
 	remoteHost->autoTrim = true;
 	remoteHost->setEnabled(!useLocal->boolValue());
 	remotePort = addIntParameter("Remote port", "Port on which the remote host is listening to", 9000, 1, 65535);
 	listenToOutputFeedback = addBoolParameter("Listen to Feedback", "If checked, this will listen to the (randomly set) bound port of this sender. This is useful when some softwares automatically detect incoming host and port to send back messages.", false);
+	bundleMessages = addBoolParameter("Bundle Messages", "If checked, all messages queued during a bundle interval will be packed into OSC bundles instead of being sent one datagram at a time.", false);
+	bundleInterval = addIntParameter("Bundle Interval", "Time in milliseconds between two bundle sends. Messages queued in between are sent together.", 10, 1, 1000);
+	bundleInterval->setEnabled(bundleMessages->boolValue());
+	maxPacketSize = addIntParameter("Max Packet Size", "Maximum size in bytes of a bundle. Default is sized to fit a standard ethernet MTU without fragmentation.", 1472, 64, 65507);
+	maxPacketSize->setEnabled(bundleMessages->boolValue());
+	onlyLatestValue = addBoolParameter("Only Latest Value", "If checked, when several messages with arguments are queued to the same address, only the most recent one will be sent. Messages without arguments (triggers) are always sent.", false);
 
 	if (!Engine::mainEngine->isLoadingFile) setupSender();
 }
@@ -683,6 +812,11 @@ void OSCOutput::onContainerParameterChangedInternal(Parameter* p)
 	{
 		setupSender();
 	}
+	else if (p == bundleMessages)
+	{
+		bundleInterval->setEnabled(bundleMessages->boolValue());
+		maxPacketSize->setEnabled(bundleMessages->boolValue());
+	}
 }
 
 InspectableEditor* OSCOutput::getEditorInternal(bool isRoot, Array<Inspectable*> inspectables)
@@ -697,10 +831,7 @@ void OSCOutput::setupSender()
 	if (isThreadRunning())
 	{
 		stopThread(1000);
-		// Clear queue
-		const ScopedLock sl(queueLock);
-		while (!messageQueue.empty())
-			messageQueue.pop();
+		clearQueue();
 	}
 
 	senderIsConnected = false;
@@ -737,41 +868,234 @@ void OSCOutput::setupSender()
 	}
 }
 
-void OSCOutput::sendOSC(const OSCMessage& m)
+void OSCOutput::sendOSC(OSCMessage&& m)
+{
+	if (!enabled->boolValue() || forceDisabled || !senderIsConnected) return;
+
+	{
+		const SpinLock::ScopedLockType sl(writeLock);
+
+		int start1, size1, start2, size2;
+		messageFifo.prepareToWrite(1, start1, size1, start2, size2);
+
+		if (size1 + size2 == 0)
+		{
+			droppedMessages++;
+		}
+		else
+		{
+			const int slot = size1 > 0 ? start1 : start2;
+			std::swap(*messageSlots.getUnchecked(slot), m); //the previous slot content is released by the caller
+			slotBundleIds.setUnchecked(slot, 0);
+			messageFifo.finishedWrite(1);
+		}
+	}
+
+	notify();
+}
+
+void OSCOutput::sendOSCBundle(Array<OSCMessage>&& messages)
 {
 	if (!enabled->boolValue() || forceDisabled || !senderIsConnected) return;
 
 	{
-		const ScopedLock sl(queueLock);
-		messageQueue.push(std::make_unique<OSCMessage>(m));
+		const SpinLock::ScopedLockType sl(writeLock);
+
+		//all or nothing, so the output thread can't read only a part of the bundle
+		int start1, size1, start2, size2;
+		messageFifo.prepareToWrite(messages.size(), start1, size1, start2, size2);
+
+		if (size1 + size2 < messages.size())
+		{
+			droppedMessages += messages.size();
+		}
+		else
+		{
+			nextBundleId = nextBundleId % std::numeric_limits<int>::max() + 1; //never 0
+			for (int i = 0; i < size1; i++)
+			{
+				std::swap(*messageSlots.getUnchecked(start1 + i), messages.getReference(i));
+				slotBundleIds.setUnchecked(start1 + i, nextBundleId);
+			}
+			for (int i = 0; i < size2; i++)
+			{
+				std::swap(*messageSlots.getUnchecked(start2 + i), messages.getReference(size1 + i));
+				slotBundleIds.setUnchecked(start2 + i, nextBundleId);
+			}
+			numQueuedBundles++;
+			messageFifo.finishedWrite(messages.size());
+		}
 	}
+
 	notify();
 }
 
 
 void OSCOutput::run()
 {
+	double lastFlushTime = 0;
+
 	while (!Engine::mainEngine->isClearing && !threadShouldExit())
 	{
-		std::unique_ptr<OSCMessage> msgToSend;
+		if (messageFifo.getNumReady() == 0)
+		{
+			wait(1000); // notify() is called when a message is added to the queue
+			continue;
+		}
 
+		//Bundle mode : messages are gathered and flushed once per interval instead of on each notify. Explicit bundles are already complete
+		const double now = Time::getMillisecondCounterHiRes();
+		if (bundleMessages->boolValue() && numQueuedBundles == 0)
 		{
-			const ScopedLock sl(queueLock);
-			if (!messageQueue.empty())
+			const double nextFlushTime = lastFlushTime + bundleInterval->intValue();
+			if (now < nextFlushTime)
 			{
-				msgToSend = std::move(messageQueue.front());
-				messageQueue.pop();
+				wait(jmax(1, (int)(nextFlushTime - now)));
+				continue;
 			}
 		}
 
-		if (msgToSend)
-			sender.send(*msgToSend);
-		else
-			wait(1000); // notify() is called when a message is added to the queue
+		lastFlushTime = now;
+		sendQueuedMessages();
+
+		int numDropped = droppedMessages.exchange(0);
+		if (numDropped > 0) NLOGWARNING(niceName, "Output queue is full, " << numDropped << " messages have been dropped");
+	}
+
+	clearQueue();
+}
+
+void OSCOutput::sendQueuedMessages()
+{
+	int start1, size1, start2, size2;
+	messageFifo.prepareToRead(messageFifo.getNumReady(), start1, size1, start2, size2);
+
+	pendingMessages.clearQuick();
+	pendingBundleIds.clearQuick();
+	for (int i = 0; i < size1; i++)
+	{
+		pendingMessages.add(messageSlots.getUnchecked(start1 + i));
+		pendingBundleIds.add(slotBundleIds.getUnchecked(start1 + i));
+	}
+	for (int i = 0; i < size2; i++)
+	{
+		pendingMessages.add(messageSlots.getUnchecked(start2 + i));
+		pendingBundleIds.add(slotBundleIds.getUnchecked(start2 + i));
+	}
+
+	int numBundles = 0;
+	for (int i = 0; i < pendingBundleIds.size(); i++)
+	{
+		const int id = pendingBundleIds.getUnchecked(i);
+		if (id != 0 && (i == 0 || pendingBundleIds.getUnchecked(i - 1) != id)) numBundles++;
+	}
+
+	if (onlyLatestValue->boolValue())
+	{
+		if (latestIndexMap.size() > queueCapacity * 4) latestIndexMap.clear();
+
+		pendingHashes.clearQuick();
+		for (int i = 0; i < pendingMessages.size(); i++)
+		{
+			OSCMessage* m = pendingMessages.getUnchecked(i);
+			const int64 hash = m->isEmpty() ? 0 : m->getAddressPattern().toString().hashCode64();
+			pendingHashes.add(hash);
+			if (!m->isEmpty()) latestIndexMap.set(hash, i); //triggers are never coalesced
+		}
+
+		//compact in place, a message is skipped if a later one has the same address
+		int numKept = 0;
+		for (int i = 0; i < pendingMessages.size(); i++)
+		{
+			OSCMessage* m = pendingMessages.getUnchecked(i);
+			if (!m->isEmpty())
+			{
+				const int latestIndex = latestIndexMap[pendingHashes.getUnchecked(i)];
+				if (latestIndex != i && pendingMessages.getUnchecked(latestIndex)->getAddressPattern().toString() == m->getAddressPattern().toString()) continue; //same hash is not enough
+			}
+
+			pendingBundleIds.setUnchecked(numKept, pendingBundleIds.getUnchecked(i));
+			pendingMessages.setUnchecked(numKept++, m);
+		}
+
+		pendingMessages.removeLast(pendingMessages.size() - numKept);
+		pendingBundleIds.removeLast(pendingBundleIds.size() - numKept);
+	}
+
+	if (bundleMessages->boolValue())
+	{
+		sendBundled(0, pendingMessages.size());
+	}
+	else
+	{
+		//only the messages queued by the same sendOSCBundle call are grouped
+		for (int i = 0; i < pendingMessages.size();)
+		{
+			const int id = pendingBundleIds.getUnchecked(i);
+			int end = i + 1;
+			if (id != 0) while (end < pendingMessages.size() && pendingBundleIds.getUnchecked(end) == id) end++;
+
+			if (end - i > 1) sendBundled(i, end);
+			else sender.send(*pendingMessages.getUnchecked(i));
+			i = end;
+		}
+	}
+
+	messageFifo.finishedRead(size1 + size2);
+	numQueuedBundles -= numBundles;
+}
+
+void OSCOutput::sendBundled(int start, int end)
+{
+	const int bundleHeaderSize = 16; // "#bundle" + time tag
+	const int maxSize = maxPacketSize->intValue();
+
+	OSCBundle bundle;
+	int bundleSize = bundleHeaderSize;
+
+	for (int i = start; i < end; i++)
+	{
+		const OSCMessage& m = *pendingMessages.getUnchecked(i);
+		const int elementSize = 4 + getEncodedSize(m);
+		if (bundle.size() > 0 && bundleSize + elementSize > maxSize)
+		{
+			if (bundle.size() == 1) sender.send(bundle[0].getMessage());
+			else sender.send(bundle);
+
+			bundle = OSCBundle();
+			bundleSize = bundleHeaderSize;
+		}
+
+		bundle.addElement(OSCBundle::Element(m));
+		bundleSize += elementSize;
+	}
+
+	if (bundle.size() == 1) sender.send(bundle[0].getMessage());
+	else if (bundle.size() > 1) sender.send(bundle);
+}
+
+void OSCOutput::clearQueue()
+{
+	const SpinLock::ScopedLockType sl(writeLock);
+	messageFifo.reset();
+	droppedMessages = 0;
+	numQueuedBundles = 0;
+}
+
+int OSCOutput::getEncodedSize(const OSCMessage& m)
+{
+	//OSC strings are null-terminated and padded to 4 bytes
+	auto getPaddedStringSize = [](int numBytes) { return (numBytes + 4) & ~3; };
+
+	int size = getPaddedStringSize((int)m.getAddressPattern().toString().getNumBytesAsUTF8());
+	size += getPaddedStringSize(1 + m.size()); //type tags
+
+	for (auto& a : m)
+	{
+		if (a.isString()) size += getPaddedStringSize((int)a.getString().getNumBytesAsUTF8());
+		else if (a.isBlob()) size += 4 + (((int)a.getBlob().getSize() + 3) & ~3);
+		else if (a.isInt32() || a.isFloat32() || a.isColour()) size += 4;
 	}
 
-	// Clear queue
-	const ScopedLock sl(queueLock);
-	while (!messageQueue.empty())
-		messageQueue.pop();
+	return size;
 }
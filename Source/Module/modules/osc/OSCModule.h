@@ -29,24 +29,53 @@ public:
 	StringParameter * remoteHost;
 	IntParameter * remotePort;
 	BoolParameter* listenToOutputFeedback;
+	BoolParameter* bundleMessages;
+	IntParameter* bundleInterval;
+	IntParameter* maxPacketSize;
+	BoolParameter* onlyLatestValue;
 	std::unique_ptr<OSCReceiver> receiver;
 	std::unique_ptr<DatagramSocket> socket;
 
 	void setForceDisabled(bool value);
 
 	virtual void setupSender();
-	void sendOSC(const OSCMessage & m);
+	//Messages are swapped into the preallocated slots, nothing is allocated on the calling thread
+	void sendOSC(OSCMessage&& m);
+	void sendOSCBundle(Array<OSCMessage>&& messages); //queued together and sent as bundles even if bundleMessages is off
 
 	virtual void run() override;
+	void sendQueuedMessages();
+	void sendBundled(int start, int end); //pending messages in [start, end[, split in several bundles when above maxPacketSize
+	void clearQueue();
+
+	static int getEncodedSize(const OSCMessage& m);
 
 	void onContainerParameterChangedInternal(Parameter * p) override;
 
 	virtual InspectableEditor * getEditorInternal(bool isRoot, Array<Inspectable*> inspectables = Array<Inspectable*>()) override;
 
 private:
+	static const int queueCapacity = 4096;
+
 	OSCSender sender;
-	std::queue<std::unique_ptr<OSCMessage>> messageQueue;
-	CriticalSection queueLock;
+
+	//Preallocated message slots, written by sendOSC and read by the output thread without locking
+	AbstractFifo messageFifo;
+	OwnedArray<OSCMessage> messageSlots;
+	SpinLock writeLock; //sendOSC can be called from any thread, only serializes the writers
+	std::atomic<int> droppedMessages;
+
+	//Bundle boundaries are stored per slot : 0 for a single message, the same id for all the messages of one sendOSCBundle call
+	Array<int> slotBundleIds;
+	int nextBundleId; //only touched under writeLock
+	std::atomic<int> numQueuedBundles; //explicit bundles are sent right away, even in bundle mode
+
+	//Reused by the output thread on each flush. latestIndexMap is keyed by address hash and only cleared when it grows too big,
+	//so addresses seen before don't allocate a new entry
+	Array<OSCMessage*> pendingMessages;
+	Array<int64> pendingHashes;
+	Array<int> pendingBundleIds;
+	HashMap<int64, int> latestIndexMap;
 };
 
 class OSCModule :
@@ -63,7 +92,21 @@ public:
 
 	//RECEIVE
 	IntParameter * localPort;
+	IntParameter* maxQueueSize;
+	EnumParameter* overflowPolicy;
+	BoolParameter* coalesceMessages;
 	OSCReceiver receiver;
+	std::unique_ptr<OSCReceivePipeline> receivePipeline;
+
+	//Receive stats
+	std::unique_ptr<ControllableContainer> receiveStatsCC;
+	IntParameter* queueDepth;
+	IntParameter* droppedMessages;
+	IntParameter* coalescedMessages;
+	FloatParameter* queueLatency;
+	FloatParameter* maxQueueLatency;
+	FloatParameter* processTime;
+	Trigger* resetStats;
 	OSCSender genericSender;
 	int defaultRemotePort;
 
@@ -80,8 +123,10 @@ public:
 	//RECEIVE
 	virtual void setupReceiver();
 
+	void receiveMessage(const OSCMessage& msg);
 	void processMessage(const OSCMessage & msg);
 	virtual void processMessageInternal(const OSCMessage &) {}
+	void updateReceiveStats();
 
 	virtual void setupModuleFromJSONData(var data) override;
 
@@ -91,7 +136,11 @@ public:
 	//SEND
 	virtual void setupSenders();
 	virtual void sendOSC(const OSCMessage& msg) override;
+	virtual void sendOSC(OSCMessage&& msg) override;
 	virtual void sendOSC(const OSCMessage& msg, String ip, int port = 0);
+	virtual void sendOSCBundle(Array<OSCMessage>&& messages) override;
+	bool prepareOutgoingMessage(const OSCMessage& msg); //false if the module can't send, logs the message otherwise
+	void sendToOutputs(OSCMessage&& msg);
 
 	//ZEROCONF
 	void setupZeroConf();
@@ -106,6 +155,8 @@ public:
 	static void createThruControllable(ControllableContainer* cc);
 
 
+	virtual void clearItem() override;
+
 	//save / load
 	virtual void setupFromManualCreation() override;
 
@@ -124,6 +175,8 @@ public:
 
 	virtual RouteParams * createRouteParamsForSourceValue(Module * sourceModule, Controllable * c, int /*index*/) override { return new OSCRouteParams(sourceModule, c); }
 	virtual void handleRoutedModuleValue(Controllable * c, RouteParams * p) override;
+	virtual void handleRoutedModuleValues(const Array<Controllable*>& values, const Array<RouteParams*>& params) override;
+	bool createRoutedMessage(Controllable* c, OSCRouteParams* op, Array<OSCMessage>& messages); //false if the address is invalid
 	virtual String getAddressForRoutedValue(Controllable* c, OSCRouteParams* op);
 
 	virtual void onContainerParameterChangedInternal(Parameter * p) override;
@@ -0,0 +1,202 @@
+/*
+  ==============================================================================
+
+    OSCReceivePipeline.cpp
+    Created: 18 Oct 2026 11:40:05am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Module/ModuleIncludes.h"
+
+OSCReceivePipeline::OSCReceivePipeline(OSCModule* module) :
+	Thread("OSC Receive"),
+	module(module),
+	maxQueueSize(4096),
+	overflowPolicy(DROP_NEWEST),
+	coalesceByAddress(false),
+	queueDepth(0),
+	numDropped(0),
+	numCoalesced(0),
+	queueLatency(0),
+	maxQueueLatency(0),
+	processTime(0),
+	firstSequence(0)
+{
+}
+
+OSCReceivePipeline::~OSCReceivePipeline()
+{
+	stopThread(1000);
+}
+
+void OSCReceivePipeline::pushMessage(const OSCMessage& m)
+{
+	{
+		GenericScopedLock lock(queueLock);
+
+		const bool canCoalesce = coalesceByAddress && !m.isEmpty(); //never coalesce triggers
+		String address;
+		if (canCoalesce)
+		{
+			address = m.getAddressPattern().toString();
+			if (addressIndexMap.contains(address))
+			{
+				const int64 sequence = addressIndexMap[address];
+				if (sequence >= firstSequence && sequence < firstSequence + incoming.size)
+				{
+					PendingMessage& pm = incoming.get((int)(sequence - firstSequence));
+					if (pm.message.getAddressPattern().toString() == address) //the slot may have been trimmed and reused
+					{
+						pm.message = m;
+						numCoalesced++;
+						return;
+					}
+				}
+			}
+		}
+
+		if (incoming.size >= maxQueueSize && overflowPolicy == DROP_NEWEST)
+		{
+			numDropped++;
+			return;
+		}
+
+		while (incoming.size > 0 && incoming.size >= maxQueueSize)
+		{
+			numDropped++;
+			incoming.popFront();
+			firstSequence++;
+		}
+
+		if (incoming.size == incoming.slots.size()) incoming.grow(jmax(incoming.size + 1, maxQueueSize.load()));
+
+		if (canCoalesce) addressIndexMap.set(address, firstSequence + incoming.size);
+		PendingMessage& pm = incoming.get(incoming.size);
+		pm.message = m;
+		pm.receiveTime = Time::getMillisecondCounterHiRes();
+		incoming.size++;
+		queueDepth = incoming.size;
+	}
+
+	notify();
+}
+
+void OSCReceivePipeline::setMaxQueueSize(int value)
+{
+	GenericScopedLock lock(queueLock);
+	maxQueueSize = value;
+
+	while (incoming.size > maxQueueSize)
+	{
+		numDropped++;
+		if (overflowPolicy == DROP_NEWEST)
+		{
+			incoming.popBack(); //coalescing entries of the dropped messages are checked against the address of their slot
+		}
+		else
+		{
+			incoming.popFront();
+			firstSequence++;
+		}
+	}
+
+	queueDepth = incoming.size;
+}
+
+void OSCReceivePipeline::clearQueue()
+{
+	GenericScopedLock lock(queueLock);
+	firstSequence += incoming.size;
+	incoming.clear();
+	addressIndexMap.clear();
+	queueDepth = 0;
+}
+
+void OSCReceivePipeline::resetStats()
+{
+	numDropped = 0;
+	numCoalesced = 0;
+	queueLatency = 0;
+	maxQueueLatency = 0;
+	processTime = 0;
+}
+
+void OSCReceivePipeline::run()
+{
+	double lastStatsTime = 0;
+
+	while (!threadShouldExit())
+	{
+		{
+			GenericScopedLock lock(queueLock);
+			incoming.swapWith(processing);
+			firstSequence += processing.size;
+			addressIndexMap.clear();
+			queueDepth = 0;
+		}
+
+		if (processing.size > 0)
+		{
+			double latencySum = 0;
+			double maxLatency = maxQueueLatency;
+
+			const double startTime = Time::getMillisecondCounterHiRes();
+			for (int i = 0; i < processing.size; i++)
+			{
+				if (threadShouldExit()) break;
+
+				PendingMessage& pm = processing.get(i);
+
+				const double latency = Time::getMillisecondCounterHiRes() - pm.receiveTime;
+				latencySum += latency;
+				maxLatency = jmax(maxLatency, latency);
+
+				module->processMessage(pm.message);
+			}
+			const double endTime = Time::getMillisecondCounterHiRes();
+
+			queueLatency = (float)(latencySum / processing.size);
+			maxQueueLatency = (float)maxLatency;
+			processTime = (float)((endTime - startTime) / processing.size);
+
+			processing.clear();
+		}
+
+		const double t = Time::getMillisecondCounterHiRes();
+		if (t - lastStatsTime > 200)
+		{
+			module->updateReceiveStats();
+			lastStatsTime = t;
+		}
+
+		if (queueDepth == 0) wait(100); // notify() is called when a message is pushed
+	}
+
+	clearQueue();
+}
+
+
+
+// MessageRing
+
+void OSCReceivePipeline::MessageRing::grow(int capacity)
+{
+	if (slots.size() >= capacity) return;
+
+	Array<PendingMessage> newSlots;
+	newSlots.ensureStorageAllocated(capacity);
+	for (int i = 0; i < size; i++) newSlots.add(get(i));
+	while (newSlots.size() < capacity) newSlots.add(PendingMessage{ OSCMessage("/"), 0 });
+
+	slots.swapWith(newSlots);
+	start = 0;
+}
+
+void OSCReceivePipeline::MessageRing::swapWith(MessageRing& other)
+{
+	slots.swapWith(other.slots);
+	std::swap(start, other.start);
+	std::swap(size, other.size);
+}
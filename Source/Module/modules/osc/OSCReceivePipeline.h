@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    OSCReceivePipeline.h
+    Created: 18 Oct 2026 11:40:05am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class OSCModule;
+
+/*
+	Decouples the OSC socket thread from message processing.
+	Decoded messages are pushed in a bounded queue from the receiving thread,
+	a dedicated worker then dispatches them to the module (values, thru, scripts).
+*/
+class OSCReceivePipeline :
+	public Thread
+{
+public:
+	OSCReceivePipeline(OSCModule* module);
+	~OSCReceivePipeline();
+
+	enum OverflowPolicy { DROP_NEWEST, DROP_OLDEST };
+
+	OSCModule* module;
+
+	std::atomic<int> maxQueueSize;
+	std::atomic<OverflowPolicy> overflowPolicy;
+	std::atomic<bool> coalesceByAddress;
+
+	//Stats, written by the pipeline and read by the module
+	std::atomic<int> queueDepth;
+	std::atomic<int> numDropped;
+	std::atomic<int> numCoalesced;
+	std::atomic<float> queueLatency; //ms, average over the last batch
+	std::atomic<float> maxQueueLatency; //ms, since last stats reset
+	std::atomic<float> processTime; //ms per message, average over the last batch
+
+	void pushMessage(const OSCMessage& m);
+	void setMaxQueueSize(int value); //messages above the new limit are dropped right away, following the overflow policy
+	void clearQueue();
+	void resetStats();
+
+	void run() override;
+
+private:
+	struct PendingMessage
+	{
+		OSCMessage message;
+		double receiveTime;
+	};
+
+	//Preallocated circular buffer, dropping the oldest message is O(1)
+	struct MessageRing
+	{
+		Array<PendingMessage> slots;
+		int start = 0;
+		int size = 0;
+
+		PendingMessage& get(int index) { return slots.getReference((start + index) % slots.size()); }
+		void popFront() { start = (start + 1) % slots.size(); size--; }
+		void popBack() { size--; }
+		void clear() { start = 0; size = 0; }
+		void grow(int capacity); //keeps the order
+		void swapWith(MessageRing& other);
+	};
+
+	CriticalSection queueLock;
+	MessageRing incoming;
+	MessageRing processing;
+	int64 firstSequence; //sequence number of the oldest message in incoming
+	HashMap<String, int64> addressIndexMap; //address -> sequence number of its message in incoming, for coalescing. Entries older than firstSequence are stale
+
+	JUCE_DECLARE_NON_COPYABLE(OSCReceivePipeline)
+};
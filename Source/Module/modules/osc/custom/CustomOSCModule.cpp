@@ -31,6 +31,7 @@ CustomOSCModule::CustomOSCModule() :
 
 	valuesCC.userCanAddControllables = true;
 	valuesCC.customUserCreateControllableFunc = &CustomOSCModule::showMenuAndCreateValue;
+	valuesCC.addControllableContainerListener(this);
 
 }
 
@@ -48,6 +49,9 @@ void CustomOSCModule::processMessageInternal(const OSCMessage& msg)
 {
 	if (autoAdd == nullptr || useHierarchy == nullptr || autoFeedback == nullptr) return;
 
+	//fast path, already known addresses don't need any string work
+	if (processIndexedMessage(msg)) return;
+
 	String cNiceName = msg.getAddressPattern().toString();
 	String cShortName = cNiceName.replaceCharacter('/', '_');
 
@@ -173,56 +177,7 @@ void CustomOSCModule::processMessageInternal(const OSCMessage& msg)
 		for (auto& wc : matchCont)
 		{
 			if (wc == nullptr || wc.wasObjectDeleted()) continue;
-			Controllable* c = wc.get();
-			if (c == nullptr) continue;
-
-			switch (c->type)
-			{
-			case Controllable::TRIGGER:
-				((Trigger*)c)->trigger();
-				break;
-
-			case Controllable::BOOL:
-				((Parameter*)c)->setValue(OSCHelpers::getBoolArg(msg[0])); break;
-				break;
-
-			case Controllable::FLOAT:
-				if (msg.size() >= 1)
-				{
-					FloatParameter* f = (FloatParameter*)c;
-					f->setValue(OSCHelpers::getFloatArg(msg[0]));
-				}
-				break;
-
-			case Controllable::INT:
-				if (msg.size() >= 1)
-				{
-					IntParameter* i = (IntParameter*)c;
-					i->setValue(OSCHelpers::getIntArg(msg[0]));
-				}
-				break;
-
-			case Controllable::STRING:
-				if (msg.size() >= 1) ((StringParameter*)c)->setValue(OSCHelpers::getStringArg(msg[0]));
-				break;
-
-			case Controllable::POINT2D:
-				if (msg.size() >= 2) ((Point2DParameter*)c)->setPoint(OSCHelpers::getFloatArg(msg[0]), OSCHelpers::getFloatArg(msg[1]));
-				break;
-
-			case Controllable::POINT3D:
-				if (msg.size() >= 3) ((Point3DParameter*)c)->setVector(Vector3D<float>(OSCHelpers::getFloatArg(msg[0]), OSCHelpers::getFloatArg(msg[1]), OSCHelpers::getFloatArg(msg[2])));
-				break;
-
-			case Controllable::COLOR:
-				if (msg.size() >= 3) ((ColorParameter*)c)->setColor(Colour((uint8)(OSCHelpers::getFloatArg(msg[0]) * 255), (uint8)(OSCHelpers::getFloatArg(msg[1]) * 255), (uint8)(OSCHelpers::getFloatArg(msg[2]) * 255), msg.size() >= 4 ? OSCHelpers::getFloatArg(msg[3]) : 1));
-				else if (msg.size() > 0 && msg[0].isColour()) ((ColorParameter*)c)->setColor(OSCHelpers::getColourFromOSC(msg[0].getColour()));
-				break;
-
-			default:
-				//not handled
-				break;
-			}
+			if (Controllable* mc = wc.get()) setValueFromMessage(mc, msg);
 		}
 	}
 
@@ -318,49 +273,200 @@ void CustomOSCModule::processMessageInternal(const OSCMessage& msg)
 	}
 }
 
-Array<WeakReference<Controllable>> CustomOSCModule::getMatchingControllables(const OSCAddressPattern& address)
+bool CustomOSCModule::processIndexedMessage(const OSCMessage& msg)
 {
-	GenericScopedLock lock(controllableAddressMap.getLock());
+	if (msg.size() > 1 && splitArgs->boolValue()) return false;
+
+	const OSCAddressPattern& pattern = msg.getAddressPattern();
+	if (!pattern.containsWildcards())
+	{
+		Controllable* c = addressIndex.getControllableForAddress(pattern.toString());
+		if (c == nullptr) return false;
+
+		setValueFromMessage(c, msg);
+		return true;
+	}
 
 	Array<WeakReference<Controllable>> matchCont;
-	HashMap<String, WeakReference<Controllable>, DefaultHashFunctions, CriticalSection>::Iterator it(controllableAddressMap);
-	while (it.next())
+	addressIndex.getMatchingControllables(pattern, matchCont);
+	if (matchCont.isEmpty()) return false;
+
+	for (auto& wc : matchCont)
 	{
-		if (it.getValue().wasObjectDeleted()) continue;
-		try
+		if (wc == nullptr || wc.wasObjectDeleted()) continue;
+		if (Controllable* c = wc.get()) setValueFromMessage(c, msg);
+	}
+
+	return true;
+}
+
+void CustomOSCModule::setValueFromMessage(Controllable* c, const OSCMessage& msg)
+{
+	switch (c->type)
+	{
+	case Controllable::TRIGGER:
+		((Trigger*)c)->trigger();
+		break;
+
+	case Controllable::BOOL:
+		((Parameter*)c)->setValue(OSCHelpers::getBoolArg(msg[0])); break;
+		break;
+
+	case Controllable::FLOAT:
+		if (msg.size() >= 1)
 		{
-			OSCAddress a(it.getKey());
-			if (address.matches(a)) matchCont.add(it.getValue());
+			FloatParameter* f = (FloatParameter*)c;
+			f->setValue(OSCHelpers::getFloatArg(msg[0]));
 		}
-		catch (...)
+		break;
+
+	case Controllable::INT:
+		if (msg.size() >= 1)
 		{
-			DBG("Error trying to match, name " << it.getKey() << " may not be a valid OSC Address");
+			IntParameter* i = (IntParameter*)c;
+			i->setValue(OSCHelpers::getIntArg(msg[0]));
 		}
+		break;
+
+	case Controllable::STRING:
+		if (msg.size() >= 1) ((StringParameter*)c)->setValue(OSCHelpers::getStringArg(msg[0]));
+		break;
+
+	case Controllable::POINT2D:
+		if (msg.size() >= 2) ((Point2DParameter*)c)->setPoint(OSCHelpers::getFloatArg(msg[0]), OSCHelpers::getFloatArg(msg[1]));
+		break;
+
+	case Controllable::POINT3D:
+		if (msg.size() >= 3) ((Point3DParameter*)c)->setVector(Vector3D<float>(OSCHelpers::getFloatArg(msg[0]), OSCHelpers::getFloatArg(msg[1]), OSCHelpers::getFloatArg(msg[2])));
+		break;
+
+	case Controllable::COLOR:
+		if (msg.size() >= 3) ((ColorParameter*)c)->setColor(Colour((uint8)(OSCHelpers::getFloatArg(msg[0]) * 255), (uint8)(OSCHelpers::getFloatArg(msg[1]) * 255), (uint8)(OSCHelpers::getFloatArg(msg[2]) * 255), msg.size() >= 4 ? OSCHelpers::getFloatArg(msg[3]) : 1));
+		else if (msg.size() > 0 && msg[0].isColour()) ((ColorParameter*)c)->setColor(OSCHelpers::getColourFromOSC(msg[0].getColour()));
+		break;
+
+	default:
+		//not handled
+		break;
 	}
+}
 
+Array<WeakReference<Controllable>> CustomOSCModule::getMatchingControllables(const OSCAddressPattern& address)
+{
+	Array<WeakReference<Controllable>> matchCont;
+	addressIndex.getMatchingControllables(address, matchCont);
 	return matchCont;
 }
 
 void CustomOSCModule::updateControllableAddressMap()
 {
-	GenericScopedLock lock(controllableAddressMap.getLock());
-	controllableAddressMap.clear();
-	Array<WeakReference<Controllable>> cont = valuesCC.getAllControllables(true);
-	for (auto& c : cont)
+	//only the values that were added, removed or readdressed change the index
+	addressIndex.beginUpdate();
+	updateAddressesIn(&valuesCC);
+	addressIndex.endUpdate();
+}
+
+String CustomOSCModule::getAddressForValue(Controllable* c)
+{
+	String address = useHierarchy->boolValue() ? c->getControlAddress(&valuesCC) : c->niceName;
+	if (!address.startsWith("/") || address.containsChar(' ')) return String(); //don't add values that are not addresses
+	return address;
+}
+
+void CustomOSCModule::updateAddressFor(Controllable* c)
+{
+	if (c == nullptr) return;
+
+	if (!isControllableInValuesContainer(c))
 	{
-		if (c.wasObjectDeleted()) continue;
-		String address = useHierarchy->boolValue() ? c->getControlAddress(&valuesCC) : c->niceName;
-		if (!address.startsWith("/") || address.containsChar(' ')) continue; //don't add values that are not addresses
-		controllableAddressMap.set(address, c);
+		addressIndex.removeControllable(c);
+		return;
 	}
+
+	c->addControllableListener(this); //for renames, a value may become an address later
+
+	String address = getAddressForValue(c);
+	if (address.isEmpty()) addressIndex.removeControllable(c);
+	else addressIndex.setAddress(c, address);
 }
 
-void CustomOSCModule::childStructureChanged(ControllableContainer* cc)
+void CustomOSCModule::updateAddressesIn(ControllableContainer* cc)
 {
-	ControllableContainer::childStructureChanged(cc);
-	if (!isCurrentlyLoadingData && !hierarchyStructureSwitch)
+	for (auto& c : cc->controllables) updateAddressFor(c);
+
+	for (auto& childCC : cc->controllableContainers)
+	{
+		if (childCC == nullptr) continue;
+		childCC->addControllableContainerListener(this);
+		updateAddressesIn(childCC);
+	}
+}
+
+void CustomOSCModule::removeAddressesIn(ControllableContainer* cc)
+{
+	for (auto& c : cc->controllables) addressIndex.removeControllable(c);
+
+	for (auto& childCC : cc->controllableContainers)
+	{
+		if (childCC != nullptr) removeAddressesIn(childCC);
+	}
+}
+
+void CustomOSCModule::controllableAdded(Controllable* c)
+{
+	OSCModule::controllableAdded(c);
+	if (isCurrentlyLoadingData || hierarchyStructureSwitch) return; //rebuilt at the end
+	if (isControllableInValuesContainer(c)) updateAddressFor(c);
+}
+
+void CustomOSCModule::controllableRemoved(Controllable* c)
+{
+	OSCModule::controllableRemoved(c);
+	addressIndex.removeControllable(c); //nothing to do if it was not indexed
+}
+
+void CustomOSCModule::controllableContainerAdded(ControllableContainer* cc)
+{
+	OSCModule::controllableContainerAdded(cc);
+	if (isCurrentlyLoadingData || hierarchyStructureSwitch) return;
+
+	for (ControllableContainer* p = cc->parentContainer; p != nullptr; p = p->parentContainer)
+	{
+		if (p != &valuesCC) continue;
+		cc->addControllableContainerListener(this);
+		updateAddressesIn(cc);
+		break;
+	}
+}
+
+void CustomOSCModule::controllableContainerRemoved(ControllableContainer* cc)
+{
+	OSCModule::controllableContainerRemoved(cc);
+	removeAddressesIn(cc);
+}
+
+void CustomOSCModule::controllableNameChanged(Controllable* c)
+{
+	if (!isControllableInValuesContainer(c))
+	{
+		OSCModule::controllableNameChanged(c);
+		return;
+	}
+
+	if (!isCurrentlyLoadingData && !hierarchyStructureSwitch) updateAddressFor(c);
+}
+
+void CustomOSCModule::childAddressChanged(ControllableContainer* cc)
+{
+	OSCModule::childAddressChanged(cc);
+	if (isCurrentlyLoadingData || hierarchyStructureSwitch || !useHierarchy->boolValue()) return;
+
+	//a renamed container moves the addresses of its values only
+	for (ControllableContainer* p = cc; p != nullptr; p = p->parentContainer)
 	{
-		updateControllableAddressMap();
+		if (p != &valuesCC) continue;
+		updateAddressesIn(cc);
+		break;
 	}
 }
 
@@ -25,18 +25,32 @@ public:
 	EnumParameter* colorMode;
 	EnumParameter* boolMode;
 
-	HashMap<String, WeakReference<Controllable>, DefaultHashFunctions, CriticalSection> controllableAddressMap;
+	OSCAddressIndex addressIndex;
 	bool hierarchyStructureSwitch;
 
 	OSCHelpers::ColorMode getColorMode() override;
 	OSCHelpers::BoolMode getBoolMode() override;
 
 	void processMessageInternal(const OSCMessage &msg) override;
+	bool processIndexedMessage(const OSCMessage& msg);
+	void setValueFromMessage(Controllable* c, const OSCMessage& msg);
 
 	Array<WeakReference<Controllable>> getMatchingControllables(const OSCAddressPattern& address);
-	void updateControllableAddressMap();
+	void updateControllableAddressMap(); //full rebuild, only after loading or switching hierarchy mode
 
-	void childStructureChanged(ControllableContainer * cc) override;
+	//Values are indexed one by one when they are added, removed or renamed
+	String getAddressForValue(Controllable* c); //empty if the value is not an OSC address
+	void updateAddressFor(Controllable* c);
+	void updateAddressesIn(ControllableContainer* cc); //also listens to the sub-containers, to be notified of their values
+	void removeAddressesIn(ControllableContainer* cc);
+
+	void controllableAdded(Controllable* c) override;
+	void controllableRemoved(Controllable* c) override;
+	void controllableContainerAdded(ControllableContainer* cc) override;
+	void controllableContainerRemoved(ControllableContainer* cc) override;
+	void controllableNameChanged(Controllable* c) override;
+
+	void childAddressChanged(ControllableContainer* cc) override;
 
 	void onControllableFeedbackUpdateInternal(ControllableContainer * cc, Controllable * c) override;
 
@@ -0,0 +1,317 @@
+/*
+  ==============================================================================
+
+    OSCAddressIndex.cpp
+    Created: 18 Oct 2026 10:12:31am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Module/ModuleIncludes.h"
+
+OSCAddressIndex::OSCAddressIndex() :
+	currentMark(0)
+{
+}
+
+OSCAddressIndex::~OSCAddressIndex()
+{
+	clear();
+}
+
+void OSCAddressIndex::clear()
+{
+	GenericScopedLock lock(indexLock);
+	exactMap.clear();
+	entries.clear();
+	root.clear();
+}
+
+void OSCAddressIndex::addAddress(const String& address, Controllable* c)
+{
+	if (c == nullptr || !address.startsWithChar('/')) return;
+
+	GenericScopedLock lock(indexLock);
+	exactMap.set(address, c);
+
+	StringArray segments;
+	segments.addTokens(address.substring(1), "/", "");
+
+	Node* n = &root;
+	for (auto& s : segments) n = n->getOrCreateChild(s);
+	n->controllable = c;
+
+	Entry e;
+	e.address = address;
+	e.updateMark = currentMark;
+	entries.set(c, e);
+}
+
+void OSCAddressIndex::beginUpdate()
+{
+	GenericScopedLock lock(indexLock);
+	currentMark++;
+}
+
+void OSCAddressIndex::setAddress(Controllable* c, const String& address)
+{
+	if (c == nullptr) return;
+
+	GenericScopedLock lock(indexLock);
+	if (entries.contains(c))
+	{
+		Entry& e = entries.getReference(c);
+		//the pointer may belong to a new controllable allocated where a deleted one was, check the stored reference too
+		if (e.address == address && exactMap[address].get() == c)
+		{
+			e.updateMark = currentMark;
+			return;
+		}
+
+		removeAddress(e.address, c);
+		entries.remove(c);
+	}
+
+	addAddress(address, c);
+}
+
+void OSCAddressIndex::endUpdate()
+{
+	GenericScopedLock lock(indexLock);
+
+	Array<Controllable*> staleControllables;
+	for (HashMap<Controllable*, Entry>::Iterator it(entries); it.next();)
+	{
+		if (it.getValue().updateMark != currentMark) staleControllables.add(it.getKey());
+	}
+
+	for (auto& c : staleControllables) removeControllable(c);
+}
+
+void OSCAddressIndex::removeControllable(Controllable* c)
+{
+	GenericScopedLock lock(indexLock);
+	if (!entries.contains(c)) return;
+
+	removeAddress(entries[c].address, c);
+	entries.remove(c);
+}
+
+void OSCAddressIndex::removeAddress(const String& address, Controllable* c)
+{
+	//another controllable may have taken this address since, only remove what still points to c or to a deleted one
+	WeakReference<Controllable> current = exactMap[address];
+	if (current.get() != c && !current.wasObjectDeleted()) return;
+
+	exactMap.remove(address);
+
+	StringArray segments;
+	segments.addTokens(address.substring(1), "/", "");
+
+	Array<Node*> path;
+	Node* n = &root;
+	path.add(n);
+	for (auto& s : segments)
+	{
+		n = n->childMap[s];
+		if (n == nullptr) return;
+		path.add(n);
+	}
+
+	n->controllable = nullptr;
+
+	//prune the branch up to the first node that is still used
+	for (int i = path.size() - 1; i > 0; i--)
+	{
+		Node* node = path[i];
+		if (node->controllable != nullptr || node->children.size() > 0) break;
+		path[i - 1]->removeChild(node);
+	}
+}
+
+Controllable* OSCAddressIndex::getControllableForAddress(const String& address)
+{
+	GenericScopedLock lock(indexLock);
+	WeakReference<Controllable> c = exactMap[address];
+	if (c.wasObjectDeleted()) return nullptr;
+	return c.get();
+}
+
+void OSCAddressIndex::getMatchingControllables(const OSCAddressPattern& pattern, Array<WeakReference<Controllable>>& result)
+{
+	String address = pattern.toString();
+
+	if (!pattern.containsWildcards())
+	{
+		if (Controllable* c = getControllableForAddress(address)) result.add(c);
+		return;
+	}
+
+	StringArray segments;
+	segments.addTokens(address.substring(1), "/", "");
+
+	GenericScopedLock lock(indexLock);
+	collectMatches(&root, segments, 0, result);
+}
+
+int OSCAddressIndex::size()
+{
+	GenericScopedLock lock(indexLock);
+	return exactMap.size();
+}
+
+void OSCAddressIndex::collectMatches(Node* n, const StringArray& segments, int index, Array<WeakReference<Controllable>>& result)
+{
+	if (index == segments.size())
+	{
+		if (n->controllable != nullptr && !n->controllable.wasObjectDeleted()) result.add(n->controllable);
+		return;
+	}
+
+	const String& s = segments.getReference(index);
+
+	if (!segmentHasWildcards(s))
+	{
+		if (Node* child = n->childMap[s]) collectMatches(child, segments, index + 1, result);
+		return;
+	}
+
+	for (auto& child : n->children)
+	{
+		if (matchSegment(s.getCharPointer(), child->segment.getCharPointer())) collectMatches(child, segments, index + 1, result);
+	}
+}
+
+bool OSCAddressIndex::segmentHasWildcards(const String& segment)
+{
+	return segment.containsAnyOf("?*[{");
+}
+
+//OSC 1.0 pattern matching on a single address part : ?, *, [abc], [a-z], [!abc] and {foo,bar}
+bool OSCAddressIndex::matchSegment(String::CharPointerType p, String::CharPointerType n)
+{
+	while (!p.isEmpty())
+	{
+		const juce_wchar pc = p.getAndAdvance();
+
+		switch (pc)
+		{
+		case '?':
+			if (n.isEmpty()) return false;
+			++n;
+			break;
+
+		case '*':
+		{
+			while (*p == '*') ++p;
+			if (p.isEmpty()) return true;
+
+			for (;;)
+			{
+				if (matchSegment(p, n)) return true;
+				if (n.isEmpty()) return false;
+				++n;
+			}
+		}
+
+		case '[':
+		{
+			if (n.isEmpty()) return false;
+			const juce_wchar nc = n.getAndAdvance();
+
+			bool negate = false;
+			if (*p == '!')
+			{
+				negate = true;
+				++p;
+			}
+
+			bool found = false;
+			while (!p.isEmpty() && *p != ']')
+			{
+				const juce_wchar c = p.getAndAdvance();
+				if (*p == '-' && p[1] != ']' && p[1] != 0)
+				{
+					++p;
+					const juce_wchar upper = p.getAndAdvance();
+					if (nc >= jmin(c, upper) && nc <= jmax(c, upper)) found = true;
+				}
+				else if (c == nc) found = true;
+			}
+
+			if (p.isEmpty()) return false; //unterminated range
+			++p;
+
+			if (found == negate) return false;
+			break;
+		}
+
+		case '{':
+		{
+			String::CharPointerType end = p;
+			while (!end.isEmpty() && *end != '}') ++end;
+			if (end.isEmpty()) return false; //unterminated list
+
+			String::CharPointerType rest = end + 1;
+			String::CharPointerType alt = p;
+
+			for (;;)
+			{
+				String::CharPointerType altEnd = alt;
+				while (altEnd != end && *altEnd != ',') ++altEnd;
+
+				String::CharPointerType a = alt;
+				String::CharPointerType nn = n;
+				bool prefixMatch = true;
+				while (a != altEnd)
+				{
+					if (nn.isEmpty() || *a != *nn)
+					{
+						prefixMatch = false;
+						break;
+					}
+					++a;
+					++nn;
+				}
+
+				if (prefixMatch && matchSegment(rest, nn)) return true;
+				if (altEnd == end) return false;
+				alt = altEnd + 1;
+			}
+		}
+
+		default:
+			if (n.isEmpty() || n.getAndAdvance() != pc) return false;
+			break;
+		}
+	}
+
+	return n.isEmpty();
+}
+
+
+
+// Node
+
+OSCAddressIndex::Node* OSCAddressIndex::Node::getOrCreateChild(const String& s)
+{
+	if (Node* existing = childMap[s]) return existing;
+
+	Node* n = children.add(new Node(s));
+	childMap.set(s, n);
+	return n;
+}
+
+void OSCAddressIndex::Node::removeChild(Node* n)
+{
+	childMap.remove(n->segment);
+	children.removeObject(n);
+}
+
+void OSCAddressIndex::Node::clear()
+{
+	childMap.clear();
+	children.clear();
+	controllable = nullptr;
+}
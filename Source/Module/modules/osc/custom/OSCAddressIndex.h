@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    OSCAddressIndex.h
+    Created: 18 Oct 2026 10:12:31am
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Address -> Controllable lookup used by CustomOSCModule.
+	Exact addresses resolve with a single hash lookup, wildcard patterns walk a segment trie
+	so only the branches that can match are tested.
+*/
+class OSCAddressIndex
+{
+public:
+	OSCAddressIndex();
+	~OSCAddressIndex();
+
+	void clear();
+	void addAddress(const String& address, Controllable* c);
+
+	//Incremental update : stamp every current controllable with setAddress between beginUpdate and endUpdate,
+	//only the entries that were added, moved or not stamped anymore touch the trie
+	void beginUpdate();
+	void setAddress(Controllable* c, const String& address);
+	void endUpdate();
+	void removeControllable(Controllable* c);
+
+	Controllable* getControllableForAddress(const String& address);
+	void getMatchingControllables(const OSCAddressPattern& pattern, Array<WeakReference<Controllable>>& result);
+
+	int size();
+
+	static bool matchSegment(String::CharPointerType pattern, String::CharPointerType name);
+	static bool segmentHasWildcards(const String& segment);
+
+private:
+	class Node
+	{
+	public:
+		Node(const String& segment = String()) : segment(segment) {}
+
+		String segment;
+		WeakReference<Controllable> controllable;
+		OwnedArray<Node> children;
+		HashMap<String, Node*> childMap;
+
+		Node* getOrCreateChild(const String& s);
+		void removeChild(Node* n);
+		void clear();
+	};
+
+	struct Entry
+	{
+		String address;
+		uint32 updateMark = 0;
+	};
+
+	CriticalSection indexLock;
+	HashMap<String, WeakReference<Controllable>> exactMap;
+	HashMap<Controllable*, Entry> entries; //pointer only used as a key, never dereferenced
+	uint32 currentMark;
+	Node root;
+
+	void removeAddress(const String& address, Controllable* c);
+
+	void collectMatches(Node* n, const StringArray& segments, int index, Array<WeakReference<Controllable>>& result);
+
+	JUCE_DECLARE_NON_COPYABLE(OSCAddressIndex)
+};
@@ -25,8 +25,8 @@ ReaperTimeCommand::~ReaperTimeCommand()
 
 void ReaperTimeCommand::triggerInternal(int multiplexIndex)
 {
-	if (stopTimePlay->boolValue()) oscModule->sendOSC(OSCMessage("/stop"));
+	if (stopTimePlay->boolValue()) sendMessage(OSCMessage("/stop"));
 	OSCCommand::triggerInternal(multiplexIndex);
-	if (stopTimePlay->boolValue()) oscModule->sendOSC(OSCMessage("/play"));
+	if (stopTimePlay->boolValue()) sendMessage(OSCMessage("/play"));
 	
 }
@@ -30,6 +30,8 @@ StateManager::StateManager() :
 	Engine::mainEngine->addEngineListener(this);
 
 	scriptObject.getDynamicObject()->setMethod("addTransition", &StateManager::addTransitionFromScript);
+	scriptObject.getDynamicObject()->setMethod("getLinkedStates", &StateManager::getLinkedStatesFromScript);
+	scriptObject.getDynamicObject()->setMethod("areStatesLinked", &StateManager::areStatesLinkedFromScript);
 
 	setHasGridOptions(true);
 }
@@ -49,15 +51,16 @@ void StateManager::clear()
 
 void StateManager::setStateActive(State* s)
 {
-	Array<State*> linkedStates = getLinkedStates(s);
+	Array<State*> linkedStates = stm.getStatesInComponentOf(s);
 	for (auto& ss : linkedStates)
 	{
-		ss->active->setValue(false);
+		if (ss != s) ss->active->setValue(false);
 	}
 }
 
 void StateManager::addItemInternal(State* s, var data)
 {
+	stm.stateAdded(s);
 	s->addStateListener(this);
 	if (!Engine::mainEngine->isLoadingFile)
 	{
@@ -68,6 +71,7 @@ void StateManager::addItemInternal(State* s, var data)
 void StateManager::removeItemInternal(State* s)
 {
 	s->removeStateListener(this);
+	stm.invalidateComponents();
 
 	Array<State*> avoid;
 	avoid.add(s);
@@ -377,24 +381,13 @@ PopupMenu StateManager::getToggleConditionMenuForConditionManager(ConditionManag
 
 Array<State*> StateManager::getLinkedStates(State* s, Array<State*>* statesToAvoid)
 {
-	Array<State*> sAvoid;
-	if (statesToAvoid == nullptr)
-	{
-		statesToAvoid = &sAvoid;
-	}
-
-	statesToAvoid->add(s);
-
 	Array<State*> result;
 
-	Array<State*> linkStates = stm.getAllStatesLinkedTo(s);
-	for (auto& ss : linkStates)
+	Array<State*> componentStates = stm.getStatesInComponentOf(s);
+	for (auto& ss : componentStates)
 	{
-		if (statesToAvoid->contains(ss)) continue;
+		if (ss == s || (statesToAvoid != nullptr && statesToAvoid->contains(ss))) continue;
 		result.add(ss);
-		statesToAvoid->add(ss);
-		Array<State*> linkedSS = getLinkedStates(ss, statesToAvoid);
-		result.addArray(linkedSS);
 	}
 
 	return result;
@@ -418,6 +411,32 @@ var StateManager::addTransitionFromScript(const var::NativeFunctionArgs& a)
 	return t->scriptObject;
 }
 
+var StateManager::getLinkedStatesFromScript(const var::NativeFunctionArgs& a)
+{
+	var result = var(Array<var>());
+	if (a.numArguments != 1) return result;
+
+	StateManager* sm = StateManager::getInstance();
+	State* s = sm->getItemWithName(a.arguments[0].toString(), true);
+	if (s == nullptr) return result;
+
+	Array<State*> linkedStates = sm->getLinkedStates(s);
+	for (auto& ls : linkedStates) result.append(ls->getScriptObject());
+	return result;
+}
+
+var StateManager::areStatesLinkedFromScript(const var::NativeFunctionArgs& a)
+{
+	if (a.numArguments != 2) return false;
+
+	StateManager* sm = StateManager::getInstance();
+	State* s1 = sm->getItemWithName(a.arguments[0].toString(), true);
+	State* s2 = sm->getItemWithName(a.arguments[1].toString(), true);
+	if (s1 == nullptr || s2 == nullptr) return false;
+
+	return sm->stm.areStatesLinked(s1, s2);
+}
+
 
 var StateManager::getJSONData()
 {
@@ -435,6 +454,7 @@ void StateManager::loadJSONDataManagerInternal(var data)
 	BaseManager::loadJSONDataManagerInternal(data);
 
 	stm.loadJSONData(data.getProperty(stm.shortName, var()));
+	stm.invalidateComponents();
 	commentManager.loadJSONData(data.getProperty(commentManager.shortName, var()));
 
 	for (auto& s : items)
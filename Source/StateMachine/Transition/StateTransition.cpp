@@ -53,6 +53,8 @@ void StateTransition::loadJSONDataInternal(var data)
 	destState = StateManager::getInstance()->getItemWithName(data.getProperty("destState", ""));
 	if (sourceState != nullptr) sourceState->outTransitions.add(this);
 	if (destState != nullptr) destState->inTransitions.add(this);
+
+	StateManager::getInstance()->stm.invalidateComponents();
 }
 
 void StateTransition::triggerConsequences(bool triggerTrue, int iterationIndex)
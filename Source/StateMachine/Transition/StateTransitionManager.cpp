@@ -13,7 +13,9 @@
 
 StateTransitionManager::StateTransitionManager(StateManager* _sm) :
 	BaseManager("Transitions"),
-	sm(_sm)
+	sm(_sm),
+	nextComponentID(0),
+	componentsAreDirty(true)
 {
 
 }
@@ -62,6 +64,31 @@ StateTransition* StateTransitionManager::createItem()
 	return nullptr;
 }
 
+void StateTransitionManager::addItemInternal(StateTransition* t, var data)
+{
+	if (t->sourceState == nullptr || t->destState == nullptr) return; //set when loading, components are recomputed after
+
+	t->sourceState->outTransitions.addIfNotAlreadyThere(t);
+	t->destState->inTransitions.addIfNotAlreadyThere(t);
+
+	GenericScopedLock lock(componentsLock);
+	if (componentsAreDirty) return;
+
+	int sourceComponent = getComponentID(t->sourceState);
+	int destComponent = getComponentID(t->destState);
+	if (sourceComponent == -1 || destComponent == -1) invalidateComponents();
+	else if (sourceComponent != destComponent) mergeComponents(sourceComponent, destComponent);
+}
+
+void StateTransitionManager::removeItemInternal(StateTransition* t)
+{
+	//unlink now so listeners of the removal already see the new graph
+	if (t->sourceState != nullptr && !t->sourceState.wasObjectDeleted()) t->sourceState->outTransitions.removeAllInstancesOf(t);
+	if (t->destState != nullptr && !t->destState.wasObjectDeleted()) t->destState->inTransitions.removeAllInstancesOf(t);
+
+	invalidateComponents();
+}
+
 Array<State*> StateTransitionManager::getAllStatesLinkedTo(State* state)
 {
 	Array<State*> result;
@@ -80,9 +107,113 @@ Array<UndoableAction*> StateTransitionManager::getRemoveAllLinkedTransitionsActi
 
 StateTransition* StateTransitionManager::getItemForSourceAndDest(State* source, State* dest)
 {
-	for (auto& st : items)
+	if (source == nullptr) return nullptr;
+
+	for (auto& st : source->outTransitions)
 	{
-		if (st->sourceState == source && st->destState == dest) return st;
+		if (st->destState == dest) return st;
 	}
 	return nullptr;
 }
+
+void StateTransitionManager::stateAdded(State* s)
+{
+	GenericScopedLock lock(componentsLock);
+	if (componentsAreDirty || stateComponents.contains(s)) return;
+
+	int id = nextComponentID++;
+	stateComponents.set(s, id);
+	components.set(id, Array<State*>(s));
+}
+
+void StateTransitionManager::invalidateComponents()
+{
+	GenericScopedLock lock(componentsLock);
+	componentsAreDirty = true;
+}
+
+void StateTransitionManager::updateComponents()
+{
+	GenericScopedLock lock(componentsLock);
+	if (!componentsAreDirty) return;
+
+	stateComponents.clear();
+	components.clear();
+	nextComponentID = 0;
+
+	for (auto& s : sm->items) stateComponents.set(s, -1);
+
+	Array<State*> toVisit;
+	for (auto& s : sm->items)
+	{
+		if (stateComponents[s] != -1) continue;
+
+		int id = nextComponentID++;
+		Array<State*> members;
+		stateComponents.set(s, id);
+		toVisit.add(s);
+
+		while (!toVisit.isEmpty())
+		{
+			State* cs = toVisit.removeAndReturn(toVisit.size() - 1);
+			members.add(cs);
+
+			Array<State*> linkedStates = getAllStatesLinkedTo(cs);
+			for (auto& ls : linkedStates)
+			{
+				//states that are not in the manager anymore are left out
+				if (ls == nullptr || !stateComponents.contains(ls) || stateComponents[ls] != -1) continue;
+				stateComponents.set(ls, id);
+				toVisit.add(ls);
+			}
+		}
+
+		components.set(id, members);
+	}
+
+	componentsAreDirty = false;
+}
+
+int StateTransitionManager::getComponentID(State* s)
+{
+	GenericScopedLock lock(componentsLock);
+	updateComponents();
+	return stateComponents.contains(s) ? stateComponents[s] : -1;
+}
+
+Array<State*> StateTransitionManager::getStatesInComponent(int componentID)
+{
+	GenericScopedLock lock(componentsLock);
+	updateComponents();
+	if (!components.contains(componentID)) return Array<State*>();
+	return components.getReference(componentID);
+}
+
+Array<State*> StateTransitionManager::getStatesInComponentOf(State* s)
+{
+	GenericScopedLock lock(componentsLock);
+	return getStatesInComponent(getComponentID(s));
+}
+
+bool StateTransitionManager::areStatesLinked(State* a, State* b)
+{
+	GenericScopedLock lock(componentsLock);
+	int componentID = getComponentID(a);
+	return componentID != -1 && componentID == getComponentID(b);
+}
+
+void StateTransitionManager::mergeComponents(int componentA, int componentB)
+{
+	//called under componentsLock
+	//relabel the smallest one
+	if (components.getReference(componentA).size() < components.getReference(componentB).size()) std::swap(componentA, componentB);
+
+	Array<State*>& target = components.getReference(componentA);
+	for (auto& s : components.getReference(componentB))
+	{
+		stateComponents.set(s, componentA);
+		target.add(s);
+	}
+
+	components.remove(componentB);
+}
@@ -28,8 +28,32 @@ public:
 	StateTransition * createItem(State * source, State * dest);
 	StateTransition* createItem() override; //override to avoid 
 
+	void addItemInternal(StateTransition* t, var data) override;
+	void removeItemInternal(StateTransition* t) override;
+
 	Array<State *> getAllStatesLinkedTo(State * state);
 	Array<UndoableAction *> getRemoveAllLinkedTransitionsAction(State * linkedState);
 
 	StateTransition * getItemForSourceAndDest(State * source, State * dest);
+
+	//Connected components of the state graph, states linked by transitions share a component.
+	//Adding a transition merges components in place, removals and loading mark them dirty and they are recomputed on the next query.
+	//Queries can come from any thread (actions, scripts), so the rebuild and the lookups are done under componentsLock.
+	CriticalSection componentsLock;
+	HashMap<State*, int> stateComponents;
+	HashMap<int, Array<State*>> components;
+	int nextComponentID;
+	bool componentsAreDirty;
+
+	void stateAdded(State* s);
+	void invalidateComponents();
+	void updateComponents();
+
+	int getComponentID(State* s); //-1 if the state is not in the graph
+	Array<State*> getStatesInComponent(int componentID); //a copy, the component may be rebuilt by another thread afterwards
+	Array<State*> getStatesInComponentOf(State* s); //same, the lookup and the copy are done under one lock
+	bool areStatesLinked(State* a, State* b);
+
+private:
+	void mergeComponents(int componentA, int componentB);
 };
\ No newline at end of file
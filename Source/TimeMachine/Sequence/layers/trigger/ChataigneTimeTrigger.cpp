@@ -10,15 +10,24 @@
 
 #include "Common/Processor/ProcessorIncludes.h"
 
-ChataigneTimeTrigger::ChataigneTimeTrigger(StringRef name) :
-	TimeTrigger(name)
+ChataigneTimeTrigger::ChataigneTimeTrigger(ChataigneTriggerLayer* layer, StringRef name) :
+	TimeTrigger(name),
+	triggerLayer(layer),
+	isDispatched(false)
 { 
+	latency = addFloatParameter("Latency", "Time between the moment this trigger should have fired and the moment its consequences actually started, in milliseconds", 0);
+	latency->setControllableFeedbackOnly(true);
+	latency->isSavable = false;
+
 	csm.reset(new ConsequenceManager());
 	addChildControllableContainer(csm.get());
+
+	SequenceTriggerDispatcher::getInstance()->registerTrigger(this);
 }
 
 ChataigneTimeTrigger::~ChataigneTimeTrigger()
 {
+	if (SequenceTriggerDispatcher* d = SequenceTriggerDispatcher::getInstanceWithoutCreating()) d->unregisterTrigger(this);
 }
 
 void ChataigneTimeTrigger::onContainerParameterChangedInternal(Parameter* p)
@@ -29,10 +38,25 @@ void ChataigneTimeTrigger::onContainerParameterChangedInternal(Parameter* p)
 	{
 		csm->setForceDisabled(!enabled->boolValue());
 	}
+	else if (p == time)
+	{
+		if (triggerLayer != nullptr) triggerLayer->triggersChanged();
+	}
 }
 
 void ChataigneTimeTrigger::triggerInternal()
 {
+	if (isDispatched.exchange(false)) return; //the layer's lookahead already scheduled it at its exact time
+
+	double intendedTime = triggerLayer != nullptr ? triggerLayer->getIntendedTimeFor(this) : Time::getMillisecondCounterHiRes();
+
+	if (triggerLayer != nullptr && triggerLayer->asyncDispatch->boolValue()) SequenceTriggerDispatcher::getInstance()->dispatch(this, triggerLayer, intendedTime);
+	else executeConsequences(intendedTime);
+}
+
+void ChataigneTimeTrigger::executeConsequences(double intendedTime)
+{
+	latency->setValue(Time::getMillisecondCounterHiRes() - intendedTime);
 	csm->triggerAll();
 }
 
@@ -11,19 +11,25 @@
 #pragma once
 
 class ConsequenceManager;
+class ChataigneTriggerLayer;
 
 class ChataigneTimeTrigger :
 	public TimeTrigger
 {
 public:
-	ChataigneTimeTrigger(StringRef name = "Trigger");
+	ChataigneTimeTrigger(ChataigneTriggerLayer* layer = nullptr, StringRef name = "Trigger");
 	virtual ~ChataigneTimeTrigger();
 
+	ChataigneTriggerLayer* triggerLayer;
 	std::unique_ptr<ConsequenceManager> csm;
 
+	FloatParameter* latency;
+	std::atomic<bool> isDispatched; //consequences have been handed to the dispatcher ahead of time by the layer's lookahead
+
 	virtual void onContainerParameterChangedInternal(Parameter* p) override;
 
 	virtual void triggerInternal() override;
+	void executeConsequences(double intendedTime);
 
 	virtual var getJSONData() override;
 	virtual void loadJSONDataInternal(var data) override;
@@ -9,20 +9,186 @@
 */
 
 ChataigneTriggerLayer::ChataigneTriggerLayer(Sequence* _sequence, var params) :
-	TriggerLayer(_sequence, getTypeString(), params)
+	TriggerLayer(_sequence, getTypeString(), params),
+	triggerManager(nullptr),
+	triggersAreDirty(true)
 {
 	helpID = "ChataigneTriggerLayer";
-	setManager(new ChataigneTriggerManager(this, _sequence));
+
+	asyncDispatch = addBoolParameter("Asynchronous Dispatch", "If checked, consequences are run by a pool of workers at the exact time of their trigger, so slow consequences never delay the sequence or the other triggers. Uncheck to run them in the sequence's time update like before.", false);
+
+	triggerManager = new ChataigneTriggerManager(this, _sequence);
+	setManager(triggerManager);
+	triggerManager->addBaseManagerListener(this);
 }
 
 ChataigneTriggerLayer::~ChataigneTriggerLayer()
 {
+	triggerManager->removeBaseManagerListener(this);
+	if (SequenceTriggerDispatcher* d = SequenceTriggerDispatcher::getInstanceWithoutCreating()) d->cancelAll(this);
+}
+
+void ChataigneTriggerLayer::triggersChanged()
+{
+	triggersAreDirty = true;
+}
+
+void ChataigneTriggerLayer::rebuildSortedTriggers()
+{
+	sortedTriggers.clearQuick();
+	for (auto& t : triggerManager->items)
+	{
+		if (ChataigneTimeTrigger* ct = dynamic_cast<ChataigneTimeTrigger*>(t)) sortedTriggers.add(ct);
+	}
+
+	struct TimeComparator
+	{
+		int compareElements(ChataigneTimeTrigger* t1, ChataigneTimeTrigger* t2) const
+		{
+			const float diff = t1->time->floatValue() - t2->time->floatValue();
+			return diff < 0 ? -1 : (diff > 0 ? 1 : 0);
+		}
+	};
 
+	TimeComparator comparator;
+	sortedTriggers.sort(comparator, true); //keep manager order for triggers at the same time
+
+	triggersAreDirty = false;
+}
+
+void ChataigneTriggerLayer::cancelLookahead()
+{
+	if (SequenceTriggerDispatcher* d = SequenceTriggerDispatcher::getInstanceWithoutCreating()) d->cancelAll(this);
+	for (auto& t : dispatchedTriggers) t->isDispatched = false;
+	dispatchedTriggers.clearQuick();
+}
+
+//Maps the trigger's time back to the moment the sequence actually crossed it, since the time update only happens once per frame
+double ChataigneTriggerLayer::getIntendedTimeFor(ChataigneTimeTrigger* t)
+{
+	const double now = Time::getMillisecondCounterHiRes();
+	if (!sequence->isPlaying->boolValue() || sequence->isSeeking) return now;
+
+	const float speed = sequence->playSpeed->floatValue();
+	const float lateness = sequence->currentTime->floatValue() - t->time->floatValue();
+	if (speed <= 0 || lateness < 0 || lateness > 1) return now; //manual trigger or jump, not a crossing
+
+	return now - lateness / speed * 1000.0;
+}
+
+void ChataigneTriggerLayer::itemAdded(TimeTrigger*)
+{
+	triggersChanged();
+}
+
+void ChataigneTriggerLayer::itemsAdded(Array<TimeTrigger*>)
+{
+	triggersChanged();
+}
+
+void ChataigneTriggerLayer::itemRemoved(TimeTrigger* t)
+{
+	GenericScopedLock lock(lookaheadLock);
+	sortedTriggers.removeFirstMatchingValue(dynamic_cast<ChataigneTimeTrigger*>(t));
+	dispatchedTriggers.removeFirstMatchingValue(dynamic_cast<ChataigneTimeTrigger*>(t));
+	triggersChanged();
 }
 
+void ChataigneTriggerLayer::itemsRemoved(Array<TimeTrigger*> triggers)
+{
+	GenericScopedLock lock(lookaheadLock);
+	for (auto& t : triggers)
+	{
+		sortedTriggers.removeFirstMatchingValue(dynamic_cast<ChataigneTimeTrigger*>(t));
+		dispatchedTriggers.removeFirstMatchingValue(dynamic_cast<ChataigneTimeTrigger*>(t));
+	}
+	triggersChanged();
+}
+
+void ChataigneTriggerLayer::onContainerParameterChangedInternal(Parameter* p)
+{
+	TriggerLayer::onContainerParameterChangedInternal(p);
+
+	if (p == enabled || p == asyncDispatch)
+	{
+		GenericScopedLock lock(lookaheadLock);
+		cancelLookahead();
+	}
+}
+
+void ChataigneTriggerLayer::sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool evaluateSkippedData)
+{
+	TriggerLayer::sequenceCurrentTimeChanged(s, prevTime, evaluateSkippedData); //fires the crossed triggers, consuming the ones dispatched ahead
+
+	GenericScopedLock lock(lookaheadLock);
+
+	const float currentTime = sequence->currentTime->floatValue();
+	const float speed = sequence->playSpeed->floatValue();
+
+	bool canLookahead = asyncDispatch->boolValue() && enabled->boolValue() && sequence->enabled->boolValue()
+		&& sequence->isPlaying->boolValue() && !sequence->isSeeking && speed > 0 && currentTime >= prevTime;
+
+	if (!canLookahead)
+	{
+		cancelLookahead();
+		return;
+	}
+
+	//The sequence went past these without firing them (disabled, already triggered...), drop what has not run yet
+	for (int i = dispatchedTriggers.size() - 1; i >= 0; i--)
+	{
+		ChataigneTimeTrigger* t = dispatchedTriggers[i];
+		if (t->isDispatched && t->time->floatValue() > currentTime) continue;
+
+		if (t->isDispatched) SequenceTriggerDispatcher::getInstance()->cancel(t);
+		t->isDispatched = false;
+		dispatchedTriggers.remove(i);
+	}
+
+	if (triggersAreDirty) rebuildSortedTriggers();
+
+	//Window is 2 frames ahead, the next time update will be at most one frame late
+	const float windowEnd = currentTime + speed * 2.0f / jmax(sequence->fps->floatValue(), 1.0f);
+	const double now = Time::getMillisecondCounterHiRes();
+
+	int start = 0;
+	int end = sortedTriggers.size();
+	while (start < end)
+	{
+		int mid = (start + end) / 2;
+		if (sortedTriggers.getUnchecked(mid)->time->floatValue() <= currentTime) start = mid + 1;
+		else end = mid;
+	}
+
+	for (int i = start; i < sortedTriggers.size(); i++)
+	{
+		ChataigneTimeTrigger* t = sortedTriggers.getUnchecked(i);
+		const float triggerTime = t->time->floatValue();
+		if (triggerTime > windowEnd) break;
+		if (!t->enabled->boolValue() || t->isDispatched) continue;
+
+		t->isDispatched = true;
+		dispatchedTriggers.add(t);
+		SequenceTriggerDispatcher::getInstance()->dispatch(t, this, now + (triggerTime - currentTime) / speed * 1000.0);
+	}
+}
+
+void ChataigneTriggerLayer::sequencePlayStateChanged(Sequence* s)
+{
+	TriggerLayer::sequencePlayStateChanged(s);
+
+	if (!sequence->isPlaying->boolValue())
+	{
+		GenericScopedLock lock(lookaheadLock);
+		cancelLookahead();
+	}
+}
+
+
 
 ChataigneTriggerManager::ChataigneTriggerManager(ChataigneTriggerLayer* layer, Sequence* sequence) :
-	TimeTriggerManager(layer, sequence)
+	TimeTriggerManager(layer, sequence),
+	chataigneTriggerLayer(layer)
 {
 }
 
@@ -32,5 +198,5 @@ ChataigneTriggerManager::~ChataigneTriggerManager()
 
 TimeTrigger* ChataigneTriggerManager::createItem()
 {
-	return new ChataigneTimeTrigger();
+	return new ChataigneTimeTrigger(chataigneTriggerLayer);
 }
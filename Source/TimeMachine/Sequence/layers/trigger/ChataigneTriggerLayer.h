@@ -19,17 +19,46 @@ public:
 	ChataigneTriggerManager(ChataigneTriggerLayer* layer, Sequence* sequence);
 	~ChataigneTriggerManager();
 
+	ChataigneTriggerLayer* chataigneTriggerLayer;
+
 	TimeTrigger* createItem() override;
 };
 
 
 class ChataigneTriggerLayer :
-	public TriggerLayer
+	public TriggerLayer,
+	public TimeTriggerManager::ManagerListener
 {
 public :
 	ChataigneTriggerLayer(Sequence * _sequence, var params = var());
 	~ChataigneTriggerLayer();
 
+	ChataigneTriggerManager* triggerManager;
+
+	BoolParameter* asyncDispatch;
+
+	//Lookahead, only used when dispatching asynchronously
+	CriticalSection lookaheadLock;
+	Array<ChataigneTimeTrigger*> sortedTriggers; //by time, rebuilt when triggersAreDirty
+	Array<ChataigneTimeTrigger*> dispatchedTriggers; //handed to the dispatcher and not yet reached by the sequence
+	std::atomic<bool> triggersAreDirty;
+
+	void triggersChanged();
+	void rebuildSortedTriggers();
+	void cancelLookahead();
+
+	double getIntendedTimeFor(ChataigneTimeTrigger* t);
+
+	void itemAdded(TimeTrigger*) override;
+	void itemsAdded(Array<TimeTrigger*>) override;
+	void itemRemoved(TimeTrigger*) override;
+	void itemsRemoved(Array<TimeTrigger*>) override;
+
+	void onContainerParameterChangedInternal(Parameter* p) override;
+
+	void sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool evaluateSkippedData) override;
+	void sequencePlayStateChanged(Sequence* s) override;
+
 	static ChataigneTriggerLayer* create(Sequence* sequence, var params) { return new ChataigneTriggerLayer(sequence, params); }
 	virtual String getTypeString() const override { return "Trigger"; }
 
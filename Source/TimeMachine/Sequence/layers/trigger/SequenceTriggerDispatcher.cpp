@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+    SequenceTriggerDispatcher.cpp
+    Created: 18 Oct 2026 5:32:10pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+juce_ImplementSingleton(SequenceTriggerDispatcher);
+
+SequenceTriggerDispatcher::SequenceTriggerDispatcher() :
+	Thread("Sequence Trigger Dispatch"),
+	pool(jlimit(1, 4, SystemStats::getNumCpus() / 2))
+{
+	startThread();
+}
+
+SequenceTriggerDispatcher::~SequenceTriggerDispatcher()
+{
+	signalThreadShouldExit();
+	notify();
+	stopThread(1000);
+	pool.removeAllJobs(true, 1000);
+}
+
+void SequenceTriggerDispatcher::registerTrigger(ChataigneTimeTrigger* t)
+{
+	GenericScopedLock lock(dispatchLock);
+	liveTriggers.set(t, 0);
+}
+
+void SequenceTriggerDispatcher::unregisterTrigger(ChataigneTimeTrigger* t)
+{
+	{
+		GenericScopedLock lock(dispatchLock);
+		liveTriggers.remove(t);
+		for (int i = pendingTriggers.size() - 1; i >= 0; i--) if (pendingTriggers.getReference(i).trigger == t) pendingTriggers.remove(i);
+		for (int i = dueTriggers.size() - 1; i >= 0; i--) if (dueTriggers.getReference(i).trigger == t) dueTriggers.remove(i);
+	}
+
+	//Wait for a worker still executing this trigger's consequences, unless it's the one deleting it.
+	//No time limit, the trigger must not be deleted under a running job. The timeout only covers several threads waiting on the same event
+	while (isRunningElsewhere(t)) executionEnded.wait(10);
+}
+
+void SequenceTriggerDispatcher::dispatch(ChataigneTimeTrigger* t, ChataigneTriggerLayer* layer, double intendedTime)
+{
+	{
+		GenericScopedLock lock(dispatchLock);
+		if (!liveTriggers.contains(t)) return;
+
+		int index = pendingTriggers.size();
+		while (index > 0 && pendingTriggers.getReference(index - 1).intendedTime > intendedTime) index--;
+		pendingTriggers.insert(index, { t, layer, intendedTime });
+	}
+
+	notify();
+}
+
+bool SequenceTriggerDispatcher::cancel(ChataigneTimeTrigger* t)
+{
+	GenericScopedLock lock(dispatchLock);
+	bool found = false;
+	for (int i = pendingTriggers.size() - 1; i >= 0; i--)
+	{
+		if (pendingTriggers.getReference(i).trigger != t) continue;
+		pendingTriggers.remove(i);
+		found = true;
+	}
+
+	for (int i = dueTriggers.size() - 1; i >= 0; i--)
+	{
+		if (dueTriggers.getReference(i).trigger != t) continue;
+		dueTriggers.remove(i);
+		found = true;
+	}
+
+	return found;
+}
+
+void SequenceTriggerDispatcher::cancelAll(ChataigneTriggerLayer* layer)
+{
+	GenericScopedLock lock(dispatchLock);
+	for (int i = pendingTriggers.size() - 1; i >= 0; i--)
+	{
+		if (pendingTriggers.getReference(i).layer == layer) pendingTriggers.remove(i);
+	}
+
+	for (int i = dueTriggers.size() - 1; i >= 0; i--)
+	{
+		if (dueTriggers.getReference(i).layer == layer) dueTriggers.remove(i);
+	}
+}
+
+void SequenceTriggerDispatcher::run()
+{
+	Array<DispatchJob*> newJobs;
+
+	while (!threadShouldExit())
+	{
+		double msToWait = 100;
+
+		{
+			GenericScopedLock lock(dispatchLock);
+			const double now = Time::getMillisecondCounterHiRes();
+
+			while (!pendingTriggers.isEmpty() && pendingTriggers.getReference(0).intendedTime <= now)
+			{
+				PendingTrigger pt = pendingTriggers.removeAndReturn(0);
+				dueTriggers.add(pt);
+
+				//A layer that already has a job gets this trigger through it, after the ones before
+				if (busyLayers.contains(pt.layer)) continue;
+				busyLayers.add(pt.layer);
+				newJobs.add(new DispatchJob(this, pt.layer));
+			}
+
+			if (!pendingTriggers.isEmpty()) msToWait = pendingTriggers.getReference(0).intendedTime - now;
+		}
+
+		for (auto& j : newJobs) pool.addJob(j, true);
+		newJobs.clearQuick();
+
+		if (msToWait > 0) wait(jmax(1, (int)msToWait)); //dispatch() notifies when an earlier trigger comes in
+	}
+}
+
+bool SequenceTriggerDispatcher::beginNextExecution(ChataigneTriggerLayer* layer, PendingTrigger& pt)
+{
+	GenericScopedLock lock(dispatchLock);
+	for (int i = 0; i < dueTriggers.size(); i++)
+	{
+		if (dueTriggers.getReference(i).layer != layer) continue;
+
+		pt = dueTriggers.removeAndReturn(i);
+		if (!liveTriggers.contains(pt.trigger)) continue; //unregistered triggers are removed from dueTriggers, this is only a safety
+		runningTriggers.add({ pt.trigger, Thread::getCurrentThreadId() });
+		return true;
+	}
+
+	busyLayers.removeAllInstancesOf(layer);
+	return false;
+}
+
+void SequenceTriggerDispatcher::endExecution(ChataigneTimeTrigger* t)
+{
+	GenericScopedLock lock(dispatchLock);
+	for (int i = 0; i < runningTriggers.size(); i++)
+	{
+		if (runningTriggers.getReference(i).trigger == t && runningTriggers.getReference(i).thread == Thread::getCurrentThreadId())
+		{
+			runningTriggers.remove(i);
+			break;
+		}
+	}
+
+	executionEnded.signal();
+}
+
+bool SequenceTriggerDispatcher::isRunningElsewhere(ChataigneTimeTrigger* t)
+{
+	GenericScopedLock lock(dispatchLock);
+	for (auto& rt : runningTriggers)
+	{
+		if (rt.trigger == t && rt.thread != Thread::getCurrentThreadId()) return true;
+	}
+
+	return false;
+}
+
+
+
+// DispatchJob
+
+ThreadPoolJob::JobStatus SequenceTriggerDispatcher::DispatchJob::runJob()
+{
+	PendingTrigger pt;
+	while (dispatcher->beginNextExecution(layer, pt))
+	{
+		pt.trigger->executeConsequences(pt.intendedTime);
+		dispatcher->endExecution(pt.trigger);
+	}
+
+	return jobHasFinished;
+}
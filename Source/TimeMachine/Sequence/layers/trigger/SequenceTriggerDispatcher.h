@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    SequenceTriggerDispatcher.h
+    Created: 18 Oct 2026 5:32:10pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class ChataigneTimeTrigger;
+class ChataigneTriggerLayer;
+
+/*
+	Runs the consequences of sequence triggers away from the sequence's time update.
+	Triggers are queued with the time they were meant to fire at, sorted, and handed to a pool of workers when due.
+	Each layer has at most one job running at a time, which runs that layer's due triggers one after another in order,
+	so triggers of the same layer never run concurrently or out of order.
+*/
+class SequenceTriggerDispatcher :
+	public Thread
+{
+public:
+	juce_DeclareSingleton(SequenceTriggerDispatcher, true);
+
+	SequenceTriggerDispatcher();
+	~SequenceTriggerDispatcher();
+
+	struct PendingTrigger
+	{
+		ChataigneTimeTrigger* trigger;
+		ChataigneTriggerLayer* layer;
+		double intendedTime; //Time::getMillisecondCounterHiRes() base
+	};
+
+	class DispatchJob :
+		public ThreadPoolJob
+	{
+	public:
+		DispatchJob(SequenceTriggerDispatcher* dispatcher, ChataigneTriggerLayer* layer) : ThreadPoolJob("Trigger Dispatch"), dispatcher(dispatcher), layer(layer) {}
+		SequenceTriggerDispatcher* dispatcher;
+		ChataigneTriggerLayer* layer; //only used as a key, never dereferenced
+		JobStatus runJob() override;
+	};
+
+	void registerTrigger(ChataigneTimeTrigger* t);
+	void unregisterTrigger(ChataigneTimeTrigger* t); //waits for a running dispatch of this trigger to finish
+
+	void dispatch(ChataigneTimeTrigger* t, ChataigneTriggerLayer* layer, double intendedTime);
+	bool cancel(ChataigneTimeTrigger* t); //returns true if the trigger was still pending
+	void cancelAll(ChataigneTriggerLayer* layer);
+
+	void run() override;
+
+private:
+	CriticalSection dispatchLock;
+	ThreadPool pool;
+
+	struct RunningTrigger
+	{
+		ChataigneTimeTrigger* trigger;
+		Thread::ThreadID thread;
+	};
+
+	Array<PendingTrigger> pendingTriggers; //sorted by intendedTime
+	Array<PendingTrigger> dueTriggers; //due, waiting for their layer's job, in order
+	Array<ChataigneTriggerLayer*> busyLayers; //layers with a job in the pool
+	HashMap<ChataigneTimeTrigger*, int> liveTriggers; //used as a set, only registered triggers are executed
+	Array<RunningTrigger> runningTriggers;
+	WaitableEvent executionEnded;
+
+	bool beginNextExecution(ChataigneTriggerLayer* layer, PendingTrigger& pt); //false when the layer has nothing left, the job then ends
+	void endExecution(ChataigneTimeTrigger* t);
+	bool isRunningElsewhere(ChataigneTimeTrigger* t);
+
+	JUCE_DECLARE_NON_COPYABLE(SequenceTriggerDispatcher)
+};
@@ -34,5 +34,6 @@
 #include "Sequence/layers/mapping/ui/MappingLayerEditor.cpp"
 #include "Sequence/layers/mapping/ui/MappingLayerPanel.cpp"
 #include "Sequence/layers/mapping/ui/MappingLayerTimeline.cpp"
+#include "Sequence/layers/trigger/SequenceTriggerDispatcher.cpp"
 #include "Sequence/layers/trigger/ChataigneTimeTrigger.cpp"
 #include "Sequence/layers/trigger/ChataigneTriggerLayer.cpp"
@@ -27,6 +27,7 @@
 
 #include "Sequence/Cue/ChataigneCue.h"
 
+#include "Sequence/layers/trigger/SequenceTriggerDispatcher.h"
 #include "Sequence/layers/trigger/ChataigneTimeTrigger.h"
 #include "Sequence/layers/trigger/ChataigneTriggerLayer.h"
 
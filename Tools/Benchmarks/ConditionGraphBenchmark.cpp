@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+    ConditionGraphBenchmark.cpp
+    Created: 18 Oct 2026 8:24:06pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+/*
+	Model of ConditionManager evaluation, see README.md.
+	Drives random source changes through a large set of StandardConditions in AND / OR managers :
+	- scan : on a validity change, all items scanned for the same source, then again for the AND / OR result
+	- graph : same-source conditions from the source map, AND / OR from the valid counts
+	Both must end with the same manager states.
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+struct Manager;
+
+struct Condition
+{
+	virtual ~Condition() {}
+	bool enabled = true;
+	bool isValid = false;
+};
+
+struct StandardCondition : public Condition
+{
+	Manager* manager = nullptr;
+	int source = 0;
+	float threshold = 0;
+	bool greater = true;
+	int slot = 0;
+
+	bool compare(float v) const { return greater ? v > threshold : v < threshold; }
+};
+
+struct Manager
+{
+	bool isAnd = true;
+	bool isValid = false;
+	std::vector<std::unique_ptr<Condition>> items;
+
+	//compiled graph
+	std::unordered_map<int, std::vector<StandardCondition*>> sourceMap;
+	int validCount = 0;
+	int enabledCount = 0;
+	bool isChecking = false;
+
+	void compile()
+	{
+		sourceMap.clear();
+		validCount = 0;
+		enabledCount = 0;
+		for (auto& i : items)
+		{
+			StandardCondition* sc = (StandardCondition*)i.get();
+			if (!sc->enabled) continue;
+			sourceMap[sc->source].push_back(sc);
+			enabledCount++;
+			if (sc->isValid) validCount++;
+		}
+	}
+};
+
+static std::vector<float> sourceValues;
+
+//previous ConditionManager::conditionValidationChanged + checkAllConditions
+struct ScanPath
+{
+	static void checkComparator(StandardCondition* c)
+	{
+		bool v = c->compare(sourceValues[c->source]);
+		if (v == c->isValid) return;
+		c->isValid = v;
+		validationChanged(c);
+	}
+
+	static void validationChanged(StandardCondition* c)
+	{
+		Manager* m = c->manager;
+		if (m->isChecking) return;
+
+		m->isChecking = true;
+		for (auto& i : m->items)
+		{
+			if (i.get() == c) continue;
+			if (StandardCondition* other = dynamic_cast<StandardCondition*>(i.get()))
+			{
+				if (other->source == c->source) checkComparator(other);
+			}
+		}
+		m->isChecking = false;
+
+		bool valid = m->isAnd;
+		for (auto& i : m->items)
+		{
+			if (!i->enabled) continue;
+			if (m->isAnd && !i->isValid) { valid = false; break; }
+			if (!m->isAnd && i->isValid) { valid = true; break; }
+		}
+		m->isValid = valid;
+	}
+};
+
+//compiled graph : same-source conditions and counts
+struct GraphPath
+{
+	static void setValid(StandardCondition* c, bool v)
+	{
+		c->isValid = v;
+		c->manager->validCount += v ? 1 : -1;
+	}
+
+	static void checkComparator(StandardCondition* c)
+	{
+		bool v = c->compare(sourceValues[c->source]);
+		if (v == c->isValid) return;
+		setValid(c, v);
+		validationChanged(c);
+	}
+
+	static void validationChanged(StandardCondition* c)
+	{
+		Manager* m = c->manager;
+		if (!m->isChecking)
+		{
+			m->isChecking = true;
+			for (auto& other : m->sourceMap[c->source]) if (other != c) checkComparator(other);
+			m->isChecking = false;
+		}
+
+		m->isValid = m->isAnd ? m->validCount == m->enabledCount : m->validCount > 0;
+	}
+};
+
+struct RuleSet
+{
+	std::vector<std::unique_ptr<Manager>> managers;
+	std::vector<std::vector<StandardCondition*>> listeners; //per source, the conditions watching it
+
+	RuleSet(int numSources, int numManagers, int conditionsPerManager, unsigned int seed)
+	{
+		std::mt19937 rng(seed);
+		listeners.resize(numSources);
+		for (int m = 0; m < numManagers; m++)
+		{
+			managers.emplace_back(new Manager());
+			Manager* manager = managers.back().get();
+			manager->isAnd = rng() % 2 == 0;
+
+			//conditions of a manager mostly watch a handful of sources, like a state machine transition
+			const int baseSource = rng() % numSources;
+			for (int i = 0; i < conditionsPerManager; i++)
+			{
+				StandardCondition* c = new StandardCondition();
+				c->manager = manager;
+				c->source = rng() % 4 == 0 ? rng() % numSources : (baseSource + rng() % 8) % numSources;
+				c->threshold = (rng() % 1000) / 1000.0f;
+				c->greater = rng() % 2 == 0;
+				c->enabled = rng() % 20 != 0;
+				c->isValid = c->compare(sourceValues[c->source]);
+				manager->items.emplace_back(c);
+				if (c->enabled) listeners[c->source].push_back(c);
+			}
+
+			manager->compile();
+		}
+	}
+};
+
+int main()
+{
+	const int numSources = 300;
+	const int numManagers = 60;
+	const int conditionsPerManager = 50;
+	const int numChanges = 200000;
+
+	sourceValues.assign(numSources, .5f);
+
+	std::mt19937 rng(7);
+	std::vector<std::pair<int, float>> changes(numChanges);
+	for (auto& c : changes) c = { (int)(rng() % numSources), (rng() % 1000) / 1000.0f };
+
+	auto run = [&](const char* name, auto checkComparator)
+	{
+		sourceValues.assign(numSources, .5f);
+		RuleSet rules(numSources, numManagers, conditionsPerManager, 99);
+
+		auto start = std::chrono::steady_clock::now();
+		for (auto& change : changes)
+		{
+			sourceValues[change.first] = change.second;
+			for (auto& c : rules.listeners[change.first]) checkComparator(c);
+		}
+		double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / numChanges;
+
+		unsigned long long signature = 0;
+		for (auto& m : rules.managers) signature = signature * 31 + (m->isValid ? 1 : 0);
+		printf("%-6s %8.1f ns/source change (state signature %llx)\n", name, ns, signature);
+	};
+
+	printf("%d sources, %d managers x %d conditions, %d changes\n", numSources, numManagers, conditionsPerManager, numChanges);
+	run("scan", ScanPath::checkComparator);
+	run("graph", GraphPath::checkComparator);
+	return 0;
+}
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+    DMXInputBenchmark.cpp
+    Created: 18 Oct 2026 7:31:48pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+/*
+	Model of the DMX input path, see README.md.
+	Replays 16 sACN universes, a few fixtures moving and the rest resent unchanged at the keep-alive rate :
+	- copy : frame passed by value to the listener, copied again for the universe, every channel pushed
+	- view : read-only pointer down to the universe, identical frames skipped with one memcmp, changed channels only
+	On both paths a channel only notifies when its value really changed.
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static const int numChannels = 512;
+
+struct Universe
+{
+	uint8_t values[numChannels] = {};
+	long long notifications = 0;
+	float mapped[numChannels] = {};
+
+	void updateValue(int channel, uint8_t value)
+	{
+		if (values[channel] == value) return;
+		values[channel] = value;
+		mapped[channel] = value / 255.0f; //parameter update
+		notifications++;
+	}
+
+	void updateValues(std::vector<uint8_t> newValues) //by value, like Array<uint8>
+	{
+		for (int i = 0; i < (int)newValues.size(); i++) updateValue(i, newValues[i]);
+	}
+};
+
+struct CopyPath
+{
+	Universe universes[16];
+
+	void dmxDataInChanged(int universe, std::vector<uint8_t> values) //listener gets a copy
+	{
+		universes[universe].updateValues(values);
+	}
+};
+
+struct ViewPath
+{
+	Universe universes[16];
+	uint8_t previous[16][numChannels];
+	bool hasPrevious[16] = {};
+
+	void processDMXIn(int universe, const uint8_t* data, int numValues)
+	{
+		Universe& u = universes[universe];
+		uint8_t* prev = previous[universe];
+
+		if (!hasPrevious[universe])
+		{
+			memcpy(prev, data, numValues);
+			hasPrevious[universe] = true;
+			for (int i = 0; i < numValues; i++) u.updateValue(i, data[i]);
+			return;
+		}
+
+		if (memcmp(prev, data, numValues) == 0) return;
+
+		for (int i = 0; i < numValues; i++)
+		{
+			if (prev[i] == data[i]) continue;
+			prev[i] = data[i];
+			u.updateValue(i, data[i]);
+		}
+	}
+};
+
+int main()
+{
+	//10 seconds of capture at 44 fps for 16 universes : 2 universes of moving heads change every frame
+	//on ~40 channels, a fader universe changes every 4th frame on 8 channels, the rest is resent unchanged
+	const int numUniverses = 16;
+	const int numFrames = 440 * numUniverses;
+
+	std::mt19937 rng(42);
+	std::vector<std::vector<uint8_t>> capture(numFrames, std::vector<uint8_t>(numChannels));
+	std::vector<int> captureUniverse(numFrames);
+	std::vector<std::vector<uint8_t>> state(numUniverses, std::vector<uint8_t>(numChannels));
+	for (auto& s : state) for (auto& v : s) v = (uint8_t)(rng() % 256);
+
+	for (int f = 0; f < numFrames; f++)
+	{
+		const int u = f % numUniverses;
+		const int frameIndex = f / numUniverses;
+		int changes = 0;
+		if (u < 2) changes = 40;
+		else if (u == 2 && frameIndex % 4 == 0) changes = 8;
+		for (int c = 0; c < changes; c++) state[u][rng() % numChannels] = (uint8_t)(rng() % 256);
+
+		capture[f] = state[u];
+		captureUniverse[f] = u;
+	}
+
+	const int numRepeats = 50;
+
+	CopyPath copyPath;
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < numRepeats; r++)
+		for (int f = 0; f < numFrames; f++) copyPath.dmxDataInChanged(captureUniverse[f], capture[f]);
+	double copyNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (numFrames * numRepeats);
+
+	ViewPath viewPath;
+	start = std::chrono::steady_clock::now();
+	for (int r = 0; r < numRepeats; r++)
+		for (int f = 0; f < numFrames; f++) viewPath.processDMXIn(captureUniverse[f], capture[f].data(), numChannels);
+	double viewNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (numFrames * numRepeats);
+
+	long long copyNotifications = 0, viewNotifications = 0;
+	for (int u = 0; u < numUniverses; u++)
+	{
+		copyNotifications += copyPath.universes[u].notifications;
+		viewNotifications += viewPath.universes[u].notifications;
+		if (memcmp(copyPath.universes[u].values, viewPath.universes[u].values, numChannels) != 0) printf("universe %d differs !\n", u);
+	}
+
+	printf("%d frames x %d replays\n", numFrames, numRepeats);
+	printf("copy  %8.1f ns/frame (%lld channel updates)\n", copyNs, copyNotifications);
+	printf("view  %8.1f ns/frame (%lld channel updates)\n", viewNs, viewNotifications);
+	return 0;
+}
@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    MIDIRoutingBenchmark.cpp
+    Created: 18 Oct 2026 8:47:33pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+/*
+	Model of MIDIModule::updateValue, see README.md.
+	Replays a 16 fader bank of 14-bit CCs at 1 kHz, some notes and 10% of messages without a value :
+	- names : value name built per message, then searched in the channel / type containers or the flat list
+	- table : [channel][type][number] lookup
+	Runs in both hierarchy and flat modes.
+*/
+
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+enum Type { NOTE_ON, NOTE_OFF, CONTROL_CHANGE, NUM_TYPES };
+
+struct Value
+{
+	std::string shortName;
+	std::string niceName;
+	int value = 0;
+};
+
+struct Container
+{
+	std::string shortName;
+	std::string niceName;
+	std::vector<std::unique_ptr<Container>> containers;
+	std::vector<std::unique_ptr<Value>> values;
+
+	//like ControllableContainer::getControllableContainerByName / getControllableByName with searchNiceNameToo
+	Container* getContainerByName(const std::string& name)
+	{
+		for (auto& c : containers) if (c->shortName == name || c->niceName == name) return c.get();
+		return nullptr;
+	}
+
+	Value* getValueByName(const std::string& name)
+	{
+		for (auto& v : values) if (v->shortName == name || v->niceName == name) return v.get();
+		return nullptr;
+	}
+};
+
+static std::string toShortName(const std::string& s)
+{
+	std::string result;
+	bool upper = false;
+	for (size_t i = 0; i < s.size(); i++)
+	{
+		char c = s[i];
+		if (c == ' ') { upper = true; continue; }
+		if (c == '[' || c == ']') continue;
+		result += i == 0 ? (char)tolower(c) : upper ? (char)toupper(c) : c;
+		upper = false;
+	}
+	return result;
+}
+
+static const char* noteNames[] = { "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B" };
+
+static std::string getName(Type type, int number)
+{
+	if (type == CONTROL_CHANGE) return "CC" + std::to_string(number);
+	return std::string(noteNames[number % 12]) + std::to_string(number / 12 - 1);
+}
+
+struct NameRouting
+{
+	Container root;
+	bool useHierarchy;
+
+	explicit NameRouting(bool hierarchy) : useHierarchy(hierarchy) {}
+
+	Value* add(int channel, Type type, int number)
+	{
+		std::string n = getName(type, number);
+		Container* parent = &root;
+		if (useHierarchy)
+		{
+			const std::string channelName = "Channel " + std::to_string(channel);
+			Container* channelContainer = root.getContainerByName(channelName);
+			if (channelContainer == nullptr)
+			{
+				root.containers.emplace_back(new Container({ toShortName(channelName), channelName, {}, {} }));
+				channelContainer = root.containers.back().get();
+			}
+
+			const std::string typeName = type == CONTROL_CHANGE ? "Control Change" : "Notes";
+			parent = channelContainer->getContainerByName(typeName);
+			if (parent == nullptr)
+			{
+				channelContainer->containers.emplace_back(new Container({ toShortName(typeName), typeName, {}, {} }));
+				parent = channelContainer->containers.back().get();
+			}
+		}
+		else n = "[" + std::to_string(channel) + "] " + n;
+
+		parent->values.emplace_back(new Value({ toShortName(n), n }));
+		return parent->values.back().get();
+	}
+
+	void updateValue(int channel, Type type, int number, int val)
+	{
+		std::string n = getName(type, number); //built by the onXXX callbacks before calling updateValue
+		Container* parent = &root;
+		if (useHierarchy)
+		{
+			Container* channelContainer = root.getContainerByName("Channel " + std::to_string(channel));
+			if (channelContainer == nullptr) return;
+			parent = channelContainer->getContainerByName(type == CONTROL_CHANGE ? "Control Change" : "Notes");
+			if (parent == nullptr) return;
+		}
+		else n = "[" + std::to_string(channel) + "] " + n;
+
+		if (Value* v = parent->getValueByName(n)) v->value = val;
+	}
+};
+
+struct TableRouting
+{
+	Value* table[16][NUM_TYPES][128] = {};
+
+	void updateValue(int channel, Type type, int number, int val)
+	{
+		if (Value* v = table[channel - 1][type == NOTE_OFF ? NOTE_ON : type][number]) v->value = val;
+	}
+};
+
+struct Message { int channel; Type type; int number; int value; };
+
+int main()
+{
+	//4 channels with 64 notes and 64 CCs each, the fader bank is on channel 1, CC 0-15 (MSB) and 32-47 (LSB)
+	std::vector<std::pair<Type, int>> layout;
+	for (int i = 0; i < 64; i++) layout.push_back({ CONTROL_CHANGE, i });
+	for (int i = 36; i < 100; i++) layout.push_back({ NOTE_ON, i });
+
+	std::mt19937 rng(3);
+	std::vector<Message> capture;
+	for (int ms = 0; ms < 10000; ms++)
+	{
+		for (int f = 0; f < 16; f++)
+		{
+			const int v = (ms * (f + 1) * 7) % 16384;
+			capture.push_back({ 1, CONTROL_CHANGE, f, v >> 7 });
+			capture.push_back({ 1, CONTROL_CHANGE, f + 32, v & 127 });
+		}
+
+		if (ms % 50 == 0) capture.push_back({ 1 + (int)(rng() % 4), rng() % 2 ? NOTE_ON : NOTE_OFF, 36 + (int)(rng() % 64), (int)(rng() % 128) });
+		for (int i = 0; i < 4; i++) capture.push_back({ 1 + (int)(rng() % 4), CONTROL_CHANGE, 64 + (int)(rng() % 64), (int)(rng() % 128) }); //no value for these
+	}
+
+	printf("%d messages, %d values\n", (int)capture.size(), (int)layout.size() * 4);
+
+	for (bool hierarchy : { true, false })
+	{
+		NameRouting names(hierarchy);
+		TableRouting table;
+		for (int ch = 1; ch <= 4; ch++)
+			for (auto& l : layout)
+			{
+				Value* v = names.add(ch, l.first, l.second);
+				table.table[ch - 1][l.first][l.second] = v;
+			}
+
+		long long sum = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (auto& m : capture) names.updateValue(m.channel, m.type, m.number, m.value);
+		double nameNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / capture.size();
+		for (int ch = 0; ch < 4; ch++) for (auto& l : layout) sum += table.table[ch][l.first][l.second]->value;
+
+		for (int ch = 0; ch < 4; ch++) for (auto& l : layout) table.table[ch][l.first][l.second]->value = 0;
+
+		long long tableSum = 0;
+		start = std::chrono::steady_clock::now();
+		for (auto& m : capture) table.updateValue(m.channel, m.type, m.number, m.value);
+		double tableNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / capture.size();
+		for (int ch = 0; ch < 4; ch++) for (auto& l : layout) tableSum += table.table[ch][l.first][l.second]->value;
+
+		printf("%-9s names %8.1f ns/message   table %6.1f ns/message   (checksums %lld / %lld)\n", hierarchy ? "hierarchy" : "flat", nameNs, tableNs, sum, tableSum);
+	}
+
+	return 0;
+}
@@ -0,0 +1,280 @@
+/*
+  ==============================================================================
+
+    MappingFilterChainBenchmark.cpp
+    Created: 18 Oct 2026 7:05:37pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+/*
+	Model of MappingFilter::process, see README.md.
+	Runs float -> Remap -> Curve -> Smooth and point2D -> Remap -> Smooth :
+	- var : parameter arrays copied per stage, previous values cloned into var arrays, remap built as var arrays
+	- numeric : const references, previous values in a flat double buffer, plain float remap
+	Also counts heap allocations per evaluation.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+static std::atomic<long long> numAllocations { 0 };
+
+void* operator new(size_t size)
+{
+	numAllocations++;
+	if (void* p = std::malloc(size)) return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+//Minimal var : numbers are stored inline, arrays are ref-counted heap objects, like juce::var
+struct Var
+{
+	double number = 0;
+	std::shared_ptr<std::vector<Var>> array;
+
+	Var() {}
+	Var(double v) : number(v) {}
+
+	static Var newArray() { Var v; v.array = std::make_shared<std::vector<Var>>(); return v; }
+	Var clone() const
+	{
+		if (array == nullptr) return *this;
+		Var v = newArray();
+		for (auto& a : *array) v.array->push_back(a.clone());
+		return v;
+	}
+	bool operator==(const Var& o) const
+	{
+		if (array == nullptr || o.array == nullptr) return array == o.array && number == o.number;
+		if (array->size() != o.array->size()) return false;
+		for (size_t i = 0; i < array->size(); i++) if (!((*array)[i] == (*o.array)[i])) return false;
+		return true;
+	}
+};
+
+struct Param
+{
+	int numComponents = 1;
+	double values[2] = { 0, 0 };
+	double minimum = 0, maximum = 1;
+
+	Var getValue() const
+	{
+		if (numComponents == 1) return Var(values[0]);
+		Var v = Var::newArray();
+		for (int i = 0; i < numComponents; i++) v.array->push_back(Var(values[i]));
+		return v;
+	}
+	void setValue(const Var& v)
+	{
+		if (v.array == nullptr) values[0] = v.number;
+		else for (int i = 0; i < numComponents && i < (int)v.array->size(); i++) values[i] = (*v.array)[i].number;
+	}
+};
+
+enum FilterType { REMAP, CURVE, SMOOTH };
+
+static float remap(float v, float inMin, float inMax, float outMin, float outMax) { return outMin + (v - inMin) / (inMax - inMin) * (outMax - outMin); }
+
+static float curve(float v)
+{
+	//sampled automation, 64 points smoothstep
+	static float table[65];
+	static bool init = false;
+	if (!init) { for (int i = 0; i <= 64; i++) { float t = i / 64.0f; table[i] = t * t * (3 - 2 * t); } init = true; }
+	float pos = std::fmin(std::fmax(v, 0.0f), 1.0f) * 64;
+	int i = (int)pos;
+	if (i >= 64) return table[64];
+	return table[i] + (table[i + 1] - table[i]) * (pos - i);
+}
+
+struct Filter
+{
+	FilterType type;
+	std::vector<Param> outputs;
+
+	//previous path
+	std::vector<Var> previousValues;
+
+	//numeric path
+	std::vector<double> previousNumeric;
+
+	Filter(FilterType type, const std::vector<Param>& sources) : type(type), outputs(sources) {}
+
+	void applyTo(const Param& in, Param& out, bool useVars)
+	{
+		if (type == REMAP && useVars)
+		{
+			//previous remap : goes through var arrays for every input
+			Var v = in.getValue();
+			Var result = Var::newArray();
+			for (int i = 0; i < in.numComponents; i++)
+			{
+				double c = v.array != nullptr ? (*v.array)[i].number : v.number;
+				result.array->push_back(Var(remap((float)c, (float)in.minimum, (float)in.maximum, 0, 1)));
+			}
+			if (in.numComponents == 1) out.setValue(Var((*result.array)[0].number));
+			else out.setValue(result);
+			return;
+		}
+
+		for (int i = 0; i < in.numComponents; i++)
+		{
+			float v = (float)in.values[i];
+			switch (type)
+			{
+			case REMAP: out.values[i] = remap(v, (float)in.minimum, (float)in.maximum, 0, 1); break;
+			case CURVE: out.values[i] = curve(v); break;
+			case SMOOTH: out.values[i] += (v - out.values[i]) * .2f; break;
+			}
+		}
+	}
+
+	//previous MappingFilter::process : Array taken by value, var clone per input
+	bool processVar(std::vector<Param*> inputs)
+	{
+		bool hasChanged = false;
+		if (previousValues.size() == 1 && previousValues[0].array != nullptr && previousValues[0].array->size() == inputs.size())
+		{
+			Var prev = previousValues[0];
+			for (size_t i = 0; i < inputs.size(); i++)
+			{
+				hasChanged |= !(inputs[i]->getValue() == (*prev.array)[i]);
+				(*prev.array)[i] = inputs[i]->getValue().clone();
+			}
+		}
+		else
+		{
+			hasChanged = true;
+			previousValues.assign(1, Var::newArray());
+			for (auto& in : inputs) previousValues[0].array->push_back(in->getValue().clone());
+		}
+
+		if (!hasChanged && type != SMOOTH) return false;
+		for (size_t i = 0; i < inputs.size(); i++) applyTo(*inputs[i], outputs[i], true);
+		return true;
+	}
+
+	//numeric path : flat double buffer, no clone
+	bool processNumeric(const std::vector<Param*>& inputs)
+	{
+		const size_t stride = inputs.size() * 2;
+		if (previousNumeric.size() != stride) previousNumeric.assign(stride, std::numeric_limits<double>::quiet_NaN());
+
+		bool hasChanged = false;
+		for (size_t i = 0; i < inputs.size(); i++)
+		{
+			for (int j = 0; j < inputs[i]->numComponents; j++)
+			{
+				double& prev = previousNumeric[i * 2 + j];
+				if (prev != inputs[i]->values[j])
+				{
+					prev = inputs[i]->values[j];
+					hasChanged = true;
+				}
+			}
+		}
+
+		if (!hasChanged && type != SMOOTH) return false;
+		for (size_t i = 0; i < inputs.size(); i++) applyTo(*inputs[i], outputs[i], false);
+		return true;
+	}
+};
+
+struct Chain
+{
+	std::vector<Param> sources;
+	std::vector<std::unique_ptr<Filter>> filters;
+	std::vector<Param*> scratch;
+
+	Chain(const std::vector<Param>& s, const std::vector<FilterType>& types) : sources(s)
+	{
+		for (auto t : types) filters.emplace_back(new Filter(t, sources));
+		scratch.reserve(sources.size());
+	}
+
+	float processVar()
+	{
+		std::vector<Param*> params;
+		for (auto& s : sources) params.push_back(&s);
+		for (auto& f : filters)
+		{
+			if (!f->processVar(params)) break;
+			std::vector<Param*> next;
+			for (auto& o : f->outputs) next.push_back(&o);
+			params = next;
+		}
+		return (float)filters.back()->outputs[0].values[0];
+	}
+
+	float processNumeric()
+	{
+		scratch.clear();
+		for (auto& s : sources) scratch.push_back(&s);
+		for (auto& f : filters)
+		{
+			if (!f->processNumeric(scratch)) break;
+			scratch.clear();
+			for (auto& o : f->outputs) scratch.push_back(&o);
+		}
+		return (float)filters.back()->outputs[0].values[0];
+	}
+};
+
+int main()
+{
+	const int numIterations = 1000000;
+
+	Param floatParam;
+	floatParam.minimum = 0;
+	floatParam.maximum = 127;
+
+	Param pointParam;
+	pointParam.numComponents = 2;
+	pointParam.minimum = -1;
+	pointParam.maximum = 1;
+
+	struct Case { const char* name; Param source; std::vector<FilterType> types; };
+	Case cases[] = {
+		{ "float remap>curve>smooth", floatParam, { REMAP, CURVE, SMOOTH } },
+		{ "point2d remap>smooth", pointParam, { REMAP, SMOOTH } }
+	};
+
+	for (auto& c : cases)
+	{
+		for (int pass = 0; pass < 2; pass++)
+		{
+			const bool useVars = pass == 0;
+			Chain chain({ c.source }, c.types);
+
+			float sum = 0;
+			numAllocations = 0;
+			auto start = std::chrono::steady_clock::now();
+			for (int i = 0; i < numIterations; i++)
+			{
+				//a source that changes 3 times out of 4, like a fader or sensor stream
+				Param& s = chain.sources[0];
+				if (i % 4 != 0) for (int j = 0; j < s.numComponents; j++) s.values[j] = s.minimum + (s.maximum - s.minimum) * ((i * (j + 7)) % 1000) / 1000.0;
+				sum += useVars ? chain.processVar() : chain.processNumeric();
+			}
+			auto end = std::chrono::steady_clock::now();
+
+			double ns = std::chrono::duration<double, std::nano>(end - start).count() / numIterations;
+			printf("%-26s %-8s %8.1f ns/eval %6.2f allocs/eval (checksum %.3f)\n", c.name, useVars ? "var" : "numeric", ns, (double)numAllocations / numIterations, sum / numIterations);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,313 @@
+/*
+  ==============================================================================
+
+    OSCAddressIndexBenchmark.cpp
+    Created: 18 Oct 2026 6:41:02pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+/*
+	Model of CustomOSCModule address dispatch, see README.md.
+	Replays sensor rigs and TouchOSC pages with 2% wildcard patterns :
+	- previous : address split, container walk by name, then every known address tested against the pattern
+	- indexed : one hash lookup for exact addresses, the segment trie for wildcards
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+static std::vector<std::string> split(const std::string& address)
+{
+	std::vector<std::string> result;
+	size_t start = 1;
+	while (start <= address.size())
+	{
+		size_t end = address.find('/', start);
+		if (end == std::string::npos) end = address.size();
+		result.push_back(address.substr(start, end - start));
+		start = end + 1;
+	}
+	return result;
+}
+
+//same rules as OSCAddressIndex::matchSegment : ?, *, [abc], [a-z], [!abc] and {foo,bar}
+static bool matchSegment(const char* p, const char* n)
+{
+	while (*p)
+	{
+		const char pc = *p++;
+		switch (pc)
+		{
+		case '?':
+			if (!*n) return false;
+			++n;
+			break;
+
+		case '*':
+			while (*p == '*') ++p;
+			if (!*p) return true;
+			for (;;)
+			{
+				if (matchSegment(p, n)) return true;
+				if (!*n) return false;
+				++n;
+			}
+
+		case '[':
+		{
+			if (!*n) return false;
+			const char nc = *n++;
+			bool negate = *p == '!';
+			if (negate) ++p;
+			bool found = false;
+			while (*p && *p != ']')
+			{
+				const char c = *p++;
+				if (*p == '-' && p[1] != ']' && p[1] != 0)
+				{
+					const char upper = p[1];
+					p += 2;
+					if (nc >= std::min(c, upper) && nc <= std::max(c, upper)) found = true;
+				}
+				else if (c == nc) found = true;
+			}
+			if (!*p) return false;
+			++p;
+			if (found == negate) return false;
+			break;
+		}
+
+		case '{':
+		{
+			const char* end = p;
+			while (*end && *end != '}') ++end;
+			if (!*end) return false;
+			const char* alt = p;
+			for (;;)
+			{
+				const char* altEnd = alt;
+				while (altEnd != end && *altEnd != ',') ++altEnd;
+				const char* a = alt;
+				const char* nn = n;
+				bool prefixMatch = true;
+				while (a != altEnd)
+				{
+					if (!*nn || *a != *nn) { prefixMatch = false; break; }
+					++a;
+					++nn;
+				}
+				if (prefixMatch && matchSegment(end + 1, nn)) return true;
+				if (altEnd == end) return false;
+				alt = altEnd + 1;
+			}
+		}
+
+		default:
+			if (*n++ != pc) return false;
+			break;
+		}
+	}
+	return !*n;
+}
+
+static bool hasWildcards(const std::string& s) { return s.find_first_of("?*[{") != std::string::npos; }
+
+struct Value { std::string name; std::string address; float value = 0; };
+
+struct Container
+{
+	std::string name;
+	std::vector<std::unique_ptr<Container>> containers;
+	std::vector<Value*> values;
+
+	Container* getContainerByName(const std::string& n)
+	{
+		for (auto& c : containers) if (c->name == n) return c.get();
+		return nullptr;
+	}
+};
+
+//previous path : everything is rebuilt from strings for each message
+struct ScanDispatch
+{
+	Container root;
+	std::vector<std::pair<std::string, Value*>> addressMap;
+
+	int dispatch(const std::string& address, float v)
+	{
+		std::string shortName = address;
+		for (auto& ch : shortName) if (ch == '/') ch = '_';
+
+		Container* parent = &root;
+		if (!hasWildcards(address))
+		{
+			std::vector<std::string> parts = split(address);
+			parts.pop_back();
+			for (auto& p : parts) if (parent != nullptr) parent = parent->getContainerByName(p);
+			if (parent == nullptr) return 0;
+		}
+
+		int found = 0;
+		std::vector<std::string> patternParts = split(address);
+		for (auto& entry : addressMap)
+		{
+			std::vector<std::string> parts = split(entry.first); //OSCAddress keeps its parsed parts
+			if (parts.size() != patternParts.size()) continue;
+			bool match = true;
+			for (size_t i = 0; i < parts.size() && match; i++) match = matchSegment(patternParts[i].c_str(), parts[i].c_str());
+			if (match)
+			{
+				entry.second->value = v;
+				found++;
+			}
+		}
+		return found;
+	}
+};
+
+//indexed path : exact map + segment trie, built once when values change
+struct IndexedDispatch
+{
+	struct Node
+	{
+		std::string segment;
+		Value* value = nullptr;
+		std::vector<std::unique_ptr<Node>> children;
+		std::unordered_map<std::string, Node*> childMap;
+	};
+
+	std::unordered_map<std::string, Value*> exactMap;
+	Node root;
+
+	void add(Value* v)
+	{
+		exactMap[v->address] = v;
+		Node* n = &root;
+		for (auto& s : split(v->address))
+		{
+			auto it = n->childMap.find(s);
+			if (it == n->childMap.end())
+			{
+				n->children.emplace_back(new Node());
+				n->children.back()->segment = s;
+				it = n->childMap.emplace(s, n->children.back().get()).first;
+			}
+			n = it->second;
+		}
+		n->value = v;
+	}
+
+	int collect(Node* n, const std::vector<std::string>& parts, size_t index, float v)
+	{
+		if (index == parts.size())
+		{
+			if (n->value == nullptr) return 0;
+			n->value->value = v;
+			return 1;
+		}
+
+		const std::string& s = parts[index];
+		if (!hasWildcards(s))
+		{
+			auto it = n->childMap.find(s);
+			return it == n->childMap.end() ? 0 : collect(it->second, parts, index + 1, v);
+		}
+
+		int found = 0;
+		for (auto& c : n->children) if (matchSegment(s.c_str(), c->segment.c_str())) found += collect(c.get(), parts, index + 1, v);
+		return found;
+	}
+
+	int dispatch(const std::string& address, float v)
+	{
+		if (!hasWildcards(address))
+		{
+			auto it = exactMap.find(address);
+			if (it == exactMap.end()) return 0;
+			it->second->value = v;
+			return 1;
+		}
+
+		return collect(&root, split(address), 0, v);
+	}
+};
+
+int main()
+{
+	std::vector<std::unique_ptr<Value>> values;
+	ScanDispatch scan;
+	IndexedDispatch indexed;
+
+	auto addValue = [&](const std::vector<std::string>& path)
+	{
+		Container* c = &scan.root;
+		std::string address;
+		for (size_t i = 0; i < path.size(); i++)
+		{
+			address += "/" + path[i];
+			if (i == path.size() - 1) break;
+			Container* child = c->getContainerByName(path[i]);
+			if (child == nullptr)
+			{
+				c->containers.emplace_back(new Container());
+				child = c->containers.back().get();
+				child->name = path[i];
+			}
+			c = child;
+		}
+
+		values.emplace_back(new Value());
+		Value* v = values.back().get();
+		v->name = path.back();
+		v->address = address;
+		c->values.push_back(v);
+		scan.addressMap.push_back({ address, v });
+		indexed.add(v);
+	};
+
+	//8 sensor rigs x 8 sensors x xyz + 4 TouchOSC pages of 16 faders and 16 toggles
+	for (int r = 1; r <= 8; r++)
+		for (int s = 1; s <= 8; s++)
+			for (const char* axis : { "x", "y", "z" }) addValue({ "rig" + std::to_string(r), "sensor" + std::to_string(s), axis });
+
+	for (int p = 1; p <= 4; p++)
+		for (int i = 1; i <= 16; i++)
+		{
+			addValue({ std::to_string(p), "fader" + std::to_string(i) });
+			addValue({ std::to_string(p), "toggle" + std::to_string(i) });
+		}
+
+	std::mt19937 rng(1234);
+	std::vector<std::string> stream;
+	const int numMessages = 200000;
+	stream.reserve(numMessages);
+	for (int i = 0; i < numMessages; i++)
+	{
+		if (rng() % 100 < 2) stream.push_back("/rig" + std::to_string(1 + rng() % 8) + "/*/{x,y}");
+		else stream.push_back(values[rng() % values.size()]->address);
+	}
+
+	printf("%d values, %d messages\n", (int)values.size(), numMessages);
+
+	auto run = [&](const char* name, auto& dispatcher)
+	{
+		long long found = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < numMessages; i++) found += dispatcher.dispatch(stream[i], (float)i);
+		auto end = std::chrono::steady_clock::now();
+		double ns = std::chrono::duration<double, std::nano>(end - start).count() / numMessages;
+		printf("%-8s %10.1f ns/message (%lld values set)\n", name, ns, found);
+	};
+
+	run("scan", scan);
+	run("indexed", indexed);
+	return 0;
+}
@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    PitchDetectionBenchmark.cpp
+    Created: 18 Oct 2026 7:52:19pm
+    Author:  bkupe
+
+  ==============================================================================
+*/
+
+/*
+	Model of PitchYIN / PitchMPM, see README.md.
+	For 512, 1024 and 2048 sample buffers :
+	- time domain : the YIN difference and MPM normalized square difference loops
+	- fft : the FFTCorrelation path (complex radix-2 here, juce::dsp::FFT does a real-only transform)
+	Also prints the largest difference between both outputs, and the audio callback cost before / after the analysis thread.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+typedef std::complex<float> Complex;
+
+//plain product, std::complex operator* goes through the NaN / inf checks of the standard without -ffast-math
+static inline Complex multiply(const Complex& a, const Complex& b)
+{
+	return Complex(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+//radix-2 FFT with precomputed twiddles, like the fallback engine of juce::dsp::FFT
+struct FFT
+{
+	size_t size = 0;
+	std::vector<Complex> twiddles;
+	std::vector<size_t> reversed;
+
+	void prepare(size_t newSize)
+	{
+		if (newSize == size) return;
+		size = newSize;
+		twiddles.resize(size / 2);
+		for (size_t i = 0; i < size / 2; i++) twiddles[i] = std::polar(1.0f, (float)(-2 * M_PI * i / size));
+		reversed.resize(size);
+		for (size_t i = 0, j = 0; i < size; i++)
+		{
+			reversed[i] = j;
+			size_t bit = size >> 1;
+			for (; j & bit; bit >>= 1) j ^= bit;
+			j ^= bit;
+		}
+	}
+
+	void perform(std::vector<Complex>& data, bool inverse) const
+	{
+		for (size_t i = 0; i < size; i++) if (i < reversed[i]) std::swap(data[i], data[reversed[i]]);
+
+		for (size_t len = 2; len <= size; len <<= 1)
+		{
+			const size_t half = len / 2, step = size / len;
+			for (size_t i = 0; i < size; i += len)
+			{
+				for (size_t j = 0; j < half; j++)
+				{
+					const Complex w = inverse ? std::conj(twiddles[j * step]) : twiddles[j * step];
+					const Complex u = data[i + j], v = multiply(data[i + j + half], w);
+					data[i + j] = u + v;
+					data[i + j + half] = u - v;
+				}
+			}
+		}
+
+		if (inverse) for (auto& c : data) c *= 1.0f / size;
+	}
+};
+
+struct Correlation
+{
+	FFT fft;
+	std::vector<Complex> a, b;
+
+	//sum(x[i] * y[i + tau]) for tau in [0, numLags)
+	void correlate(const float* x, int numX, const float* y, int numY, float* result, int numLags)
+	{
+		size_t size = 1;
+		while (size < (size_t)(numX + numY)) size <<= 1;
+		fft.prepare(size);
+		a.assign(size, 0);
+		b.assign(size, 0);
+		for (int i = 0; i < numX; i++) a[i] = x[i];
+		for (int i = 0; i < numY; i++) b[i] = y[i];
+		fft.perform(a, false);
+		fft.perform(b, false);
+		for (size_t i = 0; i < size; i++) b[i] = multiply(std::conj(a[i]), b[i]);
+		fft.perform(b, true);
+		for (int i = 0; i < numLags; i++) result[i] = b[i].real();
+	}
+};
+
+//YIN difference function, integration window of half the buffer
+static void yinTimeDomain(const float* input, int bufferSize, float* d)
+{
+	const int w = bufferSize / 2;
+	d[0] = 0;
+	for (int tau = 1; tau < w; tau++)
+	{
+		float sum = 0;
+		for (int j = 0; j < w; j++)
+		{
+			const float tmp = input[j] - input[j + tau];
+			sum += tmp * tmp;
+		}
+		d[tau] = sum;
+	}
+}
+
+static void yinFFT(Correlation& c, const float* input, int bufferSize, float* d, std::vector<float>& energy)
+{
+	const int w = bufferSize / 2;
+	c.correlate(input, w, input, bufferSize, d, w);
+	energy[0] = 0;
+	for (int i = 0; i < bufferSize; i++) energy[i + 1] = energy[i] + input[i] * input[i];
+	const float e0 = energy[w];
+	d[0] = 0;
+	for (int tau = 1; tau < w; tau++) d[tau] = std::max(0.0f, e0 + energy[tau + w] - energy[tau] - 2 * d[tau]);
+}
+
+//MPM normalized square difference function
+static void mpmTimeDomain(const float* input, int bufferSize, float* nsdf)
+{
+	for (int tau = 0; tau < bufferSize; tau++)
+	{
+		float acf = 0, m = 0;
+		for (int i = 0; i < bufferSize - tau; i++)
+		{
+			acf += input[i] * input[i + tau];
+			m += input[i] * input[i] + input[i + tau] * input[i + tau];
+		}
+		nsdf[tau] = m > 0 ? 2 * acf / m : 0;
+	}
+}
+
+static void mpmFFT(Correlation& c, const float* input, int bufferSize, float* nsdf)
+{
+	c.correlate(input, bufferSize, input, bufferSize, nsdf, bufferSize);
+	float m = 0;
+	for (int i = 0; i < bufferSize; i++) m += 2 * input[i] * input[i];
+	for (int tau = 0; tau < bufferSize; tau++)
+	{
+		nsdf[tau] = m > 0 ? 2 * nsdf[tau] / m : 0;
+		m -= input[tau] * input[tau] + input[bufferSize - 1 - tau] * input[bufferSize - 1 - tau];
+	}
+}
+
+template <typename F>
+static double timeUs(F&& f, int iterations)
+{
+	f();
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++) f();
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+static float maxDifference(const std::vector<float>& a, const std::vector<float>& b, int num, float scale)
+{
+	float result = 0;
+	for (int i = 0; i < num; i++) result = std::max(result, std::fabs(a[i] - b[i]) / scale);
+	return result;
+}
+
+int main()
+{
+	const double sampleRate = 48000;
+	volatile float sink = 0;
+
+	printf("%-6s %-4s %12s %12s %10s   %s\n", "buffer", "algo", "time domain", "fft", "max diff", "audio callback before -> after");
+
+	for (int bufferSize : { 512, 1024, 2048 })
+	{
+		//voice-like signal : 220 Hz with harmonics and a bit of noise
+		std::vector<float> input(bufferSize);
+		unsigned int seed = 1;
+		for (int i = 0; i < bufferSize; i++)
+		{
+			const double t = i / sampleRate;
+			seed = seed * 1664525 + 1013904223;
+			input[i] = (float)(.6 * std::sin(2 * M_PI * 220 * t) + .3 * std::sin(2 * M_PI * 440 * t) + .1 * std::sin(2 * M_PI * 660 * t) + .02 * ((seed >> 8) / 16777216.0 - .5));
+		}
+
+		std::vector<float> outTime(bufferSize), outFFT(bufferSize), energy(bufferSize + 1), fifo(bufferSize * 4);
+		Correlation c;
+		const int iterations = bufferSize >= 2048 ? 50 : 200;
+
+		const double copyUs = timeUs([&] { memcpy(fifo.data(), input.data(), bufferSize * sizeof(float)); sink = sink + fifo[bufferSize - 1]; }, iterations * 100);
+
+		const double yinTime = timeUs([&] { yinTimeDomain(input.data(), bufferSize, outTime.data()); sink = sink + outTime[1]; }, iterations);
+		const double yinFast = timeUs([&] { yinFFT(c, input.data(), bufferSize, outFFT.data(), energy); sink = sink + outFFT[1]; }, iterations);
+		const float yinScale = *std::max_element(outTime.begin(), outTime.begin() + bufferSize / 2);
+		printf("%-6d %-4s %9.1f us %9.1f us %10.2e   %.1f us -> %.2f us\n", bufferSize, "yin", yinTime, yinFast, maxDifference(outTime, outFFT, bufferSize / 2, yinScale), yinTime, copyUs);
+
+		const double mpmTime = timeUs([&] { mpmTimeDomain(input.data(), bufferSize, outTime.data()); sink = sink + outTime[1]; }, iterations);
+		const double mpmFast = timeUs([&] { mpmFFT(c, input.data(), bufferSize, outFFT.data()); sink = sink + outFFT[1]; }, iterations);
+		printf("%-6d %-4s %9.1f us %9.1f us %10.2e   %.1f us -> %.2f us\n", bufferSize, "mpm", mpmTime, mpmFast, maxDifference(outTime, outFFT, bufferSize * 3 / 4, 1), mpmTime, copyUs);
+	}
+
+	return 0;
+}